@@ -4,6 +4,7 @@
 
 #include <benchmark/benchmark.h>
 #include <string>
+#include <vector>
 
 using namespace DB;
 
@@ -65,6 +66,54 @@ static void BM_BloomFilterMiss(benchmark::State &state) {
   state.SetItemsProcessed(state.iterations());
 }
 
+static void BM_BloomFilterBuildBatch(benchmark::State &state) {
+  auto n = static_cast<size_t>(state.range(0));
+  std::vector<uint64_t> hashes(n);
+  for (size_t i = 0; i < n; ++i) {
+    std::string key = "key_" + std::to_string(i);
+    hashes[i] = BloomFilter::HashKey(key.data(), key.size());
+  }
+  for (auto _ : state) {
+    BloomFilterBuilder builder(n);
+    builder.AddHashes(hashes.data(), hashes.size());
+    benchmark::DoNotOptimize(builder.GetData());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+
+// 批量探测：hash 预先算好，只测探测本身，与逐个 MayContainHash 对比
+static void ProbeBatch(benchmark::State &state, const char *prefix) {
+  auto n = static_cast<size_t>(state.range(0));
+  constexpr size_t kBatch = 1024;
+
+  BloomFilterBuilder builder(n);
+  for (size_t i = 0; i < n; ++i) {
+    std::string key = "key_" + std::to_string(i);
+    builder.AddKey(Slice{key});
+  }
+  BloomFilter filter(builder.GetData());
+
+  std::vector<uint64_t> hashes(kBatch);
+  for (size_t i = 0; i < kBatch; ++i) {
+    std::string key = prefix + std::to_string(i * 7 % n);
+    hashes[i] = BloomFilter::HashKey(key.data(), key.size());
+  }
+  std::vector<uint64_t> bitmap((kBatch + 63) / 64);
+  for (auto _ : state) {
+    filter.MayContainBatch(hashes.data(), kBatch, bitmap.data());
+    benchmark::DoNotOptimize(bitmap.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kBatch));
+}
+
+static void BM_BloomFilterBatchHit(benchmark::State &state) {
+  ProbeBatch(state, "key_");
+}
+
+static void BM_BloomFilterBatchMiss(benchmark::State &state) {
+  ProbeBatch(state, "miss_");
+}
+
 BENCHMARK(BM_BloomFilterBuild)
     ->Arg(1000)
     ->Arg(10000)
@@ -72,3 +121,18 @@ BENCHMARK(BM_BloomFilterBuild)
     ->Arg(1000000);
 BENCHMARK(BM_BloomFilterHit)->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000);
 BENCHMARK(BM_BloomFilterMiss)->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000);
+BENCHMARK(BM_BloomFilterBuildBatch)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK(BM_BloomFilterBatchHit)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK(BM_BloomFilterBatchMiss)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
@@ -10,6 +10,12 @@ struct ColumnMeta {
   std::string name_;
   std::shared_ptr<ValueType> type_;
   uint32_t index_{0};
+  // 建表时声明 BLOOM，SSTable 为该列生成值过滤器
+  bool bloom_{false};
+  // 建表时声明 GORILLA，Double 列尝试 XOR 浮点编码
+  bool gorilla_{false};
+  // 建表时声明 CLUSTER，最底层 compaction 按这些列聚簇 RowGroup
+  bool cluster_{false};
 
   ColumnMeta() = default;
   ColumnMeta(std::string name, std::shared_ptr<ValueType> type,
@@ -8,6 +8,7 @@
 #include "type/Int.hpp"
 #include "type/String.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <map>
@@ -26,6 +27,11 @@ class TableMeta {
   std::vector<ColumnMetaRef> columns_;
   std::map<std::string, uint> name_map_column_idx_;
   std::string unique_key_column_name_;
+  // 建有二级索引的列名
+  std::vector<std::string> index_columns_;
+  // 表级选项（CREATE TABLE ... WITH (...) / ALTER TABLE ... SET (...)），
+  // 未设置的取默认值
+  std::map<std::string, uint64_t> options_;
 
 public:
   static constexpr std::string default_table_meta_name = "table_meta.json";
@@ -56,12 +62,33 @@ public:
         columns_.push_back(std::make_shared<ColumnMeta>(
             std::string(name), std::make_shared<Double>(), idx));
         name_map_column_idx_.emplace(name, idx++);
+      } else {
+        continue;
+      }
+      if (column.at_key("bloom").error() == simdjson::SUCCESS) {
+        columns_.back()->bloom_ = column["bloom"].get_bool().value();
+      }
+      if (column.at_key("gorilla").error() == simdjson::SUCCESS) {
+        columns_.back()->gorilla_ = column["gorilla"].get_bool().value();
+      }
+      if (column.at_key("cluster").error() == simdjson::SUCCESS) {
+        columns_.back()->cluster_ = column["cluster"].get_bool().value();
       }
     }
     if (json.at_key("unique_key").error() == simdjson::SUCCESS) {
       unique_key_column_name_ =
           std::string(json["unique_key"].get_string().value());
     }
+    if (json.at_key("indexes").error() == simdjson::SUCCESS) {
+      for (const auto &index : json["indexes"]) {
+        index_columns_.emplace_back(index.get_string().value());
+      }
+    }
+    if (json.at_key("options").error() == simdjson::SUCCESS) {
+      for (auto field : json["options"].get_object()) {
+        options_.emplace(field.key, field.value.get_uint64().value());
+      }
+    }
   }
 
   explicit TableMeta(std::filesystem::path table_path, std::string table_name,
@@ -97,6 +124,18 @@ public:
       writer.String(column->name_.c_str());
       writer.Key("type");
       writer.String(column->type_->ToString().c_str());
+      if (column->bloom_) {
+        writer.Key("bloom");
+        writer.Bool(true);
+      }
+      if (column->gorilla_) {
+        writer.Key("gorilla");
+        writer.Bool(true);
+      }
+      if (column->cluster_) {
+        writer.Key("cluster");
+        writer.Bool(true);
+      }
       writer.EndObject();
     }
 
@@ -105,6 +144,23 @@ public:
     writer.Key("unique_key");
     writer.String(unique_key_column_name_.c_str());
 
+    writer.Key("indexes");
+    writer.StartArray();
+    for (const auto &index : index_columns_) {
+      writer.String(index.c_str());
+    }
+    writer.EndArray();
+
+    if (!options_.empty()) {
+      writer.Key("options");
+      writer.StartObject();
+      for (const auto &[name, value] : options_) {
+        writer.Key(name.c_str());
+        writer.Uint64(value);
+      }
+      writer.EndObject();
+    }
+
     writer.EndObject();
 
     return buffer.GetString();
@@ -130,6 +186,76 @@ public:
 
   bool HasUniqueKey() { return !unique_key_column_name_.empty(); }
 
+  const std::vector<std::string> &GetIndexColumns() { return index_columns_; }
+
+  bool HasIndex(const std::string &col_name) {
+    return std::find(index_columns_.begin(), index_columns_.end(),
+                     col_name) != index_columns_.end();
+  }
+
+  void AddIndex(const std::string &col_name) {
+    if (!HasIndex(col_name)) {
+      index_columns_.push_back(col_name);
+    }
+  }
+
+  // RowGroup 切分：每个 RowGroup 的目标行数 / 字节数，
+  // 以及 int 主键的切分边界（0 表示不按 key 切分）
+  static constexpr auto kRowGroupRows = "ROWGROUP_ROWS";
+  static constexpr auto kRowGroupBytes = "ROWGROUP_BYTES";
+  static constexpr auto kRowGroupKeyBoundary = "ROWGROUP_KEY_BOUNDARY";
+  // CLUSTER 列使用的空间填充曲线，取值见 ClusterCurve（0 Z-order，1 Hilbert）
+  static constexpr auto kClusterCurve = "CLUSTER_CURVE";
+
+  static bool IsOption(const std::string &name) {
+    return name == kRowGroupRows || name == kRowGroupBytes ||
+           name == kRowGroupKeyBoundary || name == kClusterCurve;
+  }
+
+  const std::map<std::string, uint64_t> &GetOptions() { return options_; }
+
+  uint64_t GetOption(const std::string &name, uint64_t default_value) {
+    auto it = options_.find(name);
+    return it == options_.end() ? default_value : it->second;
+  }
+
+  void SetOption(const std::string &name, uint64_t value) {
+    options_[name] = value;
+  }
+
+  // 声明了 BLOOM 的列下标
+  std::vector<size_t> GetBloomColumnIndices() {
+    std::vector<size_t> indices;
+    for (const auto &col : columns_) {
+      if (col->bloom_) {
+        indices.push_back(col->index_);
+      }
+    }
+    return indices;
+  }
+
+  // 声明了 GORILLA 的列下标
+  std::vector<size_t> GetGorillaColumnIndices() {
+    std::vector<size_t> indices;
+    for (const auto &col : columns_) {
+      if (col->gorilla_) {
+        indices.push_back(col->index_);
+      }
+    }
+    return indices;
+  }
+
+  // 声明了 CLUSTER 的列下标
+  std::vector<size_t> GetClusterColumnIndices() {
+    std::vector<size_t> indices;
+    for (const auto &col : columns_) {
+      if (col->cluster_) {
+        indices.push_back(col->index_);
+      }
+    }
+    return indices;
+  }
+
   uint32_t GetColumnIndex(const std::string &col_name) {
     return name_map_column_idx_[col_name];
   }
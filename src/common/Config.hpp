@@ -20,19 +20,49 @@ constexpr uint32_t SSTABLE_SIZE = 8192;
 constexpr size_t DEFAULT_PAGE_SIZE = 4096;
 constexpr size_t DEFAULT_POOL_SIZE = 128;
 constexpr size_t DEFAULT_ROWGROUP_TARGET_SIZE = 64 * 1024;
+constexpr uint32_t DEFAULT_ROWGROUP_TARGET_ROWS = 1024 * 1024;
 constexpr size_t DEFAULT_ROWGROUP_ALIGNMENT = 4096;
 constexpr size_t MAX_IMMUTABLE_COUNT = 2;
+constexpr size_t ROW_CACHE_CAPACITY = 1024 * 1024;
+constexpr size_t CHUNK_CACHE_CAPACITY = 4 * 1024 * 1024;
+constexpr uint32_t PAGE_INDEX_ROWS = 1024;
+constexpr size_t CLUSTER_WINDOW_SIZE = 256 * 1024;
 #else
 // per sstable size is 64MB
 constexpr uint32_t SSTABLE_SIZE = 64 * 1024 * 1024;
 constexpr size_t DEFAULT_PAGE_SIZE = 4096;
 constexpr size_t DEFAULT_POOL_SIZE = 4096;
-// per rowgroup size is 16MB
+// per rowgroup size is 16MB，行数不超过 DEFAULT_ROWGROUP_TARGET_ROWS，
+// 两者都可按表覆盖（ROWGROUP_BYTES / ROWGROUP_ROWS）
 constexpr size_t DEFAULT_ROWGROUP_TARGET_SIZE = 16 * 1024 * 1024;
+constexpr uint32_t DEFAULT_ROWGROUP_TARGET_ROWS = 128 * 1024;
 constexpr size_t DEFAULT_ROWGROUP_ALIGNMENT = 4096;
 constexpr size_t MAX_IMMUTABLE_COUNT = 4;
+// 点查行缓存容量（所有表共享），为 0 时关闭
+constexpr size_t ROW_CACHE_CAPACITY = 64 * 1024 * 1024;
+// 解压 / 解码后的列数据块缓存容量（所有表共享），为 0 时关闭
+constexpr size_t CHUNK_CACHE_CAPACITY = 256 * 1024 * 1024;
+// 页索引每页的行数（bit-packing / Gorilla 块大小的整数倍），
+// RowGroup 不超过一页时不写页索引
+constexpr uint32_t PAGE_INDEX_ROWS = 8192;
+// 聚簇写入时缓冲并重排的行数据字节数，窗口之间仍按主键有序
+constexpr size_t CLUSTER_WINDOW_SIZE = 64 * 1024 * 1024;
 #endif
 constexpr size_t ZONE_MAP_PREFIX_LEN = 32;
+// RowGroup 内 int 主键稀疏索引的采样间隔（行）
+constexpr uint32_t SPARSE_KEY_INDEX_INTERVAL = 64;
+// int 主键 learned index 的最大预测误差（行）
+constexpr uint32_t LEARNED_KEY_INDEX_EPSILON = 32;
+// String 列字典编码的最大字典项数（编码为 u16），超过则退回 plain
+constexpr uint32_t STRING_DICTIONARY_MAX_ENTRIES = 65536;
+// 列数据块小于该字节数时不压缩
+constexpr size_t COLUMN_COMPRESSION_MIN_SIZE = 256;
+// 最底层列数据块的 Zstd 压缩级别
+constexpr int COLUMN_ZSTD_LEVEL = 3;
+// 解压缓冲区池最多缓存的空闲字节数
+constexpr size_t CHUNK_BUFFER_POOL_BYTES = 64 * 1024 * 1024;
+// 二级索引估计命中比例不超过该值时才走索引，否则全表扫描更快
+constexpr double INDEX_SCAN_MAX_SELECTIVITY = 0.1;
 
 // Leveled Compaction constants
 constexpr uint32_t MAX_LEVELS = 7;
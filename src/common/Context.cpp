@@ -1,8 +1,30 @@
 #include "common/Context.hpp"
 
+#include "common/Logger.hpp"
 #include "storage/lsmtree/LSMTree.hpp"
 
 namespace DB {
+namespace {
+RowGroupSizing RowGroupSizingOf(const TableMetaRef &table_meta) {
+  RowGroupSizing sizing;
+  sizing.target_rows = static_cast<uint32_t>(
+      table_meta->GetOption(TableMeta::kRowGroupRows, sizing.target_rows));
+  sizing.target_bytes = static_cast<size_t>(
+      table_meta->GetOption(TableMeta::kRowGroupBytes, sizing.target_bytes));
+  sizing.key_boundary = static_cast<uint32_t>(table_meta->GetOption(
+      TableMeta::kRowGroupKeyBoundary, sizing.key_boundary));
+  return sizing;
+}
+
+ClusterSpec ClusterSpecOf(const TableMetaRef &table_meta) {
+  ClusterSpec spec;
+  spec.columns = table_meta->GetClusterColumnIndices();
+  spec.curve = static_cast<ClusterCurve>(
+      table_meta->GetOption(TableMeta::kClusterCurve, 0));
+  return spec;
+}
+} // namespace
+
 std::shared_ptr<LSMTree>
 QueryContext::GetOrCreateLSMTree(const TableMetaRef &table_meta) {
   if (!table_meta) {
@@ -19,7 +41,26 @@ QueryContext::GetOrCreateLSMTree(const TableMetaRef &table_meta) {
   auto lsm = std::make_shared<LSMTree>(table_meta->GetTablePath(),
                                        buffer_pool_manager_, std::move(types),
                                        primary_key);
+  lsm->SetFilterColumns(table_meta->GetBloomColumnIndices());
+  lsm->SetGorillaColumns(table_meta->GetGorillaColumnIndices());
+  lsm->SetRowGroupSizing(RowGroupSizingOf(table_meta));
+  lsm->SetClusterSpec(ClusterSpecOf(table_meta));
+  for (const auto &col_name : table_meta->GetIndexColumns()) {
+    auto s = lsm->CreateSecondaryIndex(table_meta->GetColumnIndex(col_name));
+    if (!s.ok()) {
+      LOG_ERROR("Load index on {}({}) failed: {}", name, col_name,
+                s.GetMessage());
+    }
+  }
   lsm_trees_.emplace(name, lsm);
   return lsm;
 }
+
+void QueryContext::ApplyTableOptions(const TableMetaRef &table_meta) {
+  auto it = lsm_trees_.find(table_meta->GetTableName());
+  if (it != lsm_trees_.end()) {
+    it->second->SetRowGroupSizing(RowGroupSizingOf(table_meta));
+    it->second->SetClusterSpec(ClusterSpecOf(table_meta));
+  }
+}
 } // namespace DB
@@ -28,5 +28,8 @@ struct QueryContext {
             DEFAULT_POOL_SIZE, disk_manager_)) {}
 
   std::shared_ptr<LSMTree> GetOrCreateLSMTree(const TableMetaRef &table_meta);
+
+  // 表级选项变更后同步到已打开的 LSMTree，只影响之后生成的 SSTable
+  void ApplyTableOptions(const TableMetaRef &table_meta);
 };
 } // namespace DB
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace DB {
+// 运行时 CPU 指令集检测，结果在首次调用时缓存
+inline bool HasAVX2() {
+  static const bool has = __builtin_cpu_supports("avx2");
+  return has;
+}
+
+inline bool HasSSE42() {
+  static const bool has = __builtin_cpu_supports("sse4.2");
+  return has;
+}
+} // namespace DB
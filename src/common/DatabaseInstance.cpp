@@ -7,6 +7,7 @@
 #include "storage/column/ColumnString.hpp"
 #include "storage/column/ColumnWithNameType.hpp"
 
+#include <fstream>
 #include <memory>
 
 namespace DB {
@@ -32,13 +33,17 @@ Database::Database(std::filesystem::path path,
 
 Status Database::CreateTable(std::string &table_name,
                              std::vector<std::shared_ptr<ColumnMeta>> &columns,
-                             std::string unique_key) {
-  table_metas_.emplace(
+                             std::string unique_key,
+                             const std::map<std::string, uint64_t> &options) {
+  auto [it, _] = table_metas_.emplace(
       table_name,
       std::make_shared<TableMeta>(path_ / table_name, table_name,
                                   std::move(columns), std::move(unique_key)));
+  for (const auto &[name, value] : options) {
+    it->second->SetOption(name, value);
+  }
   return disk_manager_->CreateTable(path_ / table_name,
-                                    table_metas_.rbegin()->second->Serialize());
+                                    it->second->Serialize());
 }
 
 Status Database::ShowTables(ResultSet &result_set) {
@@ -53,6 +58,23 @@ Status Database::ShowTables(ResultSet &result_set) {
   return Status::OK();
 }
 
+Status Database::SaveTableMeta(const std::string &table_name) {
+  auto it = table_metas_.find(table_name);
+  if (it == table_metas_.end()) {
+    return Status::Error(ErrorCode::NotFound, "table meta not found");
+  }
+  std::string s = it->second->Serialize();
+  std::ofstream meta_file(path_ / table_name /
+                              TableMeta::default_table_meta_name,
+                          std::ios::binary | std::ios::trunc);
+  if (!meta_file.is_open()) {
+    return Status::Error(ErrorCode::FileNotOpen,
+                         "failed to open table meta file");
+  }
+  meta_file.write(s.data(), s.size());
+  return Status::OK();
+}
+
 TableMetaRef Database::GetTableMeta(std::string &table_name) {
   auto it = table_metas_.find(table_name);
   if (it == table_metas_.end()) {
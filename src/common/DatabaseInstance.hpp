@@ -11,6 +11,7 @@
 #include <filesystem>
 #include <map>
 #include <memory>
+#include <tuple>
 
 namespace DB {
 class Database : public Instance<Database> {
@@ -27,22 +28,22 @@ public:
   ~Database() {
     // save all table meta
     for (auto &[name, meta] : table_metas_) {
-      std::string s = meta->Serialize();
-      std::ofstream meta_file(path_ / name / TableMeta::default_table_meta_name,
-                              std::ios::binary | std::ios::trunc);
-      meta_file.write(s.data(), s.size());
-      meta_file.close();
+      std::ignore = SaveTableMeta(name);
     }
   }
 
   Status CreateTable(std::string &table_name,
                      std::vector<std::shared_ptr<ColumnMeta>> &columns,
-                     std::string unique_key = "");
+                     std::string unique_key = "",
+                     const std::map<std::string, uint64_t> &options = {});
 
   Status ShowTables(ResultSet &result_set);
 
   TableMetaRef GetTableMeta(std::string &table_name);
 
+  // 立即把表元数据写回 table_meta.json（DDL 修改元数据后调用）
+  Status SaveTableMeta(const std::string &table_name);
+
   std::filesystem::path GetPath() { return path_; }
 
   void RemoveTable(std::string name) { table_metas_.erase(name); }
@@ -2,6 +2,7 @@
 enum class CreateType {
   Database,
   Table,
+  Index,
 };
 
 enum class ErrorCode {
@@ -30,6 +31,8 @@ enum class StatementType {
   DropStatement,
   FlushStatement,
   DeleteStatement,
+  AnalyzeStatement,
+  AlterStatement,
 };
 
 enum class ASTNodeType {
@@ -49,6 +52,8 @@ enum class ASTNodeType {
   DeleteQuery,
   TableFunction,
   Subquery,
+  AnalyzeQuery,
+  AlterQuery,
 };
 
 enum class ShowType {
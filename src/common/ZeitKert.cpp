@@ -6,16 +6,24 @@
 #include "function/FunctionCast.hpp"
 #include "function/FunctionCount.hpp"
 #include "function/FunctionMath.hpp"
+#include "function/FunctionMinMax.hpp"
 #include "function/FunctionSimdSum.hpp"
 #include "function/FunctionString.hpp"
 #include "function/FunctionSum.hpp"
 #include "parser/Checker.hpp"
+#include "parser/statement/AlterStatement.hpp"
+#include "parser/statement/AnalyzeStatement.hpp"
 #include "parser/statement/CreateStatement.hpp"
 #include "parser/statement/DropStatement.hpp"
 #include "parser/statement/FlushStatement.hpp"
 #include "parser/statement/ShowStatement.hpp"
 #include "parser/statement/UseStatement.hpp"
+#include "storage/column/ColumnString.hpp"
+#include "storage/column/ColumnVector.hpp"
+#include "storage/column/ColumnWithNameType.hpp"
 #include "storage/lsmtree/LSMTree.hpp"
+#include "type/Int.hpp"
+#include "type/String.hpp"
 
 #include <filesystem>
 #include <memory>
@@ -49,6 +57,15 @@ static void RegisterChecker() {
   Checker::RegisterKeyWord("FLUSH");
   Checker::RegisterKeyWord("NULL");
   Checker::RegisterKeyWord("DELETE");
+  Checker::RegisterKeyWord("INDEX");
+  Checker::RegisterKeyWord("ON");
+  Checker::RegisterKeyWord("BLOOM");
+  Checker::RegisterKeyWord("GORILLA");
+  Checker::RegisterKeyWord("CLUSTER");
+  Checker::RegisterKeyWord("ANALYZE");
+  Checker::RegisterKeyWord("ALTER");
+  Checker::RegisterKeyWord("SET");
+  Checker::RegisterKeyWord("WITH");
 
   Checker::RegisterType("INT");
   Checker::RegisterType("STRING");
@@ -58,6 +75,10 @@ static void RegisterChecker() {
   Checker::RegisterFunction("CAST", std::make_shared<FunctionCast>());
   Checker::RegisterFunction("COUNT", std::make_shared<FunctionCount>());
   Checker::RegisterFunction("SUM", std::make_shared<FunctionSum>());
+  Checker::RegisterFunction(
+      "MIN", std::make_shared<FunctionMinMax>(FunctionMinMax::Op::Min));
+  Checker::RegisterFunction(
+      "MAX", std::make_shared<FunctionMinMax>(FunctionMinMax::Op::Max));
   Checker::RegisterFunction("SIMD_SUM", std::make_shared<FunctionSimdSum>());
   Checker::RegisterFunction("TO_UPPER", std::make_shared<FunctionToUpper>());
   Checker::RegisterFunction("TO_LOWER", std::make_shared<FunctionToLower>());
@@ -142,12 +163,27 @@ Status ZeitKert::HandleCreateStatement() {
                            "You have not choice a database");
     }
     auto s = context_->database_->CreateTable(
-        name, create_statement.GetColumns(), create_statement.GetUniqueKey());
+        name, create_statement.GetColumns(), create_statement.GetUniqueKey(),
+        create_statement.GetOptions());
     if (!s.ok()) {
       return s;
     }
     LOG_INFO("CREATE TABLE '{}'", name);
     return s;
+  } else if (create_statement.GetCreateType() == CreateType::Index) {
+    auto table_meta = context_->database_->GetTableMeta(name);
+    auto column = create_statement.GetIndexColumn();
+    auto lsm = context_->GetOrCreateLSMTree(table_meta);
+    auto s = lsm->CreateSecondaryIndex(table_meta->GetColumnIndex(column));
+    if (!s.ok()) {
+      return s;
+    }
+    table_meta->AddIndex(column);
+    s = context_->database_->SaveTableMeta(name);
+    if (s.ok()) {
+      LOG_INFO("CREATE INDEX ON '{}'({})", name, column);
+    }
+    return s;
   } else {
     auto s = context_->disk_manager_->CreateDatabase(name);
     if (s.ok()) {
@@ -221,4 +257,83 @@ Status ZeitKert::HandleFlushStatement() {
   }
   return s;
 }
+
+Status ZeitKert::HandleAlterStatement() {
+  auto &alter_statement =
+      static_cast<AlterStatement &>(*context_->sql_statement_);
+  std::string table_name = alter_statement.GetTableName();
+
+  if (context_->database_ == nullptr) {
+    return Status::Error(ErrorCode::NotChoiceDatabase,
+                         "You have not choice a database");
+  }
+
+  auto table_meta = context_->database_->GetTableMeta(table_name);
+  if (table_meta == nullptr) {
+    return Status::Error(ErrorCode::NotFound,
+                         "Table " + table_name + " not found");
+  }
+
+  for (const auto &[name, value] : alter_statement.GetOptions()) {
+    table_meta->SetOption(name, value);
+  }
+  auto s = context_->database_->SaveTableMeta(table_name);
+  if (!s.ok()) {
+    return s;
+  }
+  // 已有的 SSTable 不重写，之后刷盘和 compaction 产生的文件按新选项切分
+  context_->ApplyTableOptions(table_meta);
+  LOG_INFO("ALTER TABLE '{}'", table_name);
+  return s;
+}
+
+Status ZeitKert::HandleAnalyzeStatement(ResultSet &result_set) {
+  auto &analyze_statement =
+      static_cast<AnalyzeStatement &>(*context_->sql_statement_);
+  std::string table_name = analyze_statement.GetTableName();
+
+  if (context_->database_ == nullptr) {
+    return Status::Error(ErrorCode::NotChoiceDatabase,
+                         "You have not choice a database");
+  }
+
+  auto table_meta = context_->database_->GetTableMeta(table_name);
+  if (table_meta == nullptr) {
+    return Status::Error(ErrorCode::NotFound,
+                         "Table " + table_name + " not found");
+  }
+
+  auto lsm_tree = context_->GetOrCreateLSMTree(table_meta);
+  if (lsm_tree == nullptr) {
+    return Status::Error(ErrorCode::IOError,
+                         "Failed to get LSMTree for table " + table_name);
+  }
+
+  // 每列一行：列名、行数、NULL 行数、估计的不同值个数
+  auto stats = lsm_tree->Analyze();
+  auto names = std::make_shared<ColumnString>();
+  auto rows = std::make_shared<ColumnVector<int>>();
+  auto nulls = std::make_shared<ColumnVector<int>>();
+  auto distinct = std::make_shared<ColumnVector<int>>();
+  const auto &columns = table_meta->GetColumns();
+  for (size_t i = 0; i < columns.size() && i < stats->columns.size(); i++) {
+    const auto &column = stats->columns[i];
+    names->Insert(std::string{columns[i]->name_});
+    rows->Insert(static_cast<int>(stats->row_count));
+    nulls->Insert(static_cast<int>(column.null_count));
+    distinct->Insert(static_cast<int>(column.distinct.Estimate()));
+  }
+  result_set.schema_ = std::make_shared<Schema>();
+  auto &output = result_set.schema_->GetColumns();
+  output.push_back(std::make_shared<ColumnWithNameType>(
+      names, "Column", std::make_shared<String>()));
+  output.push_back(std::make_shared<ColumnWithNameType>(
+      rows, "Rows", std::make_shared<Int>()));
+  output.push_back(std::make_shared<ColumnWithNameType>(
+      nulls, "Nulls", std::make_shared<Int>()));
+  output.push_back(std::make_shared<ColumnWithNameType>(
+      distinct, "Distinct", std::make_shared<Int>()));
+  LOG_INFO("ANALYZE TABLE '{}'", table_name);
+  return Status::OK();
+}
 } // namespace DB
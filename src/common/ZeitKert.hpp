@@ -27,6 +27,10 @@ class ZeitKert {
 
   Status HandleFlushStatement();
 
+  Status HandleAnalyzeStatement(ResultSet &result_set);
+
+  Status HandleAlterStatement();
+
 public:
   ZeitKert();
   ~ZeitKert();
@@ -66,6 +70,14 @@ public:
       LOG_INFO("Execute: FLUSH statement");
       status = HandleFlushStatement();
       goto ExecuteEnd;
+    case StatementType::AnalyzeStatement:
+      LOG_INFO("Execute: ANALYZE statement");
+      status = HandleAnalyzeStatement(result_set);
+      goto ExecuteEnd;
+    case StatementType::AlterStatement:
+      LOG_INFO("Execute: ALTER statement");
+      status = HandleAlterStatement();
+      goto ExecuteEnd;
     case StatementType::InvalidStatement:
     case StatementType::SelectStatement:
       LOG_INFO("Execute: SELECT statement");
@@ -0,0 +1,76 @@
+#include "execution/AggregationExecutor.hpp"
+#include "common/Status.hpp"
+#include "storage/column/ColumnVector.hpp"
+#include "storage/column/ColumnWithNameType.hpp"
+#include "type/Double.hpp"
+#include "type/Int.hpp"
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace DB {
+Status AggregationExecutor::ExecuteFallback() {
+  auto status = fallback_->Execute();
+  if (!status.ok()) {
+    return status;
+  }
+  for (auto col : fallback_->GetSchema()->GetColumns()) {
+    schema_->GetColumns().push_back(col);
+  }
+  return Status::OK();
+}
+
+Status AggregationExecutor::Execute() {
+  // 同一列上的多个聚合共用一次元数据聚合
+  std::map<uint32_t, ColumnAggregate> results;
+  for (const auto &agg : aggregates_) {
+    if (results.count(agg.column_idx)) {
+      continue;
+    }
+    ColumnAggregate result;
+    if (!lsm_tree_->AggregateColumn(agg.column_idx, predicates_, result)) {
+      return ExecuteFallback();
+    }
+    results.emplace(agg.column_idx, result);
+  }
+
+  for (const auto &agg : aggregates_) {
+    const auto &result = results[agg.column_idx];
+    std::string name = agg.function + "(" + agg.column_meta->name_ + ")";
+    ColumnPtr column;
+    std::shared_ptr<ValueType> type;
+    if (agg.function == "COUNT") {
+      auto res = std::make_shared<ColumnVector<int>>();
+      res->Insert(static_cast<int>(result.row_count));
+      column = res;
+      type = std::make_shared<Int>();
+    } else if (agg.function == "SUM") {
+      auto res = std::make_shared<ColumnVector<double>>();
+      res->Insert(result.sum);
+      column = res;
+      type = std::make_shared<Double>();
+    } else {
+      // MIN / MAX 与输入列同类型，没有非 NULL 值时为 NULL
+      double value = agg.function == "MIN" ? result.min : result.max;
+      if (agg.column_meta->type_->GetType() == ValueType::Type::Int) {
+        auto res = std::make_shared<ColumnVector<int>>();
+        res->Insert(static_cast<int>(value));
+        column = res;
+        type = std::make_shared<Int>();
+      } else {
+        auto res = std::make_shared<ColumnVector<double>>();
+        res->Insert(value);
+        column = res;
+        type = std::make_shared<Double>();
+      }
+      if (result.non_null_count == 0) {
+        column->SetNull(0);
+      }
+    }
+    schema_->GetColumns().push_back(
+        std::make_shared<ColumnWithNameType>(column, name, type));
+  }
+  return Status::OK();
+}
+} // namespace DB
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "execution/AbstractExecutor.hpp"
+#include "planner/AggregationPlanNode.hpp"
+#include "storage/lsmtree/LSMTree.hpp"
+#include "storage/lsmtree/ScanPredicate.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace DB {
+class AggregationExecutor : public AbstractExecutor {
+  // 回退用的原计划
+  AbstractExecutorRef fallback_;
+  std::shared_ptr<LSMTree> lsm_tree_;
+  std::vector<AggregateExpr> aggregates_;
+  std::vector<ScanPredicate> predicates_;
+
+  // 执行原计划并透传其输出
+  Status ExecuteFallback();
+
+public:
+  AggregationExecutor(SchemaRef schema, AbstractExecutorRef fallback,
+                      std::shared_ptr<LSMTree> lsm_tree,
+                      std::vector<AggregateExpr> aggregates,
+                      std::vector<ScanPredicate> predicates)
+      : AbstractExecutor(std::move(schema)), fallback_(std::move(fallback)),
+        lsm_tree_(std::move(lsm_tree)), aggregates_(std::move(aggregates)),
+        predicates_(std::move(predicates)) {}
+
+  ~AggregationExecutor() override = default;
+
+  Status Execute() override;
+};
+} // namespace DB
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "execution/AbstractExecutor.hpp"
+#include "execution/AggregationExecutor.hpp"
 #include "execution/DeleteExecutor.hpp"
 #include "execution/FilterExecutor.hpp"
 #include "execution/FunctionExecutor.hpp"
+#include "execution/IndexScanExecutor.hpp"
 #include "execution/InsertExecutor.hpp"
 #include "execution/ProjectionExecutor.hpp"
 #include "execution/RangeExecutor.hpp"
@@ -11,9 +13,11 @@
 #include "execution/TupleExecutor.hpp"
 #include "execution/ValuesExecutor.hpp"
 #include "planner/AbstractPlanNode.hpp"
+#include "planner/AggregationPlanNode.hpp"
 #include "planner/DeletePlanNode.hpp"
 #include "planner/FilterPlanNode.hpp"
 #include "planner/FunctionPlanNode.hpp"
+#include "planner/IndexScanPlanNode.hpp"
 #include "planner/InsertPlanNode.hpp"
 #include "planner/ProjectionPlanNode.hpp"
 #include "planner/RangePlanNode.hpp"
@@ -82,9 +86,19 @@ struct ExecutorFactory {
       for (auto child : p.GetChildren()) {
         children.push_back(CreateExecutor(child));
       }
+      AbstractExecutorRef index_scan;
+      if (p.GetIndexScan()) {
+        index_scan = CreateExecutor(p.GetIndexScan());
+      }
       return std::make_unique<FilterExecutor>(
           p.GetSchemaRef(), std::move(children), p.GetCondition(),
-          p.GetConditionColumns());
+          p.GetConditionColumns(), std::move(index_scan));
+    }
+    case PlanType::IndexScan: {
+      auto &p = static_cast<IndexScanPlanNode &>(*plan);
+      return std::make_unique<IndexScanExecutor>(
+          p.GetSchemaRef(), p.GetLSMTree(), p.GetIndexColumnIdx(),
+          p.GetPredicates(), p.GetOutputColumns());
     }
     case PlanType::Range: {
       auto &p = static_cast<RangePlanNode &>(*plan);
@@ -97,9 +111,13 @@ struct ExecutorFactory {
           p.GetSchemaRef(), p.GetTableMeta(), p.GetLSMTree(), p.GetCondition(),
           p.GetConditionColumns());
     }
-    case PlanType::IndexScan:
+    case PlanType::Aggregation: {
+      auto &p = static_cast<AggregationPlanNode &>(*plan);
+      return std::make_unique<AggregationExecutor>(
+          p.GetSchemaRef(), CreateExecutor(p.GetChildAt(0)), p.GetLSMTree(),
+          p.GetAggregates(), p.GetPredicates());
+    }
     case PlanType::Update:
-    case PlanType::Aggregation:
     case PlanType::Limit:
     case PlanType::NestedLoopJoin:
     case PlanType::NestedIndexJoin:
@@ -1,11 +1,10 @@
 #include "execution/FilterExecutor.hpp"
 #include "common/Status.hpp"
 #include "execution/FunctionExecutor.hpp"
-#include "function/FunctionComparison.hpp"
-#include "function/FunctionLogical.hpp"
 #include "parser/binder/BoundColumnMeta.hpp"
 #include "parser/binder/BoundConstant.hpp"
 #include "parser/binder/BoundFunction.hpp"
+#include "planner/ScanPredicateExtractor.hpp"
 #include "storage/Block.hpp"
 #include "storage/column/Column.hpp"
 #include "storage/column/ColumnString.hpp"
@@ -64,118 +63,6 @@ static ColumnPtr FilterColumnData(const ColumnPtr &col,
   }
 }
 
-// 翻转比较算子（当常量在左边时）
-static FunctionComparison::Operator
-FlipOperator(FunctionComparison::Operator op) {
-  using Op = FunctionComparison::Operator;
-  switch (op) {
-  case Op::Less: return Op::Greater;
-  case Op::LessOrEquals: return Op::GreaterOrEquals;
-  case Op::Greater: return Op::Less;
-  case Op::GreaterOrEquals: return Op::LessOrEquals;
-  case Op::Equals: return Op::Equals;
-  case Op::NotEquals: return Op::NotEquals;
-  }
-  return op;
-}
-
-// 从 BoundExpression 树中提取可下推的简单谓词
-// 只处理 AND 连接的 column <op> constant 形式
-static void ExtractPredicates(const BoundExpressRef &expr,
-                              const std::vector<FilterColumnScan> &columns,
-                              std::vector<ScanPredicate> &pushed,
-                              bool &all_pushed) {
-  if (expr->expr_type_ != BoundExpressType::BoundFunction) {
-    all_pushed = false;
-    return;
-  }
-
-  auto &func_expr = static_cast<BoundFunction &>(*expr);
-  auto func = func_expr.GetFunction();
-  auto args = func_expr.GetArguments();
-
-  // AND: 递归提取两个子表达式
-  auto *logical = dynamic_cast<FunctionLogical *>(func.get());
-  if (logical) {
-    if (logical->GetOperator() == FunctionLogical::Operator::And) {
-      if (args.size() == 2) {
-        ExtractPredicates(args[0], columns, pushed, all_pushed);
-        ExtractPredicates(args[1], columns, pushed, all_pushed);
-      }
-      return;
-    }
-    // OR 或其他逻辑算子：不下推
-    all_pushed = false;
-    return;
-  }
-
-  // 比较算子: column <op> constant
-  auto *cmp = dynamic_cast<FunctionComparison *>(func.get());
-  if (!cmp || args.size() != 2) {
-    all_pushed = false;
-    return;
-  }
-
-  // 识别 column 和 constant 参数
-  BoundColumnMeta *col_arg = nullptr;
-  BoundConstant *const_arg = nullptr;
-  bool const_on_left = false;
-
-  if (args[0]->expr_type_ == BoundExpressType::BoundColumnMeta &&
-      args[1]->expr_type_ == BoundExpressType::BoundConstant) {
-    col_arg = static_cast<BoundColumnMeta *>(args[0].get());
-    const_arg = static_cast<BoundConstant *>(args[1].get());
-  } else if (args[0]->expr_type_ == BoundExpressType::BoundConstant &&
-             args[1]->expr_type_ == BoundExpressType::BoundColumnMeta) {
-    col_arg = static_cast<BoundColumnMeta *>(args[1].get());
-    const_arg = static_cast<BoundConstant *>(args[0].get());
-    const_on_left = true;
-  } else {
-    all_pushed = false;
-    return;
-  }
-
-  // 在 condition_columns_ 中查找该列的 column_idx
-  auto col_name = col_arg->GetColumnMeta()->name_;
-  size_t found_col_idx = SIZE_MAX;
-  ValueType::Type col_type = ValueType::Type::Null;
-  for (const auto &cs : columns) {
-    if (cs.column_meta->name_ == col_name) {
-      found_col_idx = cs.column_idx;
-      col_type = cs.column_meta->type_->GetType();
-      break;
-    }
-  }
-
-  if (found_col_idx == SIZE_MAX) {
-    all_pushed = false;
-    return;
-  }
-
-  auto op = cmp->GetOperator();
-  if (const_on_left) {
-    op = FlipOperator(op);
-  }
-
-  ScanPredicate pred;
-  pred.column_idx = found_col_idx;
-  pred.column_type = col_type;
-  pred.op = op;
-
-  switch (const_arg->type_->GetType()) {
-  case ValueType::Type::Int: pred.const_int = const_arg->value_.i32; break;
-  case ValueType::Type::Double:
-    pred.const_double = const_arg->value_.f64;
-    break;
-  case ValueType::Type::String:
-    pred.const_string = std::string(const_arg->value_.str, const_arg->size_);
-    break;
-  default: all_pushed = false; return;
-  }
-
-  pushed.push_back(std::move(pred));
-}
-
 Status FilterExecutor::ScanConditionColumns() {
   // 按 LSMTree 指针分组 condition_columns_
   std::unordered_map<LSMTree *, std::vector<std::pair<size_t, size_t>>>
@@ -212,6 +99,17 @@ Status FilterExecutor::ScanConditionColumns() {
   return Status::OK();
 }
 
+Status FilterExecutor::IndexScanConditionColumns() {
+  auto status = index_scan_->Execute();
+  if (!status.ok()) {
+    return status;
+  }
+  for (auto &col : index_scan_->GetSchema()->GetColumns()) {
+    condition_column_data_[col->GetColumnName()] = col->GetColumn();
+  }
+  return Status::OK();
+}
+
 Status FilterExecutor::Execute() {
   if (!condition_) {
     // 没有 WHERE 条件，直接执行子节点
@@ -231,10 +129,19 @@ Status FilterExecutor::Execute() {
   // 1. 提取可下推谓词
   std::vector<ScanPredicate> pushed_predicates;
   bool all_pushed = true;
-  ExtractPredicates(condition_, condition_columns_, pushed_predicates,
-                    all_pushed);
+  ExtractScanPredicates(condition_, condition_columns_, pushed_predicates,
+                        all_pushed);
 
-  // 2. 带谓词下推的扫描路径
+  // 2. 有二级索引时只取索引命中的行，其余条件照常求值
+  if (index_scan_) {
+    auto status = IndexScanConditionColumns();
+    if (!status.ok()) {
+      return status;
+    }
+    pushed_predicates.clear();
+  }
+
+  // 3. 带谓词下推的扫描路径
   if (!pushed_predicates.empty()) {
     // 按 LSMTree 指针分组
     std::unordered_map<LSMTree *, std::vector<std::pair<size_t, size_t>>>
@@ -300,10 +207,12 @@ Status FilterExecutor::Execute() {
       }
     }
   } else {
-    // 无可下推谓词，走现有路径
-    auto status = ScanConditionColumns();
-    if (!status.ok()) {
-      return status;
+    // 无可下推谓词（或已由索引读出），走现有路径
+    if (!index_scan_) {
+      auto status = ScanConditionColumns();
+      if (!status.ok()) {
+        return status;
+      }
     }
 
     auto eval_column = EvalCondition(condition_);
@@ -17,6 +17,8 @@ class FilterExecutor : public AbstractExecutor {
   std::vector<AbstractExecutorRef> children_;
   BoundExpressRef condition_;
   std::vector<FilterColumnScan> condition_columns_;
+  // 二级索引扫描，非空时替代条件列的全表扫描
+  AbstractExecutorRef index_scan_;
 
   // WHERE 条件中列名到列数据的映射（独立扫描的列）
   std::unordered_map<std::string, ColumnPtr> condition_column_data_;
@@ -27,13 +29,18 @@ class FilterExecutor : public AbstractExecutor {
   // 扫描 WHERE 条件中需要的列
   Status ScanConditionColumns();
 
+  // 通过二级索引读取条件列
+  Status IndexScanConditionColumns();
+
 public:
   FilterExecutor(SchemaRef schema, std::vector<AbstractExecutorRef> children,
                  BoundExpressRef condition,
-                 std::vector<FilterColumnScan> condition_columns = {})
+                 std::vector<FilterColumnScan> condition_columns = {},
+                 AbstractExecutorRef index_scan = nullptr)
       : AbstractExecutor(std::move(schema)), children_(std::move(children)),
         condition_(std::move(condition)),
-        condition_columns_(std::move(condition_columns)) {}
+        condition_columns_(std::move(condition_columns)),
+        index_scan_(std::move(index_scan)) {}
 
   ~FilterExecutor() override = default;
 
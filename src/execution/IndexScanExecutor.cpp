@@ -0,0 +1,87 @@
+#include "execution/IndexScanExecutor.hpp"
+#include "common/Status.hpp"
+#include "storage/column/Column.hpp"
+#include "storage/column/ColumnString.hpp"
+#include "storage/column/ColumnVector.hpp"
+#include "storage/column/ColumnWithNameType.hpp"
+#include "storage/lsmtree/RowCodec.hpp"
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace DB {
+
+// 从行编码中取出一列追加到 res，长度为 0 视为 null
+static void AppendRowValue(const Slice &row, size_t column_idx,
+                           ValueType::Type type, ColumnPtr &res) {
+  const Byte *ptr = nullptr;
+  uint32_t len = 0;
+  if (!RowCodec::DecodeColumnRaw(row.GetData(), row.Size(), column_idx, ptr,
+                                 len)) {
+    len = 0;
+  }
+  switch (type) {
+  case ValueType::Type::Int: {
+    int v = 0;
+    if (len == sizeof(int)) {
+      std::memcpy(&v, ptr, sizeof(int));
+    }
+    static_cast<ColumnVector<int> *>(res.get())->Insert(v);
+    break;
+  }
+  case ValueType::Type::Double: {
+    double v = 0.0;
+    if (len == sizeof(double)) {
+      std::memcpy(&v, ptr, sizeof(double));
+    }
+    static_cast<ColumnVector<double> *>(res.get())->Insert(v);
+    break;
+  }
+  case ValueType::Type::String:
+    static_cast<ColumnString *>(res.get())->Insert(
+        len > 0 ? std::string(ptr, len) : std::string());
+    break;
+  case ValueType::Type::Null: return;
+  }
+  if (len == 0) {
+    res->SetNull(res->Size() - 1);
+  }
+}
+
+Status IndexScanExecutor::Execute() {
+  if (!lsm_tree_) {
+    return Status::Error(ErrorCode::NotFound, "Table storage not initialized");
+  }
+
+  std::vector<Slice> rows;
+  auto s = lsm_tree_->IndexScan(index_column_idx_, predicates_, rows);
+  if (!s.ok()) {
+    return s;
+  }
+
+  for (const auto &col_scan : output_columns_) {
+    auto &col_meta = col_scan.column_meta;
+    auto type = col_meta->type_->GetType();
+    ColumnPtr column;
+    switch (type) {
+    case ValueType::Type::Int:
+      column = std::make_shared<ColumnVector<int>>();
+      break;
+    case ValueType::Type::Double:
+      column = std::make_shared<ColumnVector<double>>();
+      break;
+    case ValueType::Type::String:
+      column = std::make_shared<ColumnString>();
+      break;
+    case ValueType::Type::Null: continue;
+    }
+    for (const auto &row : rows) {
+      AppendRowValue(row, col_scan.column_idx, type, column);
+    }
+    schema_->GetColumns().emplace_back(std::make_shared<ColumnWithNameType>(
+        column, col_meta->name_, col_meta->type_));
+  }
+  return Status::OK();
+}
+} // namespace DB
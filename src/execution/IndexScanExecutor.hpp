@@ -0,0 +1,33 @@
+#pragma once
+
+#include "execution/AbstractExecutor.hpp"
+#include "planner/FilterPlanNode.hpp"
+#include "storage/lsmtree/LSMTree.hpp"
+#include "storage/lsmtree/ScanPredicate.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace DB {
+class IndexScanExecutor : public AbstractExecutor {
+  std::shared_ptr<LSMTree> lsm_tree_;
+  size_t index_column_idx_;
+  std::vector<ScanPredicate> predicates_;
+  std::vector<FilterColumnScan> output_columns_;
+
+public:
+  IndexScanExecutor(SchemaRef schema, std::shared_ptr<LSMTree> lsm_tree,
+                    size_t index_column_idx,
+                    std::vector<ScanPredicate> predicates,
+                    std::vector<FilterColumnScan> output_columns)
+      : AbstractExecutor(std::move(schema)), lsm_tree_(std::move(lsm_tree)),
+        index_column_idx_(index_column_idx),
+        predicates_(std::move(predicates)),
+        output_columns_(std::move(output_columns)) {}
+
+  ~IndexScanExecutor() override = default;
+
+  Status Execute() override;
+};
+} // namespace DB
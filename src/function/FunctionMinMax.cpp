@@ -0,0 +1,75 @@
+#include "function/FunctionMinMax.hpp"
+#include "storage/Block.hpp"
+#include "storage/column/ColumnVector.hpp"
+#include "type/Double.hpp"
+#include "type/Int.hpp"
+
+#include "fmt/format.h"
+
+namespace DB {
+template <typename T>
+static void MinMaxColumn(ColumnVector<T> &col, FunctionMinMax::Op op,
+                         ColumnVector<T> &res) {
+  const auto &values = col.Data();
+  bool found = false;
+  T best{};
+  for (size_t i = 0; i < values.size(); i++) {
+    if (col.IsNull(i)) {
+      continue;
+    }
+    if (!found || (op == FunctionMinMax::Op::Min ? values[i] < best
+                                                 : values[i] > best)) {
+      best = values[i];
+      found = true;
+    }
+  }
+  res.Insert(best);
+  if (!found) {
+    res.SetNull(res.Size() - 1);
+  }
+}
+
+Status FunctionMinMax::ResolveResultType(
+    Block &block, std::shared_ptr<ValueType> &result_type) const {
+  if (block.Size() != 1) {
+    return Status::Error(ErrorCode::BindError,
+                         fmt::format("{} requires exactly 1 argument",
+                                     GetName()));
+  }
+  switch (block.GetColumn(0)->GetValueType()->GetType()) {
+  case ValueType::Type::Int: result_type = std::make_shared<Int>(); break;
+  case ValueType::Type::Double: result_type = std::make_shared<Double>(); break;
+  default:
+    return Status::Error(
+        ErrorCode::BindError,
+        fmt::format("{} only supports INT or DOUBLE columns", GetName()));
+  }
+  return Status::OK();
+}
+
+Status FunctionMinMax::ExecuteImpl(Block &block, size_t result_idx,
+                                   size_t input_rows_count) const {
+  if (result_idx != 1) {
+    return Status::Error(ErrorCode::BindError,
+                         fmt::format("{} requires exactly 1 argument",
+                                     GetName()));
+  }
+  auto input_col = block.GetColumn(0);
+  auto &res = *block.GetColumn(result_idx)->GetColumn();
+  switch (input_col->GetValueType()->GetType()) {
+  case ValueType::Type::Int:
+    MinMaxColumn(static_cast<ColumnVector<int> &>(*input_col->GetColumn()),
+                 op_, static_cast<ColumnVector<int> &>(res));
+    break;
+  case ValueType::Type::Double:
+    MinMaxColumn(static_cast<ColumnVector<double> &>(*input_col->GetColumn()),
+                 op_, static_cast<ColumnVector<double> &>(res));
+    break;
+  default:
+    return Status::Error(
+        ErrorCode::BindError,
+        fmt::format("{} only supports INT or DOUBLE columns", GetName()));
+  }
+  return Status::OK();
+}
+} // namespace DB
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "common/Status.hpp"
+#include "function/Function.hpp"
+#include "type/Int.hpp"
+
+#include <memory>
+#include <string>
+
+namespace DB {
+// MIN / MAX：跳过 NULL，结果类型与输入列相同，没有非 NULL 值时返回 NULL
+class FunctionMinMax final : public Function {
+public:
+  enum class Op { Min, Max };
+
+  explicit FunctionMinMax(Op op) : op_(op) {}
+
+  std::string GetName() const override {
+    return op_ == Op::Min ? "MIN" : "MAX";
+  }
+
+  std::shared_ptr<ValueType> GetResultType() const override {
+    return std::make_shared<Int>();
+  }
+
+  Status
+  ResolveResultType(Block &block,
+                    std::shared_ptr<ValueType> &result_type) const override;
+
+  Status ExecuteImpl(Block &block, size_t result_idx,
+                     size_t input_rows_count) const override;
+
+private:
+  Op op_;
+};
+} // namespace DB
@@ -130,9 +130,10 @@ Status FunctionSimdSum::ExecuteImpl(Block &block, size_t result_idx,
   case ValueType::Type::Int: {
     auto &col = static_cast<ColumnVector<int> &>(*input_col->GetColumn());
     if (col.HasSpans()) {
-      // 零拷贝路径：直接从 mmap 指针 SIMD 求和
+      // 零拷贝路径：直接从 mmap 指针 SIMD 求和，run-length span 按 run 求和
       for (const auto &span : col.Spans()) {
-        sum += SimdSumInt(span.ptr, span.count);
+        sum += span.run_ends ? span.RunSum()
+                             : SimdSumInt(span.ptr, span.count);
       }
     } else {
       sum = SimdSumInt(col.Data().data(), input_rows_count);
@@ -143,7 +144,8 @@ Status FunctionSimdSum::ExecuteImpl(Block &block, size_t result_idx,
     auto &col = static_cast<ColumnVector<double> &>(*input_col->GetColumn());
     if (col.HasSpans()) {
       for (const auto &span : col.Spans()) {
-        sum += SimdSumDouble(span.ptr, span.count);
+        sum += span.run_ends ? span.RunSum()
+                             : SimdSumDouble(span.ptr, span.count);
       }
     } else {
       sum = SimdSumDouble(col.Data().data(), input_rows_count);
@@ -38,8 +38,12 @@ Status FunctionSum::ExecuteImpl(Block &block, size_t result_idx,
   case ValueType::Type::Int: {
     auto &col = static_cast<ColumnVector<int> &>(*input_col->GetColumn());
     if (col.HasSpans()) {
-      // 零拷贝路径：直接从 mmap 指针求和
+      // 零拷贝路径：直接从 mmap 指针求和，run-length span 按 run 求和
       for (const auto &span : col.Spans()) {
+        if (span.run_ends) {
+          sum += span.RunSum();
+          continue;
+        }
         for (size_t i = 0; i < span.count; i++) {
           sum += span.ptr[i];
         }
@@ -55,6 +59,10 @@ Status FunctionSum::ExecuteImpl(Block &block, size_t result_idx,
     auto &col = static_cast<ColumnVector<double> &>(*input_col->GetColumn());
     if (col.HasSpans()) {
       for (const auto &span : col.Spans()) {
+        if (span.run_ends) {
+          sum += span.RunSum();
+          continue;
+        }
         for (size_t i = 0; i < span.count; i++) {
           sum += span.ptr[i];
         }
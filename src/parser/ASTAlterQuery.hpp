@@ -0,0 +1,30 @@
+#pragma once
+
+#include "common/EnumClass.hpp"
+#include "parser/AST.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace DB {
+// ALTER TABLE <table_name> SET (name = value, ...)
+class AlterQuery : public AST {
+  std::string table_name_;
+  std::vector<std::pair<std::string, std::string>> options_;
+
+public:
+  AlterQuery(std::string table_name,
+             std::vector<std::pair<std::string, std::string>> options)
+      : AST(ASTNodeType::AlterQuery), table_name_(std::move(table_name)),
+        options_(std::move(options)) {}
+
+  ~AlterQuery() override = default;
+
+  const std::string &GetTableName() const { return table_name_; }
+
+  const std::vector<std::pair<std::string, std::string>> &GetOptions() const {
+    return options_;
+  }
+};
+} // namespace DB
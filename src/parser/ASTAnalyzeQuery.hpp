@@ -0,0 +1,20 @@
+#pragma once
+
+#include "common/EnumClass.hpp"
+#include "parser/AST.hpp"
+
+#include <string>
+
+namespace DB {
+class AnalyzeQuery : public AST {
+  std::string table_name_;
+
+public:
+  explicit AnalyzeQuery(std::string table_name)
+      : AST(ASTNodeType::AnalyzeQuery), table_name_(std::move(table_name)) {}
+
+  ~AnalyzeQuery() override = default;
+
+  const std::string &GetTableName() const { return table_name_; }
+};
+} // namespace DB
@@ -4,6 +4,8 @@
 #include "parser/AST.hpp"
 
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace DB {
 class CreateQuery : public AST {
@@ -20,6 +22,9 @@ public:
 
   std::string GetName() { return name_; }
 
+  // WITH (name = value, ...) 中的表级选项，值在 Transform 中校验
+  std::vector<std::pair<std::string, std::string>> options_;
+
 private:
   CreateType type_;
   std::string name_;
@@ -49,6 +49,12 @@ Status Binder::Parse(std::string_view query,
   case ASTNodeType::DeleteQuery:
     statement_ = Transform::TransDeleteQuery(parser_.tree_, message, context);
     break;
+  case ASTNodeType::AnalyzeQuery:
+    statement_ = Transform::TransAnalyzeQuery(parser_.tree_, message, context);
+    break;
+  case ASTNodeType::AlterQuery:
+    statement_ = Transform::TransAlterQuery(parser_.tree_, message, context);
+    break;
   default:
   }
   if (statement_ == nullptr) {
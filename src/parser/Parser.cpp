@@ -5,6 +5,8 @@
 #include "parser/ASTCreateQuery.hpp"
 #include "parser/ASTDeleteQuery.hpp"
 #include "parser/ASTDropQuery.hpp"
+#include "parser/ASTAlterQuery.hpp"
+#include "parser/ASTAnalyzeQuery.hpp"
 #include "parser/ASTFlushQuery.hpp"
 #include "parser/ASTInsertQuery.hpp"
 #include "parser/ASTSelectQuery.hpp"
@@ -21,9 +23,43 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace DB {
+namespace {
+// 解析 (name = value, ...)，value 为数字或单词，iterator 指向 (，
+// 且选项必须在语句末尾
+Status ParseTableOptions(
+    TokenIterator &iterator,
+    std::vector<std::pair<std::string, std::string>> &options) {
+  if (iterator->type != TokenType::OpeningRoundBracket) {
+    goto SYNTAXERROR;
+  }
+  do {
+    if ((++iterator)->type != TokenType::BareWord) {
+      goto SYNTAXERROR;
+    }
+    std::string name{iterator->begin, iterator->end};
+    if ((++iterator)->type != TokenType::Equals ||
+        ((++iterator)->type != TokenType::Number &&
+         iterator->type != TokenType::BareWord)) {
+      goto SYNTAXERROR;
+    }
+    options.emplace_back(std::move(name),
+                         std::string{iterator->begin, iterator->end});
+  } while ((++iterator)->type == TokenType::Comma);
+  if (iterator->type != TokenType::ClosingRoundBracket ||
+      !(++iterator)->isEnd()) {
+    goto SYNTAXERROR;
+  }
+  return Status::OK();
+
+SYNTAXERROR:
+  return Status::Error(ErrorCode::SyntaxError,
+                       "Usage: (OPTION = value [, OPTION = value ...])");
+}
+} // namespace
 
 Status Parser::Parse(TokenIterator &iterator) {
   auto token = *iterator;
@@ -51,11 +87,16 @@ Status Parser::Parse(TokenIterator &iterator) {
       status = ParseFlush(iterator);
     } else if (str == "DELETE") {
       status = ParseDelete(iterator);
+    } else if (str == "ANALYZE") {
+      status = ParseAnalyze(iterator);
+    } else if (str == "ALTER") {
+      status = ParseAlter(iterator);
     }
   } else {
     status = Status::Error(ErrorCode::SyntaxError,
                            "ZeitKert Just Support CREATE, USE, SHOW, DROP, "
-                           "SELECT, INSERT, FLUSH, DELETE Query");
+                           "SELECT, INSERT, FLUSH, DELETE, ANALYZE, ALTER "
+                           "Query");
   }
   return status;
 }
@@ -116,6 +157,39 @@ Status Parser::ParseCreate(TokenIterator &iterator) {
           }
         }
       }
+
+      // 可选的 WITH (...) 表级选项，放在语句末尾
+      auto with = iterator;
+      while (!(++with)->isEnd()) {
+        std::string keyword{with->begin, with->end};
+        if (with->type == TokenType::BareWord && Checker::IsKeyWord(keyword) &&
+            keyword == "WITH") {
+          return ParseTableOptions(
+              ++with, static_cast<CreateQuery &>(*tree_).options_);
+        }
+      }
+    } else if (str == "INDEX") {
+      // CREATE INDEX ON table(column)
+      std::string on{iterator->begin, iterator->end};
+      if (!Checker::IsKeyWord(on) || on != "ON" ||
+          (++iterator)->type != TokenType::BareWord) {
+        return Status::Error(ErrorCode::SyntaxError,
+                             "Usage: CREATE INDEX ON table(column)");
+      }
+      tree_ = std::make_shared<CreateQuery>(
+          CreateType::Index, std::string{iterator->begin, iterator->end});
+      auto col_name = iterator;
+      if ((++iterator)->type != TokenType::OpeningRoundBracket ||
+          (col_name = ++iterator)->type != TokenType::BareWord ||
+          (++iterator)->type != TokenType::ClosingRoundBracket) {
+        return Status::Error(ErrorCode::SyntaxError,
+                             "Usage: CREATE INDEX ON table(column)");
+      }
+      // 列名保存到 children_[0]
+      std::optional<TokenIterator> col_begin{col_name};
+      std::optional<TokenIterator> col_end{col_name};
+      tree_->children_.emplace_back(
+          std::make_shared<ASTToken>(col_begin, col_end));
     }
   }
   return Status::OK();
@@ -364,6 +438,57 @@ Status Parser::ParseFlush(TokenIterator &iterator) {
   return Status::OK();
 }
 
+Status Parser::ParseAnalyze(TokenIterator &iterator) {
+  // ANALYZE TABLE <table_name>
+  ++iterator;
+  std::string s{iterator->begin, iterator->end};
+  if (iterator->type != TokenType::BareWord || s != "TABLE") {
+    return Status::Error(ErrorCode::SyntaxError,
+                         "Expected TABLE after ANALYZE");
+  }
+  ++iterator;
+  if (iterator->type != TokenType::BareWord) {
+    return Status::Error(ErrorCode::SyntaxError,
+                         "Expected table name after ANALYZE TABLE");
+  }
+  std::string table_name{iterator->begin, iterator->end};
+  if (!(++iterator)->isEnd()) {
+    return Status::Error(ErrorCode::SyntaxError,
+                         "Unexpected token after table name");
+  }
+  tree_ = std::make_shared<AnalyzeQuery>(std::move(table_name));
+  return Status::OK();
+}
+
+Status Parser::ParseAlter(TokenIterator &iterator) {
+  // ALTER TABLE <table_name> SET (name = value, ...)
+  ++iterator;
+  std::string s{iterator->begin, iterator->end};
+  if (iterator->type != TokenType::BareWord || s != "TABLE") {
+    return Status::Error(ErrorCode::SyntaxError, "Expected TABLE after ALTER");
+  }
+  ++iterator;
+  if (iterator->type != TokenType::BareWord) {
+    return Status::Error(ErrorCode::SyntaxError,
+                         "Expected table name after ALTER TABLE");
+  }
+  std::string table_name{iterator->begin, iterator->end};
+  ++iterator;
+  s = std::string{iterator->begin, iterator->end};
+  if (iterator->type != TokenType::BareWord || s != "SET") {
+    return Status::Error(ErrorCode::SyntaxError,
+                         "Expected SET after table name");
+  }
+  std::vector<std::pair<std::string, std::string>> options;
+  auto status = ParseTableOptions(++iterator, options);
+  if (!status.ok()) {
+    return status;
+  }
+  tree_ = std::make_shared<AlterQuery>(std::move(table_name),
+                                       std::move(options));
+  return Status::OK();
+}
+
 Status Parser::ParseDelete(TokenIterator &iterator) {
   // 解析 DELETE FROM <table> [WHERE <condition>]
   ++iterator;
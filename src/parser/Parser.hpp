@@ -28,6 +28,10 @@ public:
 
   Status ParseDelete(TokenIterator &iterator);
 
+  Status ParseAnalyze(TokenIterator &iterator);
+
+  Status ParseAlter(TokenIterator &iterator);
+
   ASTPtr tree_{nullptr};
 };
 } // namespace DB
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include "parser/ASTAlterQuery.hpp"
+#include "parser/Transform.hpp"
+
+namespace DB {
+std::shared_ptr<AlterStatement>
+Transform::TransAlterQuery(ASTPtr node, std::string &message,
+                           std::shared_ptr<QueryContext> context) {
+  auto &alter_query = static_cast<AlterQuery &>(*node);
+  if (context->database_ == nullptr) {
+    message = "you have not choice any database";
+    return nullptr;
+  }
+  auto table_name = alter_query.GetTableName();
+  auto table_meta = context->database_->GetTableMeta(table_name);
+  if (table_meta == nullptr) {
+    message = "the table not exist, please check table name";
+    return nullptr;
+  }
+  int pk_idx = table_meta->GetPrimaryKeyIndex();
+  bool int_key =
+      pk_idx >= 0 && table_meta->GetColumns()[pk_idx]->type_->GetType() ==
+                         ValueType::Type::Int;
+  std::map<std::string, uint64_t> options;
+  if (!TransTableOptions(alter_query.GetOptions(), int_key, options,
+                         message)) {
+    return nullptr;
+  }
+  return std::make_shared<AlterStatement>(std::move(table_name),
+                                          std::move(options));
+}
+} // namespace DB
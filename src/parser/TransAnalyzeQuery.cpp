@@ -0,0 +1,12 @@
+#include "parser/ASTAnalyzeQuery.hpp"
+#include "parser/Transform.hpp"
+
+namespace DB {
+std::shared_ptr<AnalyzeStatement>
+Transform::TransAnalyzeQuery(ASTPtr node, std::string &message,
+                             std::shared_ptr<QueryContext> context) {
+  auto &analyze_query = static_cast<AnalyzeQuery &>(*node);
+
+  return std::make_shared<AnalyzeStatement>(analyze_query.GetTableName());
+}
+} // namespace DB
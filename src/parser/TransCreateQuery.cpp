@@ -2,8 +2,57 @@
 #include "parser/ASTToken.hpp"
 #include "parser/Checker.hpp"
 #include "parser/Transform.hpp"
+#include "storage/lsmtree/SpaceFillingCurve.hpp"
+
+#include <charconv>
 
 namespace DB {
+bool Transform::TransTableOptions(
+    const std::vector<std::pair<std::string, std::string>> &raw, bool int_key,
+    std::map<std::string, uint64_t> &options, std::string &message) {
+  for (const auto &[name, text] : raw) {
+    if (!TableMeta::IsOption(name)) {
+      message = "unknown table option '" + name + "'";
+      return false;
+    }
+    if (name == TableMeta::kClusterCurve) {
+      if (text != "ZORDER" && text != "HILBERT") {
+        message = "table option '" + name + "' must be ZORDER or HILBERT";
+        return false;
+      }
+      options[name] = static_cast<uint64_t>(
+          text == "HILBERT" ? ClusterCurve::Hilbert : ClusterCurve::ZOrder);
+      continue;
+    }
+    uint64_t value = 0;
+    auto [end, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{} || end != text.data() + text.size()) {
+      message = "table option '" + name + "' needs an integer value";
+      return false;
+    }
+    // 字节预算过小时每个 RowGroup 只有几行，元数据开销压过数据本身
+    bool valid = true;
+    if (name == TableMeta::kRowGroupRows) {
+      valid = value >= 1 && value <= UINT32_MAX;
+    } else if (name == TableMeta::kRowGroupBytes) {
+      valid = value >= 4096 && value <= (1ULL << 30);
+    } else if (name == TableMeta::kRowGroupKeyBoundary) {
+      if (value != 0 && !int_key) {
+        message = "table option '" + name + "' needs an INT UNIQUE KEY";
+        return false;
+      }
+      valid = value <= UINT32_MAX;
+    }
+    if (!valid) {
+      message = "table option '" + name + "' is out of range";
+      return false;
+    }
+    options[name] = value;
+  }
+  return true;
+}
+
 std::shared_ptr<CreateStatement>
 Transform::TransCreateQuery(ASTPtr node, std::string &message,
                             std::shared_ptr<QueryContext> context) {
@@ -12,6 +61,40 @@ Transform::TransCreateQuery(ASTPtr node, std::string &message,
   auto type = create_query.GetType();
   std::vector<ColumnMetaRef> columns;
   std::string unique_key;
+  bool int_key = false;
+  if (type == CreateType::Index) {
+    if (context->database_ == nullptr) {
+      message = "you have not choice any database";
+      return nullptr;
+    }
+    auto table_meta = context->database_->GetTableMeta(name);
+    if (table_meta == nullptr) {
+      message = "the table not exist, please check table name";
+      return nullptr;
+    }
+    auto &col_node = static_cast<ASTToken &>(*create_query.children_[0]);
+    auto col_it = col_node.Begin();
+    auto index_column = std::string{col_it->begin, col_it->end};
+    bool exists = false;
+    for (const auto &col : table_meta->GetColumns()) {
+      exists = exists || col->name_ == index_column;
+    }
+    if (!exists) {
+      message =
+          "INDEX column '" + index_column + "' not found in table columns";
+      return nullptr;
+    }
+    if (index_column == table_meta->GetUniqueKeyColumn()) {
+      message = "UNIQUE KEY column '" + index_column + "' is already indexed";
+      return nullptr;
+    }
+    if (table_meta->HasIndex(index_column)) {
+      message = "INDEX on column '" + index_column + "' already exists";
+      return nullptr;
+    }
+    return std::make_shared<CreateStatement>(type, name, columns, unique_key,
+                                             index_column);
+  }
   if (type == CreateType::Table) {
     auto &node_query = static_cast<ASTToken &>(*create_query.children_[0]);
     auto it = node_query.Begin();
@@ -30,7 +113,8 @@ Transform::TransCreateQuery(ASTPtr node, std::string &message,
       }
       // we will get all messages of one column
       // tokens[0] is col_name tokens[1] is val type
-      // current version not upport others
+      // tokens[2..] 可选 BLOOM（生成值过滤器）、GORILLA（Double 列 XOR 编码）
+      // 与 CLUSTER（最底层按这些列聚簇）
       std::shared_ptr<ValueType> type;
       auto col_name = std::string{tokens[0].begin, tokens[0].end};
       auto var_type = std::string{tokens[1].begin, tokens[1].end};
@@ -45,7 +129,27 @@ Transform::TransCreateQuery(ASTPtr node, std::string &message,
           return nullptr;
         }
       }
-      columns.emplace_back(std::make_shared<ColumnMeta>(col_name, type));
+      auto column = std::make_shared<ColumnMeta>(col_name, type);
+      for (size_t t = 2; t < tokens.size(); t++) {
+        auto attribute = std::string{tokens[t].begin, tokens[t].end};
+        if (Checker::IsKeyWord(attribute) && attribute == "BLOOM") {
+          column->bloom_ = true;
+        } else if (Checker::IsKeyWord(attribute) && attribute == "CLUSTER") {
+          column->cluster_ = true;
+        } else if (Checker::IsKeyWord(attribute) && attribute == "GORILLA") {
+          if (!type || type->GetType() != ValueType::Type::Double) {
+            message = "GORILLA only applies to DOUBLE column '" + col_name +
+                      "'";
+            return nullptr;
+          }
+          column->gorilla_ = true;
+        } else {
+          message = "unknown attribute '" + attribute + "' on column '" +
+                    col_name + "'";
+          return nullptr;
+        }
+      }
+      columns.emplace_back(std::move(column));
     }
 
     // 解析 UNIQUE KEY 子句
@@ -79,9 +183,43 @@ Transform::TransCreateQuery(ASTPtr node, std::string &message,
         message = "UNIQUE KEY column '" + unique_key + "' cannot be DOUBLE";
         return nullptr;
       }
+      int_key = unique_col->type_->GetType() == ValueType::Type::Int;
+      // 聚簇文件依赖 int 主键的 key 列在 RowGroup 之间归并
+      size_t cluster_count = 0;
+      for (const auto &col : columns) {
+        if (!col->cluster_) {
+          continue;
+        }
+        if (col == unique_col) {
+          message = "UNIQUE KEY column '" + unique_key +
+                    "' already orders the table, CLUSTER is not needed";
+          return nullptr;
+        }
+        if (!int_key) {
+          message = "CLUSTER columns need an INT UNIQUE KEY";
+          return nullptr;
+        }
+        cluster_count++;
+      }
+      if (cluster_count > ClusterSpec::kMaxColumns) {
+        message = "at most " + std::to_string(ClusterSpec::kMaxColumns) +
+                  " columns can be CLUSTER";
+        return nullptr;
+      }
+      if (unique_col->bloom_) {
+        message = "UNIQUE KEY column '" + unique_key +
+                  "' already has a key filter, BLOOM is not needed";
+        return nullptr;
+      }
     }
   }
-  return std::make_shared<CreateStatement>(type, name, columns, unique_key);
+  auto statement =
+      std::make_shared<CreateStatement>(type, name, columns, unique_key);
+  if (!TransTableOptions(create_query.options_, int_key,
+                         statement->GetOptions(), message)) {
+    return nullptr;
+  }
+  return statement;
 }
 
 } // namespace DB
@@ -4,6 +4,8 @@
 #include "parser/AST.hpp"
 #include "parser/TokenIterator.hpp"
 #include "parser/binder/BoundExpress.hpp"
+#include "parser/statement/AlterStatement.hpp"
+#include "parser/statement/AnalyzeStatement.hpp"
 #include "parser/statement/CreateStatement.hpp"
 #include "parser/statement/DeleteStatement.hpp"
 #include "parser/statement/DropStatement.hpp"
@@ -48,6 +50,14 @@ struct Transform {
   TransDeleteQuery(ASTPtr node, std::string &message,
                    std::shared_ptr<QueryContext> context);
 
+  static std::shared_ptr<AnalyzeStatement>
+  TransAnalyzeQuery(ASTPtr node, std::string &message,
+                    std::shared_ptr<QueryContext> context);
+
+  static std::shared_ptr<AlterStatement>
+  TransAlterQuery(ASTPtr node, std::string &message,
+                  std::shared_ptr<QueryContext> context);
+
 private:
   static constexpr const char *kAmbiguousColumnFmt =
       "column {} is ambiguous, please use table.column";
@@ -61,6 +71,13 @@ private:
                                           std::vector<BoundExpressRef> &columns,
                                           std::string &message);
 
+  // 校验表级选项名与取值范围，结果写入 options；
+  // int_key 表示主键为 INT，只有这时才能按 key 边界切分 RowGroup
+  static bool
+  TransTableOptions(const std::vector<std::pair<std::string, std::string>> &raw,
+                    bool int_key, std::map<std::string, uint64_t> &options,
+                    std::string &message);
+
   static bool SkipCommas(TokenIterator &it, const TokenIterator &end);
 
   static BoundExpressRef MakeNumericConstant(const Token &token,
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "common/EnumClass.hpp"
+#include "parser/SQLStatement.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace DB {
+class AlterStatement : public SQLStatement {
+  std::string table_name_;
+  std::map<std::string, uint64_t> options_;
+
+public:
+  AlterStatement(std::string table_name,
+                 std::map<std::string, uint64_t> options)
+      : SQLStatement(StatementType::AlterStatement),
+        table_name_(std::move(table_name)), options_(std::move(options)) {}
+
+  ~AlterStatement() override = default;
+
+  const std::string &GetTableName() const { return table_name_; }
+
+  const std::map<std::string, uint64_t> &GetOptions() const {
+    return options_;
+  }
+};
+} // namespace DB
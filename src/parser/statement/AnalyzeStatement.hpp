@@ -0,0 +1,21 @@
+#pragma once
+
+#include "common/EnumClass.hpp"
+#include "parser/SQLStatement.hpp"
+
+#include <string>
+
+namespace DB {
+class AnalyzeStatement : public SQLStatement {
+  std::string table_name_;
+
+public:
+  explicit AnalyzeStatement(std::string table_name)
+      : SQLStatement(StatementType::AnalyzeStatement),
+        table_name_(std::move(table_name)) {}
+
+  ~AnalyzeStatement() override = default;
+
+  const std::string &GetTableName() const { return table_name_; }
+};
+} // namespace DB
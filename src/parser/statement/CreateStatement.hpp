@@ -3,6 +3,8 @@
 #include "catalog/meta/ColumnMeta.hpp"
 #include "parser/SQLStatement.hpp"
 
+#include <cstdint>
+#include <map>
 #include <vector>
 
 namespace DB {
@@ -13,10 +15,12 @@ public:
 
   explicit CreateStatement(CreateType &type, std::string &name,
                            std::vector<std::shared_ptr<ColumnMeta>> &columns,
-                           std::string unique_key = "")
+                           std::string unique_key = "",
+                           std::string index_column = "")
       : SQLStatement(StatementType::CreateStatement), type_(type),
         name_(std::move(name)), columns_(std::move(columns)),
-        unique_key_(std::move(unique_key)) {}
+        unique_key_(std::move(unique_key)),
+        index_column_(std::move(index_column)) {}
 
   ~CreateStatement() override = default;
 
@@ -28,6 +32,10 @@ public:
 
   std::string GetUniqueKey() { return unique_key_; }
 
+  std::string GetIndexColumn() { return index_column_; }
+
+  std::map<std::string, uint64_t> &GetOptions() { return options_; }
+
 private:
   CreateType type_;
   // table name or database name
@@ -35,5 +43,9 @@ private:
 
   std::vector<std::shared_ptr<ColumnMeta>> columns_;
   std::string unique_key_;
+  // CREATE INDEX 的列名，name_ 为表名
+  std::string index_column_;
+  // CREATE TABLE ... WITH (...) 的表级选项
+  std::map<std::string, uint64_t> options_;
 };
 } // namespace DB
\ No newline at end of file
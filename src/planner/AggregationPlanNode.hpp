@@ -0,0 +1,52 @@
+#pragma once
+
+#include "catalog/Schema.hpp"
+#include "catalog/meta/ColumnMeta.hpp"
+#include "common/EnumClass.hpp"
+#include "planner/AbstractPlanNode.hpp"
+#include "storage/lsmtree/LSMTree.hpp"
+#include "storage/lsmtree/ScanPredicate.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace DB {
+// SELECT 列表中的一个聚合：function(column)
+struct AggregateExpr {
+  std::string function; // COUNT / SUM / MIN / MAX
+  ColumnMetaRef column_meta;
+  uint32_t column_idx;
+};
+
+// 用 SSTable 的 RowGroup 预聚合回答单表上的 COUNT / SUM / MIN / MAX
+// 唯一的子节点是原计划，内存中还有数据时回退执行
+class AggregationPlanNode : public AbstractPlanNode {
+  std::shared_ptr<LSMTree> lsm_tree_;
+  std::vector<AggregateExpr> aggregates_;
+  std::vector<ScanPredicate> predicates_;
+
+public:
+  AggregationPlanNode(SchemaRef schema, AbstractPlanNodeRef fallback,
+                      std::shared_ptr<LSMTree> lsm_tree,
+                      std::vector<AggregateExpr> aggregates,
+                      std::vector<ScanPredicate> predicates)
+      : AbstractPlanNode(std::move(schema), {std::move(fallback)}),
+        lsm_tree_(std::move(lsm_tree)), aggregates_(std::move(aggregates)),
+        predicates_(std::move(predicates)) {}
+
+  ~AggregationPlanNode() override = default;
+
+  PlanType GetType() const override { return PlanType::Aggregation; }
+
+  std::shared_ptr<LSMTree> GetLSMTree() const { return lsm_tree_; }
+
+  const std::vector<AggregateExpr> &GetAggregates() const {
+    return aggregates_;
+  }
+
+  const std::vector<ScanPredicate> &GetPredicates() const {
+    return predicates_;
+  }
+};
+} // namespace DB
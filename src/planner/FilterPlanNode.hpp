@@ -22,14 +22,18 @@ struct FilterColumnScan {
 class FilterPlanNode : public AbstractPlanNode {
   BoundExpressRef condition_;
   std::vector<FilterColumnScan> condition_columns_;
+  // 非空时由二级索引提供 condition_columns_ 的数据，不再全表扫描
+  AbstractPlanNodeRef index_scan_;
 
 public:
   FilterPlanNode(SchemaRef schema, std::vector<AbstractPlanNodeRef> children,
                  BoundExpressRef condition,
-                 std::vector<FilterColumnScan> condition_columns = {})
+                 std::vector<FilterColumnScan> condition_columns = {},
+                 AbstractPlanNodeRef index_scan = nullptr)
       : AbstractPlanNode(std::move(schema), std::move(children)),
         condition_(std::move(condition)),
-        condition_columns_(std::move(condition_columns)) {}
+        condition_columns_(std::move(condition_columns)),
+        index_scan_(std::move(index_scan)) {}
 
   ~FilterPlanNode() override = default;
 
@@ -40,5 +44,7 @@ public:
   const std::vector<FilterColumnScan> &GetConditionColumns() const {
     return condition_columns_;
   }
+
+  const AbstractPlanNodeRef &GetIndexScan() const { return index_scan_; }
 };
 } // namespace DB
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "catalog/Schema.hpp"
+#include "common/EnumClass.hpp"
+#include "planner/AbstractPlanNode.hpp"
+#include "planner/FilterPlanNode.hpp"
+#include "storage/lsmtree/LSMTree.hpp"
+#include "storage/lsmtree/ScanPredicate.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace DB {
+// 通过二级索引读取 WHERE 条件所需的列，替代 Filter 的全表扫描
+// 输出的行只保证满足 predicates，其余条件仍由 Filter 求值
+class IndexScanPlanNode : public AbstractPlanNode {
+  std::shared_ptr<LSMTree> lsm_tree_;
+  size_t index_column_idx_;
+  std::vector<ScanPredicate> predicates_;
+  std::vector<FilterColumnScan> output_columns_;
+
+public:
+  IndexScanPlanNode(SchemaRef schema, std::shared_ptr<LSMTree> lsm_tree,
+                    size_t index_column_idx,
+                    std::vector<ScanPredicate> predicates,
+                    std::vector<FilterColumnScan> output_columns)
+      : AbstractPlanNode(std::move(schema), {}), lsm_tree_(std::move(lsm_tree)),
+        index_column_idx_(index_column_idx),
+        predicates_(std::move(predicates)),
+        output_columns_(std::move(output_columns)) {}
+
+  ~IndexScanPlanNode() override = default;
+
+  PlanType GetType() const override { return PlanType::IndexScan; }
+
+  std::shared_ptr<LSMTree> GetLSMTree() const { return lsm_tree_; }
+
+  size_t GetIndexColumnIdx() const { return index_column_idx_; }
+
+  const std::vector<ScanPredicate> &GetPredicates() const {
+    return predicates_;
+  }
+
+  const std::vector<FilterColumnScan> &GetOutputColumns() const {
+    return output_columns_;
+  }
+};
+} // namespace DB
@@ -6,11 +6,15 @@
 #include "parser/binder/BoundFunction.hpp"
 #include "parser/statement/SelectStatement.hpp"
 #include "planner/AbstractPlanNode.hpp"
+#include "planner/AggregationPlanNode.hpp"
 #include "planner/FilterPlanNode.hpp"
+#include "planner/IndexScanPlanNode.hpp"
 #include "planner/Planner.hpp"
 #include "planner/ProjectionPlanNode.hpp"
+#include "planner/ScanPredicateExtractor.hpp"
 #include "planner/ValuePlanNode.hpp"
 
+#include <map>
 #include <memory>
 #include <set>
 #include <utility>
@@ -38,6 +42,133 @@ static void CollectColumns(const BoundExpressRef &expr,
   }
 }
 
+// 单表 WHERE 条件中若有二级索引列上的选择性谓词，返回读取条件列的 IndexScan
+// 多个索引列都可用时选估计命中最少的一个
+static AbstractPlanNodeRef
+PlanIndexScan(const BoundExpressRef &condition,
+              const std::vector<FilterColumnScan> &columns) {
+  if (columns.empty()) {
+    return nullptr;
+  }
+  auto &lsm_tree = columns[0].lsm_tree;
+  for (const auto &cs : columns) {
+    if (cs.lsm_tree != lsm_tree) {
+      return nullptr;
+    }
+  }
+
+  std::vector<ScanPredicate> predicates;
+  bool all_pushed = true;
+  ExtractScanPredicates(condition, columns, predicates, all_pushed);
+  std::map<size_t, std::vector<ScanPredicate>> by_column;
+  for (auto &pred : predicates) {
+    if (pred.op != FunctionComparison::Operator::NotEquals) {
+      by_column[pred.column_idx].push_back(pred);
+    }
+  }
+
+  size_t best_column = 0;
+  size_t best_matches = 0;
+  bool found = false;
+  for (auto &[column_idx, preds] : by_column) {
+    size_t matches = 0;
+    size_t total = 0;
+    // 数据全在 memtable 时索引为空，直接扫描即可
+    if (!lsm_tree->EstimateIndexMatches(column_idx, preds, matches, total) ||
+        total == 0 ||
+        static_cast<double>(matches) >
+            INDEX_SCAN_MAX_SELECTIVITY * static_cast<double>(total)) {
+      continue;
+    }
+    if (!found || matches < best_matches) {
+      best_column = column_idx;
+      best_matches = matches;
+      found = true;
+    }
+  }
+  if (!found) {
+    return nullptr;
+  }
+  return std::make_shared<IndexScanPlanNode>(std::make_shared<Schema>(),
+                                             lsm_tree, best_column,
+                                             std::move(by_column[best_column]),
+                                             columns);
+}
+
+// SELECT 列表只有单表列上的 COUNT / SUM / MIN / MAX 且 WHERE 条件可完全下推时，
+// 返回用 RowGroup 预聚合回答的计划，fallback 为内存中还有数据时执行的原计划
+static AbstractPlanNodeRef
+PlanAggregation(SelectStatement &statement,
+                const std::shared_ptr<LSMTree> &lsm_tree,
+                AbstractPlanNodeRef fallback) {
+  if (statement.columns_.empty()) {
+    return nullptr;
+  }
+  const auto &table = statement.from_[0];
+  auto column_index = [&](BoundColumnMeta *col, uint32_t &idx) {
+    if (col->GetTableMeta().get() != table.get()) {
+      return false;
+    }
+    idx = 0;
+    for (auto &col_meta : table->GetColumns()) {
+      if (col_meta->name_ == col->GetColumnMeta()->name_) {
+        return true;
+      }
+      idx++;
+    }
+    return false;
+  };
+
+  std::vector<AggregateExpr> aggregates;
+  for (auto &expr : statement.columns_) {
+    if (expr->expr_type_ != BoundExpressType::BoundFunction) {
+      return nullptr;
+    }
+    auto &func = static_cast<BoundFunction &>(*expr);
+    auto name = func.GetFunction()->GetName();
+    auto args = func.GetArguments();
+    if ((name != "COUNT" && name != "SUM" && name != "MIN" && name != "MAX") ||
+        args.size() != 1 ||
+        args[0]->expr_type_ != BoundExpressType::BoundColumnMeta) {
+      return nullptr;
+    }
+    auto *col = static_cast<BoundColumnMeta *>(args[0].get());
+    uint32_t idx = 0;
+    if (!column_index(col, idx)) {
+      return nullptr;
+    }
+    auto type = col->GetColumnMeta()->type_->GetType();
+    if (name != "COUNT" && type != ValueType::Type::Int &&
+        type != ValueType::Type::Double) {
+      return nullptr;
+    }
+    aggregates.push_back({name, col->GetColumnMeta(), idx});
+  }
+
+  std::vector<ScanPredicate> predicates;
+  if (statement.where_condition_) {
+    std::set<BoundColumnMeta *> where_cols;
+    CollectColumns(statement.where_condition_, where_cols);
+    std::vector<FilterColumnScan> columns;
+    for (auto *col : where_cols) {
+      uint32_t idx = 0;
+      if (!column_index(col, idx)) {
+        return nullptr;
+      }
+      columns.push_back({col->GetColumnMeta(), lsm_tree, idx});
+    }
+    bool all_pushed = true;
+    ExtractScanPredicates(statement.where_condition_, columns, predicates,
+                          all_pushed);
+    if (!all_pushed) {
+      return nullptr;
+    }
+  }
+  return std::make_shared<AggregationPlanNode>(
+      std::make_shared<Schema>(), std::move(fallback), lsm_tree,
+      std::move(aggregates), std::move(predicates));
+}
+
 Status Planner::PlanSelect(SelectStatement &satement) {
   // 子查询透传：直接规划内层 statement，外层 select * 不做额外处理
   if (satement.subquery_) {
@@ -112,18 +243,32 @@ Status Planner::PlanSelect(SelectStatement &satement) {
       }
     }
 
+    AbstractPlanNodeRef index_scan;
+    if (satement.from_.size() == 1 && !range_table_) {
+      index_scan = PlanIndexScan(satement.where_condition_, filter_columns);
+    }
+
     auto projection = std::make_shared<ProjectionPlanNode>(
         std::make_shared<Schema>(), std::move(columns));
     std::vector<AbstractPlanNodeRef> filter_children;
     filter_children.push_back(projection);
     plan_ = std::make_shared<FilterPlanNode>(
         std::make_shared<Schema>(), std::move(filter_children),
-        satement.where_condition_, std::move(filter_columns));
+        satement.where_condition_, std::move(filter_columns),
+        std::move(index_scan));
   } else {
     // normal select
     plan_ = std::make_shared<ProjectionPlanNode>(std::make_shared<Schema>(),
                                                  std::move(columns));
   }
+
+  if (satement.from_.size() == 1 && !range_table_) {
+    auto aggregation = PlanAggregation(
+        satement, context_->GetOrCreateLSMTree(satement.from_[0]), plan_);
+    if (aggregation) {
+      plan_ = std::move(aggregation);
+    }
+  }
   return Status::OK();
 }
 } // namespace DB
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "planner/ScanPredicateExtractor.hpp"
+#include "function/FunctionComparison.hpp"
+#include "function/FunctionLogical.hpp"
+#include "parser/binder/BoundColumnMeta.hpp"
+#include "parser/binder/BoundConstant.hpp"
+#include "parser/binder/BoundFunction.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace DB {
+
+// 翻转比较算子（当常量在左边时）
+static FunctionComparison::Operator
+FlipOperator(FunctionComparison::Operator op) {
+  using Op = FunctionComparison::Operator;
+  switch (op) {
+  case Op::Less: return Op::Greater;
+  case Op::LessOrEquals: return Op::GreaterOrEquals;
+  case Op::Greater: return Op::Less;
+  case Op::GreaterOrEquals: return Op::LessOrEquals;
+  case Op::Equals: return Op::Equals;
+  case Op::NotEquals: return Op::NotEquals;
+  }
+  return op;
+}
+
+void ExtractScanPredicates(const BoundExpressRef &expr,
+                           const std::vector<FilterColumnScan> &columns,
+                           std::vector<ScanPredicate> &pushed,
+                           bool &all_pushed) {
+  if (expr->expr_type_ != BoundExpressType::BoundFunction) {
+    all_pushed = false;
+    return;
+  }
+
+  auto &func_expr = static_cast<BoundFunction &>(*expr);
+  auto func = func_expr.GetFunction();
+  auto args = func_expr.GetArguments();
+
+  // AND: 递归提取两个子表达式
+  auto *logical = dynamic_cast<FunctionLogical *>(func.get());
+  if (logical) {
+    if (logical->GetOperator() == FunctionLogical::Operator::And) {
+      if (args.size() == 2) {
+        ExtractScanPredicates(args[0], columns, pushed, all_pushed);
+        ExtractScanPredicates(args[1], columns, pushed, all_pushed);
+      }
+      return;
+    }
+    // OR 或其他逻辑算子：不下推
+    all_pushed = false;
+    return;
+  }
+
+  // 比较算子: column <op> constant
+  auto *cmp = dynamic_cast<FunctionComparison *>(func.get());
+  if (!cmp || args.size() != 2) {
+    all_pushed = false;
+    return;
+  }
+
+  // 识别 column 和 constant 参数
+  BoundColumnMeta *col_arg = nullptr;
+  BoundConstant *const_arg = nullptr;
+  bool const_on_left = false;
+
+  if (args[0]->expr_type_ == BoundExpressType::BoundColumnMeta &&
+      args[1]->expr_type_ == BoundExpressType::BoundConstant) {
+    col_arg = static_cast<BoundColumnMeta *>(args[0].get());
+    const_arg = static_cast<BoundConstant *>(args[1].get());
+  } else if (args[0]->expr_type_ == BoundExpressType::BoundConstant &&
+             args[1]->expr_type_ == BoundExpressType::BoundColumnMeta) {
+    col_arg = static_cast<BoundColumnMeta *>(args[1].get());
+    const_arg = static_cast<BoundConstant *>(args[0].get());
+    const_on_left = true;
+  } else {
+    all_pushed = false;
+    return;
+  }
+
+  // 在 condition_columns_ 中查找该列的 column_idx
+  auto col_name = col_arg->GetColumnMeta()->name_;
+  size_t found_col_idx = SIZE_MAX;
+  ValueType::Type col_type = ValueType::Type::Null;
+  for (const auto &cs : columns) {
+    if (cs.column_meta->name_ == col_name) {
+      found_col_idx = cs.column_idx;
+      col_type = cs.column_meta->type_->GetType();
+      break;
+    }
+  }
+
+  if (found_col_idx == SIZE_MAX) {
+    all_pushed = false;
+    return;
+  }
+
+  auto op = cmp->GetOperator();
+  if (const_on_left) {
+    op = FlipOperator(op);
+  }
+
+  ScanPredicate pred;
+  pred.column_idx = found_col_idx;
+  pred.column_type = col_type;
+  pred.op = op;
+
+  // 常量按列类型存放：double 列可接受 int 常量，其余类型必须一致
+  auto const_type = const_arg->type_->GetType();
+  if (col_type == ValueType::Type::Double &&
+      const_type == ValueType::Type::Int) {
+    pred.const_double = const_arg->value_.i32;
+  } else if (col_type != const_type) {
+    all_pushed = false;
+    return;
+  } else {
+    switch (const_type) {
+    case ValueType::Type::Int: pred.const_int = const_arg->value_.i32; break;
+    case ValueType::Type::Double:
+      pred.const_double = const_arg->value_.f64;
+      break;
+    case ValueType::Type::String:
+      pred.const_string =
+          std::string(const_arg->value_.str, const_arg->size_);
+      break;
+    default: all_pushed = false; return;
+    }
+  }
+
+  pushed.push_back(std::move(pred));
+}
+} // namespace DB
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "parser/binder/BoundExpress.hpp"
+#include "planner/FilterPlanNode.hpp"
+#include "storage/lsmtree/ScanPredicate.hpp"
+
+#include <vector>
+
+namespace DB {
+// 从 WHERE 条件中提取可下推的简单谓词（column <op> constant）
+// 只沿 AND 向下提取；遇到 OR、非简单比较或常量与列类型不兼容时 all_pushed 置
+// false，已提取的谓词仍是整个条件的必要条件
+void ExtractScanPredicates(const BoundExpressRef &expr,
+                           const std::vector<FilterColumnScan> &columns,
+                           std::vector<ScanPredicate> &pushed,
+                           bool &all_pushed);
+} // namespace DB
@@ -18,16 +18,19 @@ public:
   // 预分配空间
   void Reserve(size_t n) { offset_.reserve(n + 1); }
 
-  void Insert(std::string &&v) {
-    if (v.size() > max_element_size_) {
-      max_element_size_ = v.size();
+  void Insert(std::string &&v) { InsertRaw(v.data(), v.size()); }
+
+  // 直接追加原始字节，避免构造临时 string
+  void InsertRaw(const char *v, size_t len) {
+    if (len > max_element_size_) {
+      max_element_size_ = len;
     }
 
     offset_.push_back(static_cast<uint32_t>(data_.size()));
-    if (v.size() + data_.size() > data_.capacity()) {
-      data_.reserve((data_.size() + v.size()) << 1);
+    if (len + data_.size() > data_.capacity()) {
+      data_.reserve((data_.size() + len) << 1);
     }
-    data_.append(v);
+    data_.append(v, len);
   }
 
   // 批量设置（直接接管 offset 和 data）
@@ -2,7 +2,9 @@
 
 #include "storage/column/Column.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -15,6 +17,30 @@ public:
     const T *ptr;
     size_t count;
     std::shared_ptr<void> ref; // 持有 MMapFile 引用，防止释放
+    // run-length span：ptr 为各 run 的值，run_ends[r] 为第 r 个 run 的
+    // 结束行（不含），count 为展开后的行数
+    const uint32_t *run_ends = nullptr;
+    size_t runs = 0;
+
+    // 第 idx 行的值
+    T At(size_t idx) const {
+      if (!run_ends) {
+        return ptr[idx];
+      }
+      return ptr[std::upper_bound(run_ends, run_ends + runs, idx) - run_ends];
+    }
+
+    // run-length span 的和，每个 run 只做一次乘加
+    double RunSum() const {
+      double sum = 0.0;
+      size_t begin = 0;
+      for (size_t r = 0; r < runs; r++) {
+        sum += static_cast<double>(ptr[r]) *
+               static_cast<double>(run_ends[r] - begin);
+        begin = run_ends[r];
+      }
+      return sum;
+    }
   };
 
   ColumnVector() = default;
@@ -35,6 +61,17 @@ public:
     total_span_rows_ += count;
   }
 
+  // 添加 run-length span，展开后共 run_ends[runs - 1] 行
+  void AddRunSpan(const T *values, const uint32_t *run_ends, size_t runs,
+                  std::shared_ptr<void> ref) {
+    if (runs == 0) {
+      return;
+    }
+    size_t count = run_ends[runs - 1];
+    spans_.push_back({values, count, std::move(ref), run_ends, runs});
+    total_span_rows_ += count;
+  }
+
   bool HasSpans() const { return !spans_.empty(); }
   const std::vector<DataSpan> &Spans() const { return spans_; }
 
@@ -49,7 +86,7 @@ public:
     size_t span_idx = idx - owned;
     for (const auto &s : spans_) {
       if (span_idx < s.count) {
-        return std::to_string(s.ptr[span_idx]);
+        return std::to_string(s.At(span_idx));
       }
       span_idx -= s.count;
     }
@@ -87,7 +124,15 @@ public:
       return;
     data_.reserve(data_.size() + total_span_rows_);
     for (const auto &s : spans_) {
-      data_.insert(data_.end(), s.ptr, s.ptr + s.count);
+      if (!s.run_ends) {
+        data_.insert(data_.end(), s.ptr, s.ptr + s.count);
+        continue;
+      }
+      size_t begin = 0;
+      for (size_t r = 0; r < s.runs; r++) {
+        data_.insert(data_.end(), s.run_ends[r] - begin, s.ptr[r]);
+        begin = s.run_ends[r];
+      }
     }
     spans_.clear();
     total_span_rows_ = 0;
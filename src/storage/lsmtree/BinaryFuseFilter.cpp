@@ -0,0 +1,299 @@
+#include "storage/lsmtree/BinaryFuseFilter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace DB {
+
+static constexpr int kFuseArity = 3;
+static constexpr int kFuseMaxIterations = 100;
+
+static uint64_t Murmur64(uint64_t h) {
+  h ^= h >> 33;
+  h *= UINT64_C(0xff51afd7ed558ccd);
+  h ^= h >> 33;
+  h *= UINT64_C(0xc4ceb9fe1a85ec53);
+  h ^= h >> 33;
+  return h;
+}
+
+static uint64_t SplitMix64(uint64_t &state) {
+  uint64_t z = (state += UINT64_C(0x9E3779B97F4A7C15));
+  z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+  z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+  return z ^ (z >> 31);
+}
+
+static uint64_t MulHi(uint64_t a, uint64_t b) {
+  return static_cast<uint64_t>((static_cast<__uint128_t>(a) * b) >> 64);
+}
+
+static uint8_t Fingerprint(uint64_t hash) {
+  return static_cast<uint8_t>(hash ^ (hash >> 32));
+}
+
+// 段参数，构建和查询共用
+struct FuseLayout {
+  uint32_t segment_length;
+  uint32_t segment_length_mask;
+  uint32_t segment_count_length;
+
+  // 第 index 个位置：index 0/1/2 分别落在相邻的三个段
+  uint32_t Position(int index, uint64_t hash) const {
+    uint64_t h = MulHi(hash, segment_count_length);
+    h += static_cast<uint64_t>(index) * segment_length;
+    uint64_t hh = hash & ((UINT64_C(1) << 36) - 1);
+    h ^= (hh >> (36 - 18 * index)) & segment_length_mask;
+    return static_cast<uint32_t>(h);
+  }
+};
+
+bool BinaryFuseFilter::Reset(std::string_view data) {
+  fingerprints_ = nullptr;
+  if (data.size() < kHeaderSize) {
+    return false;
+  }
+  uint32_t segment_count = 0;
+  const char *p = data.data();
+  std::memcpy(&seed_, p, sizeof(seed_));
+  p += sizeof(seed_);
+  std::memcpy(&segment_length_, p, sizeof(segment_length_));
+  p += sizeof(segment_length_);
+  std::memcpy(&segment_count, p, sizeof(segment_count));
+  p += sizeof(segment_count);
+  std::memcpy(&array_length_, p, sizeof(array_length_));
+  p += sizeof(array_length_);
+  // segment_length 为 2 的幂，三个位置都需落在数组内
+  if (segment_length_ == 0 || (segment_length_ & (segment_length_ - 1)) != 0 ||
+      data.size() - kHeaderSize != array_length_ ||
+      static_cast<uint64_t>(segment_count + kFuseArity - 1) * segment_length_ >
+          array_length_) {
+    return false;
+  }
+  segment_length_mask_ = segment_length_ - 1;
+  segment_count_length_ = segment_count * segment_length_;
+  fingerprints_ = reinterpret_cast<const uint8_t *>(p);
+  return true;
+}
+
+bool BinaryFuseFilter::MayContainHash(uint64_t hash) const {
+  if (!Valid()) {
+    return false;
+  }
+  uint64_t h = Murmur64(hash + seed_);
+  FuseLayout layout{segment_length_, segment_length_mask_,
+                    segment_count_length_};
+  uint8_t f = Fingerprint(h);
+  f ^= fingerprints_[layout.Position(0, h)] ^
+       fingerprints_[layout.Position(1, h)] ^
+       fingerprints_[layout.Position(2, h)];
+  return f == 0;
+}
+
+void BinaryFuseFilter::MayContainBatch(const uint64_t *hashes, size_t count,
+                                       uint64_t *out_bitmap) const {
+  std::memset(out_bitmap, 0, ((count + 63) / 64) * sizeof(uint64_t));
+  if (!Valid()) {
+    return;
+  }
+  constexpr size_t kPrefetchDistance = 8;
+  FuseLayout layout{segment_length_, segment_length_mask_,
+                    segment_count_length_};
+  for (size_t i = 0; i < count; i++) {
+    if (i + kPrefetchDistance < count) {
+      uint64_t next = Murmur64(hashes[i + kPrefetchDistance] + seed_);
+      __builtin_prefetch(fingerprints_ + layout.Position(0, next));
+      __builtin_prefetch(fingerprints_ + layout.Position(2, next));
+    }
+    if (MayContainHash(hashes[i])) {
+      out_bitmap[i / 64] |= uint64_t{1} << (i % 64);
+    }
+  }
+}
+
+bool BinaryFuseFilter::Build(const uint64_t *hashes, size_t count,
+                             std::string &out) {
+  std::vector<uint64_t> keys(hashes, hashes + count);
+  auto size = static_cast<uint32_t>(keys.size());
+
+  // 段长与容量系数取自 binary fuse 论文推荐值
+  uint32_t segment_length =
+      size == 0 ? 4
+                : uint32_t{1} << static_cast<int>(std::floor(
+                      std::log(static_cast<double>(size)) / std::log(3.33) +
+                      2.25));
+  segment_length = std::min<uint32_t>(segment_length, 262144);
+  double size_factor =
+      size <= 1 ? 0
+                : std::max(1.125, 0.875 + 0.25 * std::log(1000000.0) /
+                                              std::log(static_cast<double>(size)));
+  auto capacity =
+      size <= 1 ? 0 : static_cast<uint32_t>(std::round(size * size_factor));
+  // 无符号回绕与参考实现一致：小集合最终得到 1 个段
+  uint32_t init_segment_count =
+      (capacity + segment_length - 1) / segment_length - (kFuseArity - 1);
+  uint32_t array_length =
+      (init_segment_count + kFuseArity - 1) * segment_length;
+  uint32_t segment_count = (array_length + segment_length - 1) / segment_length;
+  segment_count = segment_count <= kFuseArity - 1
+                      ? 1
+                      : segment_count - (kFuseArity - 1);
+  array_length = (segment_count + kFuseArity - 1) * segment_length;
+  FuseLayout layout{segment_length, segment_length - 1,
+                    segment_count * segment_length};
+
+  uint64_t rng = UINT64_C(0x726b2b9d438b9d4d);
+  uint64_t seed = SplitMix64(rng);
+  std::vector<uint64_t> reverse_order(size + 1, 0);
+  std::vector<uint8_t> reverse_h(size);
+  std::vector<uint32_t> alone(array_length);
+  std::vector<uint8_t> t2count(array_length, 0);
+  std::vector<uint64_t> t2hash(array_length, 0);
+  uint32_t block_bits = 1;
+  while ((uint32_t{1} << block_bits) < segment_count) {
+    block_bits++;
+  }
+  uint32_t block = uint32_t{1} << block_bits;
+  std::vector<uint32_t> start_pos(block);
+  auto mod3 = [](uint8_t x) { return x > 2 ? x - 3 : x; };
+
+  auto reset = [&]() {
+    std::fill(reverse_order.begin(), reverse_order.begin() + size, 0);
+    std::fill(t2count.begin(), t2count.end(), 0);
+    std::fill(t2hash.begin(), t2hash.end(), 0);
+    seed = SplitMix64(rng);
+  };
+
+  reverse_order[size] = 1;
+  for (int loop = 0;; loop++) {
+    if (loop + 1 > kFuseMaxIterations) {
+      return false;
+    }
+    // 按 hash 高位分桶排序，使相邻 key 落在相邻段，提升构建局部性
+    for (uint32_t i = 0; i < block; i++) {
+      start_pos[i] = static_cast<uint32_t>(
+          (static_cast<uint64_t>(i) * size) >> block_bits);
+    }
+    uint64_t mask_block = block - 1;
+    for (uint32_t i = 0; i < size; i++) {
+      uint64_t hash = Murmur64(keys[i] + seed);
+      uint64_t segment_index = hash >> (64 - block_bits);
+      while (reverse_order[start_pos[segment_index]] != 0) {
+        segment_index = (segment_index + 1) & mask_block;
+      }
+      reverse_order[start_pos[segment_index]] = hash;
+      start_pos[segment_index]++;
+    }
+
+    bool error = false;
+    uint32_t duplicates = 0;
+    for (uint32_t i = 0; i < size; i++) {
+      uint64_t hash = reverse_order[i];
+      uint32_t h0 = layout.Position(0, hash);
+      uint32_t h1 = layout.Position(1, hash);
+      uint32_t h2 = layout.Position(2, hash);
+      t2count[h0] += 4;
+      t2hash[h0] ^= hash;
+      t2count[h1] += 4;
+      t2count[h1] ^= 1;
+      t2hash[h1] ^= hash;
+      t2count[h2] += 4;
+      t2count[h2] ^= 2;
+      t2hash[h2] ^= hash;
+      // 同一 hash 出现两次时三个位置互相抵消，撤销后按重复计
+      if ((t2hash[h0] & t2hash[h1] & t2hash[h2]) == 0 &&
+          ((t2hash[h0] == 0 && t2count[h0] == 8) ||
+           (t2hash[h1] == 0 && t2count[h1] == 8) ||
+           (t2hash[h2] == 0 && t2count[h2] == 8))) {
+        duplicates++;
+        t2count[h0] -= 4;
+        t2hash[h0] ^= hash;
+        t2count[h1] -= 4;
+        t2count[h1] ^= 1;
+        t2hash[h1] ^= hash;
+        t2count[h2] -= 4;
+        t2count[h2] ^= 2;
+        t2hash[h2] ^= hash;
+      }
+      error = error || t2count[h0] < 4 || t2count[h1] < 4 || t2count[h2] < 4;
+    }
+    if (error) {
+      reset();
+      continue;
+    }
+
+    // 剥离：反复取出只被一个 key 占用的位置
+    uint32_t queue_size = 0;
+    for (uint32_t i = 0; i < array_length; i++) {
+      alone[queue_size] = i;
+      queue_size += (t2count[i] >> 2) == 1 ? 1 : 0;
+    }
+    uint32_t stack_size = 0;
+    while (queue_size > 0) {
+      queue_size--;
+      uint32_t index = alone[queue_size];
+      if ((t2count[index] >> 2) != 1) {
+        continue;
+      }
+      uint64_t hash = t2hash[index];
+      uint32_t h012[5];
+      h012[0] = layout.Position(0, hash);
+      h012[1] = layout.Position(1, hash);
+      h012[2] = layout.Position(2, hash);
+      h012[3] = h012[0];
+      h012[4] = h012[1];
+      uint8_t found = t2count[index] & 3;
+      reverse_h[stack_size] = found;
+      reverse_order[stack_size] = hash;
+      stack_size++;
+      for (int k = 1; k <= 2; k++) {
+        uint32_t other = h012[found + k];
+        alone[queue_size] = other;
+        queue_size += (t2count[other] >> 2) == 2 ? 1 : 0;
+        t2count[other] -= 4;
+        t2count[other] ^= mod3(static_cast<uint8_t>(found + k));
+        t2hash[other] ^= hash;
+      }
+    }
+    if (stack_size + duplicates == size) {
+      size = stack_size;
+      break;
+    }
+    if (duplicates > 0) {
+      std::sort(keys.begin(), keys.end());
+      keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+      size = static_cast<uint32_t>(keys.size());
+      reverse_order[size] = 1;
+    }
+    reset();
+  }
+
+  std::vector<uint8_t> fingerprints(array_length, 0);
+  for (uint32_t i = size; i-- > 0;) {
+    uint64_t hash = reverse_order[i];
+    uint8_t found = reverse_h[i];
+    uint32_t h012[5];
+    h012[0] = layout.Position(0, hash);
+    h012[1] = layout.Position(1, hash);
+    h012[2] = layout.Position(2, hash);
+    h012[3] = h012[0];
+    h012[4] = h012[1];
+    fingerprints[h012[found]] =
+        static_cast<uint8_t>(Fingerprint(hash) ^ fingerprints[h012[found + 1]] ^
+                             fingerprints[h012[found + 2]]);
+  }
+
+  auto append = [&](const auto &v) {
+    out.append(reinterpret_cast<const char *>(&v), sizeof(v));
+  };
+  append(seed);
+  append(segment_length);
+  append(segment_count);
+  append(array_length);
+  out.append(reinterpret_cast<const char *>(fingerprints.data()),
+             fingerprints.size());
+  return true;
+}
+} // namespace DB
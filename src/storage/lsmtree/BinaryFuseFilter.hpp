@@ -0,0 +1,48 @@
+#pragma once
+
+#include "common/Config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace DB {
+// 3-wise binary fuse filter，8 bit 指纹（约 9 bit/key，误判率约 0.39%）
+// key 先映射为 64 位 hash，查询时只读 3 个相邻段内的字节
+//
+// 序列化格式:
+//   seed (u64) + segment_length (u32) + segment_count (u32) +
+//   array_length (u32) + fingerprints[array_length] (u8)
+class BinaryFuseFilter {
+  static constexpr size_t kHeaderSize =
+      sizeof(uint64_t) + sizeof(uint32_t) * 3;
+
+  uint64_t seed_{0};
+  uint32_t segment_length_{0};
+  uint32_t segment_length_mask_{0};
+  uint32_t segment_count_length_{0};
+  uint32_t array_length_{0};
+  const uint8_t *fingerprints_{nullptr};
+
+public:
+  BinaryFuseFilter() = default;
+
+  explicit BinaryFuseFilter(std::string_view data) { Reset(data); }
+
+  // 解析失败时过滤器无效，MayContainHash 返回 false
+  bool Reset(std::string_view data);
+
+  bool Valid() const { return fingerprints_ != nullptr; }
+
+  bool MayContainHash(uint64_t hash) const;
+
+  // 与 BloomFilter::MayContainBatch 相同的 bitmap 约定，预取后续 key 的指纹
+  void MayContainBatch(const uint64_t *hashes, size_t count,
+                       uint64_t *out_bitmap) const;
+
+  // 由 key hash 构建过滤器并追加到 out，重复 hash 会被去重
+  // 构建失败（多次换 seed 仍无法剥离）时返回 false，out 不变
+  static bool Build(const uint64_t *hashes, size_t count, std::string &out);
+};
+} // namespace DB
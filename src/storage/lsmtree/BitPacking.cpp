@@ -0,0 +1,262 @@
+#include "storage/lsmtree/BitPacking.hpp"
+#include "common/CpuFeature.hpp"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace DB {
+static constexpr uint32_t kLaneValues = kBitPackBlockSize / kBitPackLanes;
+
+static uint32_t BitWidth(uint64_t v) {
+  return v == 0 ? 0 : 64 - static_cast<uint32_t>(__builtin_clzll(v));
+}
+
+static uint32_t WidthMask(uint32_t width) {
+  return width == 32 ? ~0u : (1u << width) - 1;
+}
+
+static size_t PayloadSize(uint32_t width) {
+  return static_cast<size_t>(width) * kLaneValues / 8 * kBitPackLanes;
+}
+
+static bool FitsInt(int64_t v) {
+  return v >= std::numeric_limits<int>::min() &&
+         v <= std::numeric_limits<int>::max();
+}
+
+// 把一块 (kBitPackBlockSize 个) 无符号值按 lane 交错打包
+static void PackBlock(const uint32_t *in, uint32_t width, uint32_t *words) {
+  for (uint32_t p = 0; p < kLaneValues; p++) {
+    uint32_t bit = p * width;
+    uint32_t k = bit / 32;
+    uint32_t shift = bit % 32;
+    for (uint32_t lane = 0; lane < kBitPackLanes; lane++) {
+      uint32_t v = in[p * kBitPackLanes + lane];
+      words[k * kBitPackLanes + lane] |= v << shift;
+      if (shift + width > 32) {
+        words[(k + 1) * kBitPackLanes + lane] |= v >> (32 - shift);
+      }
+    }
+  }
+}
+
+static void UnpackBlockScalar(const Byte *payload, uint32_t width,
+                              uint32_t *out) {
+  auto word = [&](uint32_t idx) {
+    uint32_t w = 0;
+    std::memcpy(&w, payload + idx * sizeof(uint32_t), sizeof(w));
+    return w;
+  };
+  const uint32_t mask = WidthMask(width);
+  for (uint32_t p = 0; p < kLaneValues; p++) {
+    uint32_t bit = p * width;
+    uint32_t k = bit / 32;
+    uint32_t shift = bit % 32;
+    for (uint32_t lane = 0; lane < kBitPackLanes; lane++) {
+      uint32_t v = word(k * kBitPackLanes + lane) >> shift;
+      if (shift + width > 32) {
+        v |= word((k + 1) * kBitPackLanes + lane) << (32 - shift);
+      }
+      out[p * kBitPackLanes + lane] = v & mask;
+    }
+  }
+}
+
+// 8 条 lane 同时移位取值，每轮输出连续 8 个值
+[[gnu::target("avx2")]]
+static void UnpackBlockAVX2(const Byte *payload, uint32_t width,
+                            uint32_t *out) {
+  const __m256i mask = _mm256_set1_epi32(static_cast<int>(WidthMask(width)));
+  const auto *words = reinterpret_cast<const __m256i *>(payload);
+  for (uint32_t p = 0; p < kLaneValues; p++) {
+    uint32_t bit = p * width;
+    uint32_t k = bit / 32;
+    uint32_t shift = bit % 32;
+    __m256i v =
+        _mm256_srl_epi32(_mm256_loadu_si256(words + k),
+                         _mm_cvtsi32_si128(static_cast<int>(shift)));
+    if (shift + width > 32) {
+      __m256i hi = _mm256_sll_epi32(
+          _mm256_loadu_si256(words + k + 1),
+          _mm_cvtsi32_si128(static_cast<int>(32 - shift)));
+      v = _mm256_or_si256(v, hi);
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + p * kBitPackLanes),
+                        _mm256_and_si256(v, mask));
+  }
+}
+
+// 给定 stride 时块内残差的最小值与跨度（int64，不会溢出）
+static void Residuals(const int *block, uint32_t rows, int64_t stride,
+                      int64_t &min, uint64_t &span) {
+  min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  for (uint32_t i = 0; i < rows; i++) {
+    int64_t r = int64_t{block[i]} - int64_t{i} * stride;
+    min = std::min(min, r);
+    max = std::max(max, r);
+  }
+  span = static_cast<uint64_t>(max - min);
+}
+
+void BitPackEncode(const int *values, uint32_t count, std::string &out) {
+  uint32_t blocks = (count + kBitPackBlockSize - 1) / kBitPackBlockSize;
+  size_t header_pos = out.size();
+  out.resize(header_pos + blocks * kBitPackHeaderSize);
+  std::string payload;
+  std::vector<uint32_t> packed(kBitPackBlockSize);
+  std::vector<uint32_t> words;
+  for (uint32_t b = 0; b < blocks; b++) {
+    uint32_t begin = b * kBitPackBlockSize;
+    uint32_t rows = std::min(kBitPackBlockSize, count - begin);
+    const int *block = values + begin;
+
+    // stride = 0 即普通 FOR；首尾连线的斜率能让有序列的残差接近 0
+    int64_t stride = 0;
+    int64_t min = 0;
+    uint64_t span = 0;
+    Residuals(block, rows, 0, min, span);
+    if (rows > 1) {
+      int64_t slope = std::llround(
+          static_cast<double>(int64_t{block[rows - 1]} - block[0]) /
+          (rows - 1));
+      int64_t slope_min = 0;
+      uint64_t slope_span = 0;
+      if (slope != 0 && FitsInt(slope)) {
+        Residuals(block, rows, slope, slope_min, slope_span);
+        if (slope_span < span && FitsInt(slope_min)) {
+          stride = slope;
+          min = slope_min;
+          span = slope_span;
+        }
+      }
+    }
+    uint32_t width = BitWidth(span);
+
+    auto reference = static_cast<int>(min);
+    std::fill(packed.begin(), packed.end(), 0);
+    for (uint32_t i = 0; i < rows; i++) {
+      packed[i] = static_cast<uint32_t>(int64_t{block[i]} -
+                                        int64_t{i} * stride - min);
+    }
+    auto offset = static_cast<uint32_t>(payload.size());
+    if (width > 0) {
+      words.assign(PayloadSize(width) / sizeof(uint32_t), 0);
+      PackBlock(packed.data(), width, words.data());
+      payload.append(reinterpret_cast<const char *>(words.data()),
+                     words.size() * sizeof(uint32_t));
+    }
+    char *header = out.data() + header_pos + b * kBitPackHeaderSize;
+    auto stride32 = static_cast<int>(stride);
+    auto width_byte = static_cast<uint8_t>(width);
+    std::memcpy(header, &reference, sizeof(reference));
+    std::memcpy(header + sizeof(int), &stride32, sizeof(stride32));
+    std::memcpy(header + sizeof(int) * 2, &offset, sizeof(offset));
+    std::memcpy(header + sizeof(int) * 2 + sizeof(uint32_t), &width_byte,
+                sizeof(width_byte));
+  }
+  out.append(payload);
+}
+
+struct BlockHeader {
+  int reference{0};
+  int stride{0};
+  uint32_t width{0};
+  const Byte *payload{nullptr};
+};
+
+static BlockHeader ReadHeader(const Byte *data, uint32_t blocks,
+                              uint32_t block) {
+  const Byte *p = data + block * kBitPackHeaderSize;
+  BlockHeader header;
+  uint32_t offset = 0;
+  uint8_t width = 0;
+  std::memcpy(&header.reference, p, sizeof(int));
+  std::memcpy(&header.stride, p + sizeof(int), sizeof(int));
+  std::memcpy(&offset, p + sizeof(int) * 2, sizeof(offset));
+  std::memcpy(&width, p + sizeof(int) * 2 + sizeof(uint32_t), sizeof(width));
+  header.width = width;
+  header.payload = data + blocks * kBitPackHeaderSize + offset;
+  return header;
+}
+
+uint32_t BitPackedView::BlockRows(uint32_t block) const {
+  return std::min(kBitPackBlockSize, count_ - block * kBitPackBlockSize);
+}
+
+void BitPackedView::BlockRange(uint32_t block, int &min, int &max) const {
+  auto header = ReadHeader(data_, BlockCount(), block);
+  int64_t line_end =
+      int64_t{header.stride} * static_cast<int64_t>(BlockRows(block) - 1);
+  int64_t lo = int64_t{header.reference} + std::min<int64_t>(line_end, 0);
+  int64_t hi = int64_t{header.reference} + std::max<int64_t>(line_end, 0) +
+               WidthMask(header.width);
+  // 实际值都在 int 范围内，截断不影响判定
+  min = static_cast<int>(
+      std::max<int64_t>(lo, std::numeric_limits<int>::min()));
+  max = static_cast<int>(
+      std::min<int64_t>(hi, std::numeric_limits<int>::max()));
+}
+
+void BitPackedView::DecodeBlock(uint32_t block, int *out) const {
+  auto header = ReadHeader(data_, BlockCount(), block);
+  auto *raw = reinterpret_cast<uint32_t *>(out);
+  if (header.width == 0) {
+    std::fill(raw, raw + kBitPackBlockSize, 0u);
+  } else if (HasAVX2()) {
+    UnpackBlockAVX2(header.payload, header.width, raw);
+  } else {
+    UnpackBlockScalar(header.payload, header.width, raw);
+  }
+  auto base = static_cast<uint32_t>(header.reference);
+  auto stride = static_cast<uint32_t>(header.stride);
+  for (uint32_t i = 0; i < kBitPackBlockSize; i++) {
+    raw[i] += base + i * stride;
+  }
+}
+
+void BitPackedView::Decode(int *out) const {
+  uint32_t blocks = BlockCount();
+  if (blocks == 0) {
+    return;
+  }
+  // 整块直接解码到 out，最后一块经缓冲区截断
+  for (uint32_t b = 0; b + 1 < blocks; b++) {
+    DecodeBlock(b, out + b * kBitPackBlockSize);
+  }
+  std::array<int, kBitPackBlockSize> tail;
+  DecodeBlock(blocks - 1, tail.data());
+  std::memcpy(out + (blocks - 1) * kBitPackBlockSize, tail.data(),
+              BlockRows(blocks - 1) * sizeof(int));
+}
+
+int BitPackedView::Get(uint32_t row) const {
+  uint32_t j = row % kBitPackBlockSize;
+  auto header = ReadHeader(data_, BlockCount(), row / kBitPackBlockSize);
+  uint32_t v = 0;
+  if (header.width > 0) {
+    uint32_t lane = j % kBitPackLanes;
+    uint32_t bit = j / kBitPackLanes * header.width;
+    uint32_t k = bit / 32;
+    uint32_t shift = bit % 32;
+    auto word = [&](uint32_t idx) {
+      uint32_t w = 0;
+      std::memcpy(&w, header.payload + idx * sizeof(uint32_t), sizeof(w));
+      return w;
+    };
+    v = word(k * kBitPackLanes + lane) >> shift;
+    if (shift + header.width > 32) {
+      v |= word((k + 1) * kBitPackLanes + lane) << (32 - shift);
+    }
+    v &= WidthMask(header.width);
+  }
+  return static_cast<int>(static_cast<uint32_t>(header.reference) +
+                          j * static_cast<uint32_t>(header.stride) + v);
+}
+} // namespace DB
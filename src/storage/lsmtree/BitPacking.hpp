@@ -0,0 +1,61 @@
+#pragma once
+
+#include "common/Config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace DB {
+// clang-format off
+// Int 列的 FOR (frame of reference) + bit-packing 编码
+//
+// 每 kBitPackBlockSize 个值一块，先写全部块头，再写各块 payload:
+//   块头: reference (i32) + stride (i32) + payload_offset (u32, 相对 payload 区) +
+//         bit_width (u8)
+//   第 j 个值 = reference + j * stride + packed[j]（按 u32 回绕计算）
+//   stride 为 0 即普通 FOR；有序列（主键、自增 id、时间戳）按首尾差值取 stride，
+//   只需存储偏离直线的残差，编码时逐块取 bit_width 更小的一种
+//
+// payload 按 8 条 lane 交错：块内第 j 个值属于 lane j % 8 的第 j / 8 个位置，
+// 每条 lane 的 128 个值连续打包成 4 * bit_width 个 u32，lane 之间按字交错，
+// 因此 AVX2 一次 load 8 个字即可解出连续的 8 个值
+// 不足一块的尾部以 0 补齐，bit_width 为 0 时没有 payload
+// clang-format on
+inline constexpr uint32_t kBitPackBlockSize = 1024;
+inline constexpr uint32_t kBitPackLanes = 8;
+inline constexpr size_t kBitPackHeaderSize =
+    sizeof(int) * 2 + sizeof(uint32_t) + sizeof(uint8_t);
+
+// 编码 count 个值并追加到 out
+void BitPackEncode(const int *values, uint32_t count, std::string &out);
+
+// 已编码列数据的只读视图，data 指向 null bitmap 之后
+class BitPackedView {
+  const Byte *data_;
+  uint32_t count_;
+
+public:
+  BitPackedView(const Byte *data, uint32_t count)
+      : data_(data), count_(count) {}
+
+  uint32_t BlockCount() const {
+    return (count_ + kBitPackBlockSize - 1) / kBitPackBlockSize;
+  }
+
+  // 第 block 块的行数（最后一块可能不满）
+  uint32_t BlockRows(uint32_t block) const;
+
+  // 第 block 块取值的上下界，只读块头
+  void BlockRange(uint32_t block, int &min, int &max) const;
+
+  // 解码第 block 块，out 需有 kBitPackBlockSize 个空间
+  void DecodeBlock(uint32_t block, int *out) const;
+
+  // 解码全部 count 个值
+  void Decode(int *out) const;
+
+  // 单值随机访问
+  int Get(uint32_t row) const;
+};
+} // namespace DB
@@ -63,6 +63,13 @@ public:
     Reset(reinterpret_cast<const Byte *>(data.data()), data.size());
   }
 
+  // 与 MayContain 相同的 key hash，批量探测前先算好
+  static uint64_t HashKey(const Byte *key, size_t size) {
+    static const Byte kEmpty = 0;
+    const Byte *data = key ? key : &kEmpty;
+    return Hash64(static_cast<const void *>(data), size);
+  }
+
   bool MayContain(const Slice &key) const {
     return MayContain(key.GetData(), key.Size());
   }
@@ -75,9 +82,17 @@ public:
       return false;
     }
 
-    static const Byte kEmpty = 0;
-    const Byte *data = key ? key : &kEmpty;
-    return MayContainHash(Hash64(static_cast<const void *>(data), size));
+    return MayContainHash(HashKey(key, size));
+  }
+
+  // hash 需由 HashKey 计算
+  bool MayContainKeyHash(uint64_t hash) const {
+    return IsValid() && MayContainHash(hash);
   }
+
+  // 批量探测：out_bitmap 第 i 位为 1 表示 hashes[i] 可能存在
+  // out_bitmap 需有 (count + 63) / 64 个字，AVX2 下每个 key 一次算出全部探测位
+  void MayContainBatch(const uint64_t *hashes, size_t count,
+                       uint64_t *out_bitmap) const;
 };
 } // namespace DB
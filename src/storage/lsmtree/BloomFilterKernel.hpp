@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace DB {
+// blocked bloom 的探测位计算，BloomFilter 与 BloomFilterBuilder 共用
+// key 的 hash 高 32 位选 block，低 32 位 h 生成 7 个探测位：
+// 第 i 位为 (h + i * delta) & 511，delta = rotr(h, 17)
+inline constexpr size_t kBloomNumProbes = 7;
+inline constexpr size_t kBloomBlockBytes = 64;
+
+// 一次算出 7 个探测位：word 为所在 uint32 字号（0..15），bit 为字内掩码
+// 第 8 条 lane 不使用，其 bit 为 0
+[[gnu::target("avx2")]]
+inline void BloomProbeLanesAVX2(uint32_t h, __m256i &word, __m256i &bit) {
+  const uint32_t delta = (h >> 17) | (h << 15);
+  const __m256i step = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  __m256i pos = _mm256_add_epi32(
+      _mm256_set1_epi32(static_cast<int>(h)),
+      _mm256_mullo_epi32(step, _mm256_set1_epi32(static_cast<int>(delta))));
+  pos = _mm256_and_si256(pos, _mm256_set1_epi32(511));
+  word = _mm256_srli_epi32(pos, 5);
+  bit = _mm256_sllv_epi32(_mm256_set1_epi32(1),
+                          _mm256_and_si256(pos, _mm256_set1_epi32(31)));
+  bit = _mm256_and_si256(bit, _mm256_setr_epi32(-1, -1, -1, -1, -1, -1, -1, 0));
+}
+} // namespace DB
@@ -0,0 +1,127 @@
+#include "storage/lsmtree/ChunkCache.hpp"
+#include "common/Config.hpp"
+#include "common/Hash.hpp"
+
+namespace DB {
+size_t ChunkCache::KeyHash::operator()(const Key &key) const {
+  uint64_t parts[2] = {key.file_id, (uint64_t{key.rowgroup} << 32) |
+                                        (uint64_t{key.column} << 1) |
+                                        static_cast<uint64_t>(key.form)};
+  return Hash64(parts, sizeof(parts));
+}
+
+ChunkCache::ChunkCache(size_t capacity_bytes)
+    : capacity_per_shard_(capacity_bytes / kShardCount) {}
+
+std::shared_ptr<ChunkCache> ChunkCache::Default() {
+  static std::shared_ptr<ChunkCache> cache =
+      CHUNK_CACHE_CAPACITY == 0
+          ? nullptr
+          : std::make_shared<ChunkCache>(CHUNK_CACHE_CAPACITY);
+  return cache;
+}
+
+uint64_t ChunkCache::NewFileId() {
+  static std::atomic<uint64_t> next_id{1};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+ChunkCache::Shard &ChunkCache::GetShard(const Key &key) {
+  return shards_[KeyHash{}(key) % kShardCount];
+}
+
+void ChunkCache::Remove(Shard &shard, std::list<Entry>::iterator it) {
+  if (it->hot) {
+    shard.hot_usage -= it->charge;
+  } else {
+    shard.probation_usage -= it->charge;
+  }
+  shard.index.erase(it->key);
+  (it->hot ? shard.hot : shard.probation).erase(it);
+}
+
+void ChunkCache::EvictIfNeeded(Shard &shard) {
+  // 保护段超限时把最久未用的条目降回试用段头部
+  size_t hot_capacity = capacity_per_shard_ * kProtectedPercent / 100;
+  while (shard.hot_usage > hot_capacity) {
+    auto victim = std::prev(shard.hot.end());
+    victim->hot = false;
+    shard.hot_usage -= victim->charge;
+    shard.probation_usage += victim->charge;
+    shard.probation.splice(shard.probation.begin(), shard.hot, victim);
+  }
+  // 优先淘汰试用段
+  while (shard.probation_usage + shard.hot_usage > capacity_per_shard_) {
+    auto &lru = shard.probation.empty() ? shard.hot : shard.probation;
+    Remove(shard, std::prev(lru.end()));
+  }
+}
+
+ChunkBufferRef ChunkCache::Lookup(const Key &key) {
+  auto &shard = GetShard(key);
+  std::lock_guard lock(shard.mutex);
+  auto it = shard.index.find(key);
+  if (it == shard.index.end()) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  auto entry = it->second;
+  if (entry->hot) {
+    shard.hot.splice(shard.hot.begin(), shard.hot, entry);
+  } else {
+    // 试用段再次命中，晋升到保护段
+    entry->hot = true;
+    shard.probation_usage -= entry->charge;
+    shard.hot_usage += entry->charge;
+    shard.hot.splice(shard.hot.begin(), shard.probation, entry);
+    EvictIfNeeded(shard);
+  }
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  return entry->buffer;
+}
+
+void ChunkCache::Insert(const Key &key, ChunkBufferRef buffer) {
+  if (!buffer) {
+    return;
+  }
+  size_t charge = buffer->capacity() + kEntryOverhead;
+  // 超过分片容量的一半时不缓存，避免一次插入清空整个分片
+  if (charge > capacity_per_shard_ / 2) {
+    return;
+  }
+  auto &shard = GetShard(key);
+  std::lock_guard lock(shard.mutex);
+  auto it = shard.index.find(key);
+  if (it != shard.index.end()) {
+    Remove(shard, it->second);
+  }
+  shard.probation.push_front(Entry{key, std::move(buffer), charge, false});
+  shard.index.emplace(key, shard.probation.begin());
+  shard.probation_usage += charge;
+  EvictIfNeeded(shard);
+}
+
+void ChunkCache::EraseFile(uint64_t file_id) {
+  for (auto &shard : shards_) {
+    std::lock_guard lock(shard.mutex);
+    for (auto *lru : {&shard.probation, &shard.hot}) {
+      for (auto it = lru->begin(); it != lru->end();) {
+        auto next = std::next(it);
+        if (it->key.file_id == file_id) {
+          Remove(shard, it);
+        }
+        it = next;
+      }
+    }
+  }
+}
+
+size_t ChunkCache::Usage() {
+  size_t usage = 0;
+  for (auto &shard : shards_) {
+    std::lock_guard lock(shard.mutex);
+    usage += shard.probation_usage + shard.hot_usage;
+  }
+  return usage;
+}
+} // namespace DB
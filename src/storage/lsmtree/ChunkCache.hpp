@@ -0,0 +1,101 @@
+#pragma once
+
+#include "storage/lsmtree/ChunkCompression.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace DB {
+// 列数据块缓存：按 (SSTable, RowGroup, 列) 缓存解压 / 解码后的缓冲区，
+// 读取方以 span 直接引用缓存的缓冲区，淘汰后由最后一个引用方释放
+// 分片 SLRU，按字节数限制容量：新条目进入试用段，再次命中才晋升到保护段，
+// 一次性的全表扫描只会冲刷试用段，不会挤掉被反复读取的热数据
+class ChunkCache {
+public:
+  // 同一列可缓存的两种形态
+  enum class Form : uint8_t {
+    Decompressed = 0, // 解压后的列数据（含 null bitmap）
+    Values = 1,       // bit-packed / Gorilla 解码后的定长值数组
+  };
+
+  struct Key {
+    uint64_t file_id{0};
+    uint32_t rowgroup{0};
+    uint32_t column{0};
+    Form form{Form::Decompressed};
+
+    bool operator==(const Key &) const = default;
+  };
+
+private:
+  static constexpr size_t kShardCount = 16;
+  // 保护段最多占分片容量的比例（百分比）
+  static constexpr size_t kProtectedPercent = 80;
+  // 每个条目除缓冲区外的近似额外开销
+  static constexpr size_t kEntryOverhead = 64;
+
+  struct KeyHash {
+    size_t operator()(const Key &key) const;
+  };
+
+  struct Entry {
+    Key key;
+    ChunkBufferRef buffer;
+    size_t charge{0};
+    bool hot{false}; // 是否位于保护段
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::list<Entry> probation; // 头部最近使用
+    std::list<Entry> hot;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    size_t probation_usage{0};
+    size_t hot_usage{0};
+  };
+
+  size_t capacity_per_shard_;
+  std::array<Shard, kShardCount> shards_;
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+
+  Shard &GetShard(const Key &key);
+
+  // 调用方需持有 shard.mutex
+  void Remove(Shard &shard, std::list<Entry>::iterator it);
+
+  // 调用方需持有 shard.mutex
+  void EvictIfNeeded(Shard &shard);
+
+public:
+  explicit ChunkCache(size_t capacity_bytes);
+
+  // 进程级共享缓存，容量为 CHUNK_CACHE_CAPACITY，为 0 时返回 nullptr
+  static std::shared_ptr<ChunkCache> Default();
+
+  // 为每个 SSTable 分配进程内唯一 id，作为缓存 key 的一部分
+  static uint64_t NewFileId();
+
+  // 未命中返回 nullptr
+  ChunkBufferRef Lookup(const Key &key);
+
+  void Insert(const Key &key, ChunkBufferRef buffer);
+
+  // 删除某个 SSTable 的全部条目
+  void EraseFile(uint64_t file_id);
+
+  size_t Usage();
+
+  uint64_t Hits() const { return hits_.load(std::memory_order_relaxed); }
+
+  uint64_t Misses() const { return misses_.load(std::memory_order_relaxed); }
+};
+
+using ChunkCacheRef = std::shared_ptr<ChunkCache>;
+} // namespace DB
@@ -0,0 +1,105 @@
+#include "storage/lsmtree/ChunkCompression.hpp"
+
+#include <algorithm>
+#include <lz4.h>
+#include <zstd.h>
+
+namespace DB {
+bool CompressChunk(ColumnCodec codec, const Byte *src, size_t size,
+                   std::string &out) {
+  size_t begin = out.size();
+  switch (codec) {
+  case ColumnCodec::LZ4: {
+    int bound = LZ4_compressBound(static_cast<int>(size));
+    out.resize(begin + bound);
+    int n = LZ4_compress_default(src, out.data() + begin,
+                                 static_cast<int>(size), bound);
+    if (n <= 0) {
+      out.resize(begin);
+      return false;
+    }
+    out.resize(begin + n);
+    return true;
+  }
+  case ColumnCodec::Zstd: {
+    out.resize(begin + ZSTD_compressBound(size));
+    size_t n = ZSTD_compress(out.data() + begin, out.size() - begin, src, size,
+                             COLUMN_ZSTD_LEVEL);
+    if (ZSTD_isError(n)) {
+      out.resize(begin);
+      return false;
+    }
+    out.resize(begin + n);
+    return true;
+  }
+  case ColumnCodec::None: out.append(src, size); return true;
+  }
+  return false;
+}
+
+bool DecompressChunk(ColumnCodec codec, const Byte *src, size_t size,
+                     Byte *dst, size_t raw_size) {
+  switch (codec) {
+  case ColumnCodec::LZ4:
+    return LZ4_decompress_safe(src, dst, static_cast<int>(size),
+                               static_cast<int>(raw_size)) ==
+           static_cast<int>(raw_size);
+  case ColumnCodec::Zstd: {
+    size_t n = ZSTD_decompress(dst, raw_size, src, size);
+    return !ZSTD_isError(n) && n == raw_size;
+  }
+  case ColumnCodec::None:
+    if (size != raw_size) {
+      return false;
+    }
+    std::copy_n(src, size, dst);
+    return true;
+  }
+  return false;
+}
+
+ChunkBufferPool &ChunkBufferPool::Default() {
+  // 不析构：退出时可能仍有 Column 持有缓冲区
+  static auto *pool = new ChunkBufferPool();
+  return *pool;
+}
+
+ChunkBufferRef ChunkBufferPool::Acquire(size_t size) {
+  std::unique_ptr<ChunkBuffer> buffer;
+  {
+    std::lock_guard lock(mutex_);
+    // 优先取容量足够的空闲缓冲区，否则取最后一块扩容
+    auto it = std::find_if(free_.begin(), free_.end(), [&](const auto &b) {
+      return b->capacity() >= size;
+    });
+    if (it == free_.end() && !free_.empty()) {
+      it = free_.end() - 1;
+    }
+    if (it != free_.end()) {
+      buffer = std::move(*it);
+      free_.erase(it);
+      free_bytes_ -= buffer->capacity();
+    }
+  }
+  if (!buffer) {
+    buffer = std::make_unique<ChunkBuffer>();
+  }
+  buffer->resize(size);
+  return {buffer.release(), [this](ChunkBuffer *b) { Release(b); }};
+}
+
+void ChunkBufferPool::Release(ChunkBuffer *buffer) {
+  std::unique_ptr<ChunkBuffer> owned(buffer);
+  std::lock_guard lock(mutex_);
+  if (free_bytes_ + owned->capacity() > CHUNK_BUFFER_POOL_BYTES) {
+    return;
+  }
+  free_bytes_ += owned->capacity();
+  free_.push_back(std::move(owned));
+}
+
+size_t ChunkBufferPool::FreeBytes() {
+  std::lock_guard lock(mutex_);
+  return free_bytes_;
+}
+} // namespace DB
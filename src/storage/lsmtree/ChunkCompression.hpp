@@ -0,0 +1,49 @@
+#pragma once
+
+#include "common/Config.hpp"
+#include "storage/lsmtree/RowGroupMeta.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace DB {
+// 分层压缩策略：L0 / L1 重写频繁，用解压快的 LZ4；
+// 下方不再有数据的底层最冷、占比最大，改用压缩率更高的 Zstd
+inline ColumnCodec ColumnCodecForLevel(uint32_t level, bool bottom_level) {
+  return level > 1 && bottom_level ? ColumnCodec::Zstd : ColumnCodec::LZ4;
+}
+
+// 压缩 size 字节并追加到 out，失败返回 false
+bool CompressChunk(ColumnCodec codec, const Byte *src, size_t size,
+                   std::string &out);
+
+// 解压到 dst，解压后大小必须恰好为 raw_size
+bool DecompressChunk(ColumnCodec codec, const Byte *src, size_t size,
+                     Byte *dst, size_t raw_size);
+
+using ChunkBuffer = std::vector<Byte>;
+using ChunkBufferRef = std::shared_ptr<ChunkBuffer>;
+
+// 解压缓冲区池：缓冲区释放时归还，按容量复用，避免每次读取都分配大块内存
+// 空闲缓冲区总量超过 CHUNK_BUFFER_POOL_BYTES 时直接释放
+class ChunkBufferPool {
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<ChunkBuffer>> free_;
+  size_t free_bytes_{0};
+
+  void Release(ChunkBuffer *buffer);
+
+public:
+  // 进程级共享池
+  static ChunkBufferPool &Default();
+
+  // 取一块 size 字节的缓冲区，最后一个引用释放时自动归还
+  ChunkBufferRef Acquire(size_t size);
+
+  size_t FreeBytes();
+};
+} // namespace DB
@@ -1,22 +1,254 @@
 #include "storage/lsmtree/ColumnReader.hpp"
+#include "common/Logger.hpp"
+#include "storage/lsmtree/BitPacking.hpp"
+#include "storage/lsmtree/Gorilla.hpp"
+#include "storage/lsmtree/RunLength.hpp"
 #include "storage/column/ColumnString.hpp"
 #include "storage/column/ColumnVector.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <string_view>
+#include <type_traits>
 
 namespace DB {
+// 字典编码 String 列的只读视图，col_data 指向 null bitmap 之后
+struct DictionaryView {
+  uint32_t count{0};
+  const uint32_t *offsets{nullptr};
+  const char *data{nullptr};
+  const Byte *codes{nullptr};
+  uint32_t width{0};
+  bool run_length{false};
+
+  DictionaryView(const Byte *col_data, ColumnEncoding encoding) {
+    std::memcpy(&count, col_data, sizeof(count));
+    offsets = reinterpret_cast<const uint32_t *>(col_data + sizeof(count));
+    data = reinterpret_cast<const char *>(offsets + count + 1);
+    codes = data + offsets[count];
+    width = DictionaryCodeWidth(count);
+    run_length = encoding == ColumnEncoding::DictionaryRunLength;
+  }
+
+  uint32_t ReadCode(const Byte *p) const {
+    if (width == sizeof(uint8_t)) {
+      return static_cast<uint8_t>(*p);
+    }
+    uint16_t code = 0;
+    std::memcpy(&code, p, sizeof(code));
+    return code;
+  }
+
+  uint32_t Code(uint32_t row) const {
+    if (run_length) {
+      RunLengthView runs(codes, width);
+      return ReadCode(runs.ValuePtr(runs.FindRun(row)));
+    }
+    return ReadCode(codes + row * width);
+  }
+
+  // 对 [begin, end) 内的行依次回调 f(run_begin, run_end, code)，
+  // plain 编码每行回调一次，run 截断到区间内
+  template <typename F>
+  void ForEachRun(uint32_t begin, uint32_t end, F &&f) const {
+    if (!run_length) {
+      for (uint32_t i = begin; i < end; i++) {
+        f(i, i + 1, ReadCode(codes + i * width));
+      }
+      return;
+    }
+    RunLengthView runs(codes, width);
+    for (uint32_t r = runs.FindRun(begin);
+         r < runs.RunCount() && runs.RunBegin(r) < end; r++) {
+      f(std::max(runs.RunBegin(r), begin), std::min(runs.RunEnd(r), end),
+        ReadCode(runs.ValuePtr(r)));
+    }
+  }
+
+  std::string_view Entry(uint32_t code) const {
+    return {data + offsets[code], offsets[code + 1] - offsets[code]};
+  }
+};
+
+// 把 run-length 编码的定长列逐 run 展开，追加到 vec
+template <typename T>
+static void AppendRuns(const Byte *col_data, ColumnVector<T> *vec) {
+  RunLengthView runs(col_data, sizeof(T));
+  for (uint32_t r = 0; r < runs.RunCount(); r++) {
+    T v = runs.Value<T>(r);
+    for (uint32_t i = runs.RunBegin(r); i < runs.RunEnd(r); i++) {
+      vec->Insert(v);
+    }
+  }
+}
+
+const Byte *RowGroupData::Column(size_t col_idx) const {
+  const auto &col = rg_->columns[col_idx];
+  if (sst_ && !sst_->VerifyChunk(rg_idx_, col_idx)) {
+    return nullptr;
+  }
+  if (col.codec == ColumnCodec::None) {
+    return base_ + col.offset;
+  }
+  auto &chunk = chunks_[col_idx];
+  if (!chunk && cache_) {
+    chunk = cache_->Lookup(CacheKey(col_idx, ChunkCache::Form::Decompressed));
+  }
+  if (!chunk) {
+    auto buffer = ChunkBufferPool::Default().Acquire(col.uncompressed_size);
+    if (!DecompressChunk(col.codec, base_ + col.offset, col.size,
+                         buffer->data(), col.uncompressed_size)) {
+      LOG_ERROR("Decompress column {} failed: codec={}, size={}", col_idx,
+                static_cast<int>(col.codec), col.size);
+      return nullptr;
+    }
+    if (cache_) {
+      cache_->Insert(CacheKey(col_idx, ChunkCache::Form::Decompressed),
+                     buffer);
+    }
+    chunk = std::move(buffer);
+  }
+  return chunk->data();
+}
+
+const ChunkBufferRef &RowGroupData::Values(size_t col_idx) const {
+  auto &values = values_[col_idx];
+  const auto &col = rg_->columns[col_idx];
+  bool bit_packed = col.encoding == ColumnEncoding::BitPacked;
+  if (values || (!bit_packed && col.encoding != ColumnEncoding::Gorilla)) {
+    return values;
+  }
+  if (cache_) {
+    values = cache_->Lookup(CacheKey(col_idx, ChunkCache::Form::Values));
+    if (values) {
+      return values;
+    }
+  }
+  const Byte *col_data = Column(col_idx);
+  if (!col_data) {
+    return values;
+  }
+  if (col.has_nulls) {
+    col_data += (rg_->row_count + 7) / 8;
+  }
+  size_t width = bit_packed ? sizeof(int) : sizeof(double);
+  auto buffer = ChunkBufferPool::Default().Acquire(rg_->row_count * width);
+  if (bit_packed) {
+    BitPackedView(col_data, rg_->row_count)
+        .Decode(reinterpret_cast<int *>(buffer->data()));
+  } else {
+    GorillaView(col_data, rg_->row_count)
+        .Decode(reinterpret_cast<double *>(buffer->data()));
+  }
+  if (cache_) {
+    cache_->Insert(CacheKey(col_idx, ChunkCache::Form::Values), buffer);
+  }
+  values = std::move(buffer);
+  return values;
+}
+
+bool ColumnReader::GetValuePointer(const RowGroupData &data, uint32_t row_idx,
+                                   size_t col_idx, ValueType::Type type,
+                                   const Byte *&ptr, uint32_t &len,
+                                   uint64_t &scratch) {
+  // 从 PAX RowGroup 计算列值指针
+  const auto &rg = data.Meta();
+  if (row_idx >= rg.row_count || col_idx >= rg.columns.size()) {
+    return false;
+  }
+  const auto &col = rg.columns[col_idx];
+  const Byte *col_data = data.Column(col_idx);
+  if (!col_data) {
+    return false;
+  }
+
+  // 跳过 null bitmap
+  if (col.has_nulls) {
+    // 检查该行是否为 null
+    const uint8_t *bitmap = reinterpret_cast<const uint8_t *>(col_data);
+    if ((bitmap[row_idx / 8] >> (row_idx % 8)) & 1) {
+      len = 0;
+      ptr = nullptr;
+      return true;
+    }
+    col_data += (rg.row_count + 7) / 8;
+  }
+
+  switch (type) {
+  case ValueType::Type::Int:
+  case ValueType::Type::Double: {
+    len = type == ValueType::Type::Int ? sizeof(int) : sizeof(double);
+    // 有缓存时整列解码一次，之后的点查直接命中
+    if (data.Cached()) {
+      if (const auto &values = data.Values(col_idx)) {
+        ptr = values->data() + row_idx * len;
+        return true;
+      }
+    }
+    if (col.encoding == ColumnEncoding::BitPacked) {
+      int v = BitPackedView(col_data, rg.row_count).Get(row_idx);
+      std::memcpy(&scratch, &v, sizeof(v));
+      ptr = reinterpret_cast<const Byte *>(&scratch);
+      return true;
+    }
+    if (col.encoding == ColumnEncoding::Gorilla) {
+      double v = GorillaView(col_data, rg.row_count).Get(row_idx);
+      std::memcpy(&scratch, &v, sizeof(v));
+      ptr = reinterpret_cast<const Byte *>(&scratch);
+      return true;
+    }
+    if (col.encoding == ColumnEncoding::RunLength) {
+      RunLengthView runs(col_data, len);
+      ptr = runs.ValuePtr(runs.FindRun(row_idx));
+      return true;
+    }
+    ptr = col_data + row_idx * len;
+    return true;
+  }
+  case ValueType::Type::String: {
+    if (IsDictionaryEncoding(col.encoding)) {
+      DictionaryView dict(col_data, col.encoding);
+      auto entry = dict.Entry(dict.Code(row_idx));
+      len = static_cast<uint32_t>(entry.size());
+      ptr = entry.data();
+      return true;
+    }
+    // 字符串 offsets 后接 data 区
+    uint32_t start = 0;
+    uint32_t end = 0;
+    std::memcpy(&start, col_data + row_idx * sizeof(uint32_t),
+                sizeof(uint32_t));
+    std::memcpy(&end, col_data + (row_idx + 1) * sizeof(uint32_t),
+                sizeof(uint32_t));
+    const Byte *data_base = col_data + (rg.row_count + 1) * sizeof(uint32_t);
+    len = end - start;
+    ptr = data_base + start;
+    return true;
+  }
+  case ValueType::Type::Null:
+    len = 0;
+    ptr = nullptr;
+    return true;
+  }
+  return false;
+}
 
 void ColumnReader::ReadColumnFromRowGroup(
-    const RowGroupMeta &rg, const Byte *base, size_t col_idx,
+    const RowGroupData &data, size_t col_idx,
     const std::shared_ptr<ValueType> &type, ColumnPtr &column) {
+  const auto &rg = data.Meta();
   if (rg.row_count == 0 || col_idx >= rg.columns.size()) {
     return;
   }
 
   const auto &col = rg.columns[col_idx];
-  const Byte *col_data = base + col.offset;
+  const Byte *chunk = data.Column(col_idx);
+  if (!chunk) {
+    return;
+  }
+  const Byte *col_data = chunk;
 
   // 如果列有 null，先读取 null bitmap
   size_t bitmap_size = 0;
@@ -31,24 +263,64 @@ void ColumnReader::ReadColumnFromRowGroup(
   case ValueType::Type::Int: {
     auto *vec = static_cast<ColumnVector<int> *>(column.get());
     vec->Reserve(vec->Size() + rg.row_count);
+    if (col.encoding == ColumnEncoding::BitPacked) {
+      if (const auto &values = data.Values(col_idx)) {
+        vec->InsertBulk(reinterpret_cast<const int *>(values->data()),
+                        rg.row_count);
+      }
+      break;
+    }
+    if (col.encoding == ColumnEncoding::RunLength) {
+      AppendRuns(col_data, vec);
+      break;
+    }
     vec->InsertBulk(reinterpret_cast<const int *>(col_data), rg.row_count);
     break;
   }
   case ValueType::Type::Double: {
     auto *vec = static_cast<ColumnVector<double> *>(column.get());
     vec->Reserve(vec->Size() + rg.row_count);
+    if (col.encoding == ColumnEncoding::RunLength) {
+      AppendRuns(col_data, vec);
+      break;
+    }
+    if (col.encoding == ColumnEncoding::Gorilla) {
+      if (const auto &values = data.Values(col_idx)) {
+        vec->InsertBulk(reinterpret_cast<const double *>(values->data()),
+                        rg.row_count);
+      }
+      break;
+    }
     vec->InsertBulk(reinterpret_cast<const double *>(col_data), rg.row_count);
     break;
   }
   case ValueType::Type::String: {
+    auto *str_col = static_cast<ColumnString *>(column.get());
+    if (IsDictionaryEncoding(col.encoding)) {
+      // 逐 run 解码字典项，NULL 行写入空串（bitmap 已设置）
+      DictionaryView dict(col_data, col.encoding);
+      const uint8_t *bitmap =
+          col.has_nulls ? reinterpret_cast<const uint8_t *>(chunk) : nullptr;
+      str_col->Reserve(str_col->Size() + rg.row_count);
+      dict.ForEachRun(0, rg.row_count, [&](uint32_t begin, uint32_t end,
+                                           uint32_t code) {
+        auto entry = dict.Entry(code);
+        for (uint32_t i = begin; i < end; i++) {
+          if (bitmap && ((bitmap[i / 8] >> (i % 8)) & 1)) {
+            str_col->InsertRaw("", 0);
+            continue;
+          }
+          str_col->InsertRaw(entry.data(), entry.size());
+        }
+      });
+      break;
+    }
     // String 列格式: [offset0][offset1]...[offsetN][offsetN+1][string_data...]
     // 共 row_count+1 个 offset，后接字符串数据
     const uint32_t *offsets = reinterpret_cast<const uint32_t *>(col_data);
     const char *str_data =
         reinterpret_cast<const char *>(offsets + rg.row_count + 1);
     size_t str_data_size = offsets[rg.row_count] - offsets[0];
-
-    auto *str_col = static_cast<ColumnString *>(column.get());
     str_col->AppendBulk(offsets, rg.row_count + 1, str_data, str_data_size);
     break;
   }
@@ -56,6 +328,66 @@ void ColumnReader::ReadColumnFromRowGroup(
   }
 }
 
+template <typename T>
+static void AddTypedSpan(const ColumnChunkMeta &col, uint32_t row_count,
+                         const Byte *col_data, const ChunkBufferRef &values,
+                         const std::shared_ptr<void> &ref,
+                         ColumnVector<T> *vec) {
+  if (col.encoding == ColumnEncoding::BitPacked ||
+      col.encoding == ColumnEncoding::Gorilla) {
+    // 解码结果可能与 ChunkCache 共享，span 直接引用
+    if (values) {
+      vec->AddSpan(reinterpret_cast<const T *>(values->data()), row_count,
+                   values);
+    }
+    return;
+  }
+  if (col.encoding == ColumnEncoding::RunLength) {
+    RunLengthView runs(col_data, sizeof(T));
+    vec->AddRunSpan(reinterpret_cast<const T *>(runs.ValuePtr(0)),
+                    runs.RunEnds(), runs.RunCount(), ref);
+    return;
+  }
+  vec->AddSpan(reinterpret_cast<const T *>(col_data), row_count, ref);
+}
+
+void ColumnReader::AddSpan(const RowGroupData &data, size_t col_idx,
+                           ValueType::Type type,
+                           const std::shared_ptr<void> &ref,
+                           ColumnPtr &column) {
+  const auto &rg = data.Meta();
+  if (rg.row_count == 0 || col_idx >= rg.columns.size()) {
+    return;
+  }
+  const auto &col = rg.columns[col_idx];
+  const Byte *col_data = data.Column(col_idx);
+  if (!col_data) {
+    return;
+  }
+  // 压缩列的 span 引用解压缓冲区
+  std::shared_ptr<void> owner = ref;
+  if (col.codec != ColumnCodec::None) {
+    owner = data.Buffer(col_idx);
+  }
+  if (col.has_nulls) {
+    size_t bitmap_size = (rg.row_count + 7) / 8;
+    column->SetNullBitmapRaw(reinterpret_cast<const uint8_t *>(col_data),
+                             bitmap_size);
+    col_data += bitmap_size;
+  }
+  switch (type) {
+  case ValueType::Type::Int:
+    AddTypedSpan(col, rg.row_count, col_data, data.Values(col_idx), owner,
+                 static_cast<ColumnVector<int> *>(column.get()));
+    break;
+  case ValueType::Type::Double:
+    AddTypedSpan(col, rg.row_count, col_data, data.Values(col_idx), owner,
+                 static_cast<ColumnVector<double> *>(column.get()));
+    break;
+  default: break;
+  }
+}
+
 void ColumnReader::ReadColumnFromSSTable(const SSTableRef &sstable,
                                          size_t col_idx,
                                          const std::shared_ptr<ValueType> &type,
@@ -67,27 +399,31 @@ void ColumnReader::ReadColumnFromSSTable(const SSTableRef &sstable,
   const Byte *file_base = sstable->data_file_->Data();
 
   for (const auto &rg : sstable->rowgroups_) {
-    const Byte *rg_base = file_base + static_cast<size_t>(rg.offset);
-    ReadColumnFromRowGroup(rg, rg_base, col_idx, type, column);
+    RowGroupData data(rg, file_base + static_cast<size_t>(rg.offset));
+    ReadColumnFromRowGroup(data, col_idx, type, column);
   }
 }
 
 void ColumnReader::ReadColumnWithSelection(
-    const RowGroupMeta &rg, const Byte *base, size_t col_idx,
+    const RowGroupData &data, size_t col_idx,
     const std::shared_ptr<ValueType> &type, const RowGroupSelection &sel,
     ColumnPtr &column) {
+  const auto &rg = data.Meta();
   if (rg.row_count == 0 || col_idx >= rg.columns.size()) {
     return;
   }
 
   // 连续区间且覆盖整个 RowGroup，走快速路径
   if (sel.IsContiguous() && sel.start_row == 0 && sel.count == rg.row_count) {
-    ReadColumnFromRowGroup(rg, base, col_idx, type, column);
+    ReadColumnFromRowGroup(data, col_idx, type, column);
     return;
   }
 
   const auto &col = rg.columns[col_idx];
-  const Byte *col_data = base + col.offset;
+  const Byte *col_data = data.Column(col_idx);
+  if (!col_data) {
+    return;
+  }
 
   // 如果列有 null，读取 null bitmap 并跳过
   size_t bitmap_size = 0;
@@ -97,6 +433,20 @@ void ColumnReader::ReadColumnWithSelection(
     null_bitmap = reinterpret_cast<const uint8_t *>(col_data);
     col_data += bitmap_size;
   }
+  const bool dictionary = IsDictionaryEncoding(col.encoding);
+  const bool bit_packed = col.encoding == ColumnEncoding::BitPacked;
+  const bool run_length = col.encoding == ColumnEncoding::RunLength;
+  const bool gorilla = col.encoding == ColumnEncoding::Gorilla;
+  // 有缓存时 bit-packed / Gorilla 整列解码一次并共享，否则按行 / 按块解码
+  const Byte *values = nullptr;
+  if (data.Cached() && (bit_packed || gorilla)) {
+    if (const auto &buffer = data.Values(col_idx)) {
+      values = buffer->data();
+    }
+  }
+  // Gorilla 只能整块解码，缓存最近解码的块，有序的选中行每块只解码一次
+  std::vector<double> gorilla_block;
+  uint32_t gorilla_block_idx = UINT32_MAX;
 
   // 获取需要读取的行索引列表
   auto read_row = [&](uint32_t row_idx) {
@@ -124,24 +474,55 @@ void ColumnReader::ReadColumnWithSelection(
     switch (type->GetType()) {
     case ValueType::Type::Int: {
       int v = 0;
-      std::memcpy(&v, col_data + row_idx * sizeof(int), sizeof(int));
+      if (values) {
+        std::memcpy(&v, values + row_idx * sizeof(int), sizeof(int));
+      } else if (bit_packed) {
+        v = BitPackedView(col_data, rg.row_count).Get(row_idx);
+      } else if (run_length) {
+        RunLengthView runs(col_data, sizeof(int));
+        v = runs.Value<int>(runs.FindRun(row_idx));
+      } else {
+        std::memcpy(&v, col_data + row_idx * sizeof(int), sizeof(int));
+      }
       static_cast<ColumnVector<int> *>(column.get())->Insert(v);
       break;
     }
     case ValueType::Type::Double: {
       double v = 0.0;
-      std::memcpy(&v, col_data + row_idx * sizeof(double), sizeof(double));
+      if (values) {
+        std::memcpy(&v, values + row_idx * sizeof(double), sizeof(double));
+      } else if (run_length) {
+        RunLengthView runs(col_data, sizeof(double));
+        v = runs.Value<double>(runs.FindRun(row_idx));
+      } else if (gorilla) {
+        uint32_t block = row_idx / kGorillaBlockSize;
+        if (block != gorilla_block_idx) {
+          GorillaView view(col_data, rg.row_count);
+          gorilla_block.resize(view.BlockRows(block));
+          view.DecodeBlock(block, gorilla_block.data());
+          gorilla_block_idx = block;
+        }
+        v = gorilla_block[row_idx % kGorillaBlockSize];
+      } else {
+        std::memcpy(&v, col_data + row_idx * sizeof(double), sizeof(double));
+      }
       static_cast<ColumnVector<double> *>(column.get())->Insert(v);
       break;
     }
     case ValueType::Type::String: {
+      auto *str_col = static_cast<ColumnString *>(column.get());
+      if (dictionary) {
+        DictionaryView dict(col_data, col.encoding);
+        auto entry = dict.Entry(dict.Code(row_idx));
+        str_col->InsertRaw(entry.data(), entry.size());
+        break;
+      }
       const uint32_t *offsets = reinterpret_cast<const uint32_t *>(col_data);
       const char *str_data =
           reinterpret_cast<const char *>(offsets + rg.row_count + 1);
       uint32_t start = offsets[row_idx];
       uint32_t end = offsets[row_idx + 1];
-      static_cast<ColumnString *>(column.get())
-          ->Insert(std::string(str_data + start, end - start));
+      str_col->InsertRaw(str_data + start, end - start);
       break;
     }
     case ValueType::Type::Null: break;
@@ -160,14 +541,20 @@ void ColumnReader::ReadColumnWithSelection(
 }
 
 void ColumnReader::EvalPredicateOnRowGroup(
-    const RowGroupMeta &rg, const Byte *rg_base, const ScanPredicate &pred,
-    std::vector<uint32_t> &matching_rows) {
-  if (rg.row_count == 0 || pred.column_idx >= rg.columns.size()) {
+    const RowGroupData &data, const ScanPredicate &pred,
+    std::vector<uint32_t> &matching_rows, RowRange range) {
+  const auto &rg = data.Meta();
+  uint32_t begin = range.begin;
+  uint32_t end = std::min(range.end, rg.row_count);
+  if (begin >= end || pred.column_idx >= rg.columns.size()) {
     return;
   }
 
   const auto &col_meta = rg.columns[pred.column_idx];
-  const Byte *col_data = rg_base + col_meta.offset;
+  const Byte *col_data = data.Column(pred.column_idx);
+  if (!col_data) {
+    return;
+  }
 
   // 跳过 null bitmap
   size_t bitmap_size = 0;
@@ -192,11 +579,79 @@ void ColumnReader::EvalPredicateOnRowGroup(
     return false;
   };
 
+  // 输出 [first, last) 中的非 NULL 行
+  auto emit = [&](uint32_t first, uint32_t last) {
+    for (uint32_t i = first; i < last; i++) {
+      if (null_bitmap && ((null_bitmap[i / 8] >> (i % 8)) & 1)) {
+        continue;
+      }
+      matching_rows.push_back(i);
+    }
+  };
+
+  // run-length 列：每个 run 只比较一次，命中的 run 整段输出
+  auto eval_runs = [&](auto c) {
+    using T = decltype(c);
+    RunLengthView runs(col_data, sizeof(T));
+    for (uint32_t r = runs.FindRun(begin);
+         r < runs.RunCount() && runs.RunBegin(r) < end; r++) {
+      if (compare(pred.op, runs.Value<T>(r), c)) {
+        emit(std::max(runs.RunBegin(r), begin), std::min(runs.RunEnd(r), end));
+      }
+    }
+  };
+
   switch (pred.column_type) {
   case ValueType::Type::Int: {
-    const int *data = reinterpret_cast<const int *>(col_data);
     int c = pred.const_int;
-    for (uint32_t i = 0; i < rg.row_count; i++) {
+    if (col_meta.encoding == ColumnEncoding::RunLength) {
+      eval_runs(c);
+      break;
+    }
+    if (col_meta.encoding == ColumnEncoding::BitPacked) {
+      // 先用块头的取值范围整块判定，无法判定时才解码该块
+      BitPackedView view(col_data, rg.row_count);
+      std::array<int, kBitPackBlockSize> block;
+      for (uint32_t b = begin / kBitPackBlockSize;
+           b < view.BlockCount() && b * kBitPackBlockSize < end; b++) {
+        uint32_t first = b * kBitPackBlockSize;
+        uint32_t rows = view.BlockRows(b);
+        int min = 0, max = 0;
+        view.BlockRange(b, min, max);
+        bool all = compare(pred.op, min, c) && compare(pred.op, max, c);
+        bool none = false;
+        switch (pred.op) {
+        case Op::Less: none = min >= c; break;
+        case Op::LessOrEquals: none = min > c; break;
+        case Op::Greater: none = max <= c; break;
+        case Op::GreaterOrEquals: none = max < c; break;
+        case Op::Equals: none = c < min || c > max; break;
+        case Op::NotEquals:
+          all = c < min || c > max;
+          none = min == c && max == c;
+          break;
+        }
+        if (none) {
+          continue;
+        }
+        if (!all) {
+          view.DecodeBlock(b, block.data());
+        }
+        uint32_t last = std::min(first + rows, end) - first;
+        for (uint32_t i = std::max(first, begin) - first; i < last; i++) {
+          uint32_t row = first + i;
+          if (null_bitmap && ((null_bitmap[row / 8] >> (row % 8)) & 1)) {
+            continue;
+          }
+          if (all || compare(pred.op, block[i], c)) {
+            matching_rows.push_back(row);
+          }
+        }
+      }
+      break;
+    }
+    const int *data = reinterpret_cast<const int *>(col_data);
+    for (uint32_t i = begin; i < end; i++) {
       if (null_bitmap && ((null_bitmap[i / 8] >> (i % 8)) & 1)) {
         continue; // null 行不匹配
       }
@@ -207,24 +662,106 @@ void ColumnReader::EvalPredicateOnRowGroup(
     break;
   }
   case ValueType::Type::Double: {
-    const double *data = reinterpret_cast<const double *>(col_data);
     double c = pred.const_double;
-    for (uint32_t i = 0; i < rg.row_count; i++) {
+    if (col_meta.encoding == ColumnEncoding::RunLength) {
+      eval_runs(c);
+      break;
+    }
+    bool full = begin == 0 && end == rg.row_count;
+    if (col_meta.encoding == ColumnEncoding::Gorilla && !full &&
+        !data.Cached()) {
+      // 只解码区间覆盖的块
+      GorillaView view(col_data, rg.row_count);
+      std::array<double, kGorillaBlockSize> block;
+      for (uint32_t b = begin / kGorillaBlockSize; b * kGorillaBlockSize < end;
+           b++) {
+        uint32_t first = b * kGorillaBlockSize;
+        uint32_t last = std::min(first + view.BlockRows(b), end);
+        view.DecodeBlock(b, block.data());
+        for (uint32_t i = std::max(first, begin); i < last; i++) {
+          if (null_bitmap && ((null_bitmap[i / 8] >> (i % 8)) & 1)) {
+            continue;
+          }
+          if (compare(pred.op, block[i - first], c)) {
+            matching_rows.push_back(i);
+          }
+        }
+      }
+      break;
+    }
+    const double *values = reinterpret_cast<const double *>(col_data);
+    if (col_meta.encoding == ColumnEncoding::Gorilla) {
+      const auto &buffer = data.Values(pred.column_idx);
+      if (!buffer) {
+        break;
+      }
+      values = reinterpret_cast<const double *>(buffer->data());
+    }
+    for (uint32_t i = begin; i < end; i++) {
       if (null_bitmap && ((null_bitmap[i / 8] >> (i % 8)) & 1)) {
         continue;
       }
-      if (compare(pred.op, data[i], c)) {
+      if (compare(pred.op, values[i], c)) {
         matching_rows.push_back(i);
       }
     }
     break;
   }
   case ValueType::Type::String: {
+    if (IsDictionaryEncoding(col_meta.encoding)) {
+      // 字典有序：谓词对应一段连续编码 [first, last)，NotEquals 取补集，
+      // 每个 run（plain 编码即每行）只比较整数编码
+      DictionaryView dict(col_data, col_meta.encoding);
+      std::string_view c = pred.const_string;
+      // 第一个 >= c（inclusive 时为 > c）的编码
+      auto bound = [&](bool inclusive) {
+        uint32_t lo = 0, hi = dict.count;
+        while (lo < hi) {
+          uint32_t mid = lo + (hi - lo) / 2;
+          auto entry = dict.Entry(mid);
+          if (entry < c || (inclusive && entry == c)) {
+            lo = mid + 1;
+          } else {
+            hi = mid;
+          }
+        }
+        return lo;
+      };
+      uint32_t lower = bound(false);
+      uint32_t upper = bound(true);
+      uint32_t first = 0, last = dict.count;
+      bool negate = false;
+      switch (pred.op) {
+      case Op::Less: last = lower; break;
+      case Op::LessOrEquals: last = upper; break;
+      case Op::Greater: first = upper; break;
+      case Op::GreaterOrEquals: first = lower; break;
+      case Op::Equals:
+        first = lower;
+        last = upper;
+        break;
+      case Op::NotEquals:
+        first = lower;
+        last = upper;
+        negate = true;
+        break;
+      }
+      if (first >= last && !negate) {
+        break;
+      }
+      dict.ForEachRun(begin, end, [&](uint32_t run_begin, uint32_t run_end,
+                                      uint32_t code) {
+        if ((code >= first && code < last) != negate) {
+          emit(run_begin, run_end);
+        }
+      });
+      break;
+    }
     const uint32_t *offsets = reinterpret_cast<const uint32_t *>(col_data);
     const char *str_data =
         reinterpret_cast<const char *>(offsets + rg.row_count + 1);
     const auto &c = pred.const_string;
-    for (uint32_t i = 0; i < rg.row_count; i++) {
+    for (uint32_t i = begin; i < end; i++) {
       if (null_bitmap && ((null_bitmap[i / 8] >> (i % 8)) & 1)) {
         continue;
       }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "storage/column/Column.hpp"
+#include "storage/lsmtree/ChunkCache.hpp"
+#include "storage/lsmtree/ChunkCompression.hpp"
 #include "storage/lsmtree/RowGroupMeta.hpp"
 #include "storage/lsmtree/SSTable.hpp"
 #include "storage/lsmtree/ScanPredicate.hpp"
@@ -14,12 +16,83 @@
 
 namespace DB {
 
+// 单个 RowGroup 的列数据访问上下文：未压缩列直接指向 mmap，
+// 压缩列首次访问时解压到池化缓冲区，同一上下文内每列最多解压一次
+// 带 ChunkCache 构造时，解压结果与 bit-packed / Gorilla 解码结果经缓存共享
+// 非线程安全，返回的指针在上下文销毁前有效
+class RowGroupData {
+  const RowGroupMeta *rg_{nullptr};
+  const Byte *base_{nullptr};
+  // 由 SSTable 构造时列块首次访问前校验 CRC32C
+  const SSTable *sst_{nullptr};
+  ChunkCache *cache_{nullptr};
+  uint64_t file_id_{0};
+  uint32_t rg_idx_{0};
+  mutable std::vector<ChunkBufferRef> chunks_;
+  mutable std::vector<ChunkBufferRef> values_;
+
+  ChunkCache::Key CacheKey(size_t col_idx, ChunkCache::Form form) const {
+    return {file_id_, rg_idx_, static_cast<uint32_t>(col_idx), form};
+  }
+
+public:
+  RowGroupData() = default;
+
+  RowGroupData(const RowGroupMeta &rg, const Byte *base)
+      : rg_(&rg), base_(base), chunks_(rg.columns.size()),
+        values_(rg.columns.size()) {}
+
+  // cache 为 nullptr 时与不带缓存的构造等价
+  RowGroupData(const SSTable &sst, size_t rg_idx, ChunkCache *cache)
+      : RowGroupData(sst.rowgroups_[rg_idx],
+                     sst.data_file_->Data() +
+                         static_cast<size_t>(sst.rowgroups_[rg_idx].offset)) {
+    sst_ = &sst;
+    cache_ = cache;
+    file_id_ = sst.cache_id_;
+    rg_idx_ = static_cast<uint32_t>(rg_idx);
+  }
+
+  const RowGroupMeta &Meta() const { return *rg_; }
+
+  const Byte *Base() const { return base_; }
+
+  bool Cached() const { return cache_ != nullptr; }
+
+  // 第 col_idx 列的数据（从 null bitmap 起），校验和不匹配或解压失败
+  // 返回 nullptr
+  const Byte *Column(size_t col_idx) const;
+
+  // 压缩列的解压缓冲区（需先经 Column 解压），未压缩列返回 nullptr
+  const ChunkBufferRef &Buffer(size_t col_idx) const {
+    return chunks_[col_idx];
+  }
+
+  // bit-packed Int 列 / Gorilla Double 列解码后的定长值数组（不含 bitmap，
+  // NULL 行取值未定义），其它编码或解码失败返回 nullptr
+  const ChunkBufferRef &Values(size_t col_idx) const;
+};
+
 // 列读取器：直接从 RowGroup PAX 布局批量读取列数据
 class ColumnReader {
 public:
+  // 定位 RowGroup 中单个列值，NULL 返回 ptr = nullptr, len = 0
+  // 字典编码的 String 列返回指向字典项的指针，run-length 列返回所在 run 的值，
+  // bit-packed 的 Int 列与 Gorilla 编码的 Double 列解码到 scratch 并返回其地址
+  static bool GetValuePointer(const RowGroupData &data, uint32_t row_idx,
+                              size_t col_idx, ValueType::Type type,
+                              const Byte *&ptr, uint32_t &len,
+                              uint64_t &scratch);
+
+  // 以 span 形式追加整个 RowGroup 的 Int / Double 列：plain 与 run-length
+  // 直接引用 mmap（ref 保活）或解压缓冲区，bit-packed / Gorilla 解码到
+  // 独立缓冲区，保证与其它 span 的顺序一致
+  static void AddSpan(const RowGroupData &data, size_t col_idx,
+                      ValueType::Type type, const std::shared_ptr<void> &ref,
+                      ColumnPtr &column);
+
   // 从单个 RowGroup 读取指定列，追加到现有 Column
-  static void ReadColumnFromRowGroup(const RowGroupMeta &rg, const Byte *base,
-                                     size_t col_idx,
+  static void ReadColumnFromRowGroup(const RowGroupData &data, size_t col_idx,
                                      const std::shared_ptr<ValueType> &type,
                                      ColumnPtr &column);
 
@@ -29,17 +102,18 @@ public:
                                     ColumnPtr &column);
 
   // 从 RowGroup 读取指定行（根据 RowGroupSelection）
-  static void ReadColumnWithSelection(const RowGroupMeta &rg, const Byte *base,
+  static void ReadColumnWithSelection(const RowGroupData &data,
                                       size_t col_idx,
                                       const std::shared_ptr<ValueType> &type,
                                       const RowGroupSelection &sel,
                                       ColumnPtr &column);
 
-  // 在 RowGroup 上对单个谓词求值，返回匹配的行索引（有序）
-  static void EvalPredicateOnRowGroup(const RowGroupMeta &rg,
-                                      const Byte *rg_base,
+  // 在 RowGroup 的 range 行区间上对单个谓词求值，匹配的行索引（有序）
+  // 追加到 matching_rows
+  static void EvalPredicateOnRowGroup(const RowGroupData &data,
                                       const ScanPredicate &pred,
-                                      std::vector<uint32_t> &matching_rows);
+                                      std::vector<uint32_t> &matching_rows,
+                                      RowRange range = {0, UINT32_MAX});
 };
 
 } // namespace DB
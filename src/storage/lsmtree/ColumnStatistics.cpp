@@ -0,0 +1,212 @@
+#include "storage/lsmtree/ColumnStatistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace DB {
+void HyperLogLog::Add(uint64_t hash) {
+  if (registers_.empty()) {
+    registers_.assign(kRegisters, 0);
+  }
+  // 高 kPrecision 位选寄存器，其余位的前导零个数加一为 rank
+  uint32_t idx = static_cast<uint32_t>(hash >> (64 - kPrecision));
+  uint64_t rest = (hash << kPrecision) | (uint64_t{1} << (kPrecision - 1));
+  auto rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+  registers_[idx] = std::max(registers_[idx], rank);
+}
+
+void HyperLogLog::Merge(const HyperLogLog &other) {
+  if (other.registers_.empty()) {
+    return;
+  }
+  if (registers_.empty()) {
+    registers_ = other.registers_;
+    return;
+  }
+  for (uint32_t i = 0; i < kRegisters; i++) {
+    registers_[i] = std::max(registers_[i], other.registers_[i]);
+  }
+}
+
+uint64_t HyperLogLog::Estimate() const {
+  if (registers_.empty()) {
+    return 0;
+  }
+  constexpr double m = kRegisters;
+  double sum = 0.0;
+  uint32_t zeros = 0;
+  for (auto r : registers_) {
+    sum += std::ldexp(1.0, -r);
+    zeros += r == 0 ? 1 : 0;
+  }
+  double estimate = 0.7213 / (1.0 + 1.079 / m) * m * m / sum;
+  if (estimate <= 2.5 * m && zeros > 0) {
+    estimate = m * std::log(m / zeros);
+  }
+  return static_cast<uint64_t>(std::llround(estimate));
+}
+
+void HyperLogLog::Serialize(std::string &out) const {
+  auto count = static_cast<uint16_t>(registers_.size());
+  out.append(reinterpret_cast<const char *>(&count), sizeof(count));
+  out.append(reinterpret_cast<const char *>(registers_.data()),
+             registers_.size());
+}
+
+bool HyperLogLog::Deserialize(const Byte *&p, const Byte *end) {
+  uint16_t count = 0;
+  if (p + sizeof(count) > end) {
+    return false;
+  }
+  std::memcpy(&count, p, sizeof(count));
+  p += sizeof(count);
+  if ((count != 0 && count != kRegisters) || p + count > end) {
+    return false;
+  }
+  registers_.assign(reinterpret_cast<const uint8_t *>(p),
+                    reinterpret_cast<const uint8_t *>(p) + count);
+  p += count;
+  return true;
+}
+
+Histogram Histogram::Build(const std::vector<double> &values) {
+  Histogram histogram;
+  if (values.empty()) {
+    return histogram;
+  }
+  // 等间隔采样确定分位点，上界最后一个取真实最大值
+  size_t stride = std::max<size_t>(1, values.size() / kSampleSize);
+  std::vector<double> sample;
+  sample.reserve(values.size() / stride + 1);
+  for (size_t i = 0; i < values.size(); i += stride) {
+    sample.push_back(values[i]);
+  }
+  std::sort(sample.begin(), sample.end());
+  auto [min_it, max_it] = std::minmax_element(values.begin(), values.end());
+  std::vector<double> uppers;
+  for (uint32_t b = 1; b < kBuckets; b++) {
+    double bound = sample[b * sample.size() / kBuckets];
+    if (bound < *max_it && (uppers.empty() || bound > uppers.back())) {
+      uppers.push_back(bound);
+    }
+  }
+  uppers.push_back(*max_it);
+
+  std::vector<uint64_t> counts(uppers.size(), 0);
+  for (double v : values) {
+    counts[std::lower_bound(uppers.begin(), uppers.end(), v) -
+           uppers.begin()]++;
+  }
+  double lower = *min_it;
+  for (size_t i = 0; i < uppers.size(); i++) {
+    if (counts[i] > 0) {
+      histogram.buckets_.push_back({lower, uppers[i], counts[i]});
+    }
+    lower = uppers[i];
+  }
+  return histogram;
+}
+
+uint64_t Histogram::Total() const {
+  uint64_t total = 0;
+  for (const auto &b : buckets_) {
+    total += b.count;
+  }
+  return total;
+}
+
+void Histogram::Merge(const Histogram &other) {
+  buckets_.insert(buckets_.end(), other.buckets_.begin(),
+                  other.buckets_.end());
+}
+
+void Histogram::Compact(uint32_t max_buckets) {
+  if (max_buckets == 0 || buckets_.size() <= max_buckets) {
+    return;
+  }
+  std::sort(buckets_.begin(), buckets_.end(),
+            [](const Bucket &a, const Bucket &b) {
+              return a.upper != b.upper ? a.upper < b.upper
+                                        : a.lower < b.lower;
+            });
+  // 每桶累计到 depth 个值即结束，桶数不超过 max_buckets
+  uint64_t depth = Total() / max_buckets + 1;
+  std::vector<Bucket> merged;
+  for (const auto &b : buckets_) {
+    if (merged.empty() || merged.back().count >= depth) {
+      merged.push_back(b);
+      continue;
+    }
+    auto &cur = merged.back();
+    cur.lower = std::min(cur.lower, b.lower);
+    cur.upper = std::max(cur.upper, b.upper);
+    cur.count += b.count;
+  }
+  buckets_ = std::move(merged);
+}
+
+double Histogram::FractionBelow(double value, bool inclusive) const {
+  uint64_t total = Total();
+  if (total == 0) {
+    return 0.0;
+  }
+  double below = 0.0;
+  for (const auto &b : buckets_) {
+    if (b.upper < value || (inclusive && b.upper == value)) {
+      below += static_cast<double>(b.count);
+    } else if (b.lower < value && b.upper > b.lower) {
+      // 桶内按均匀分布插值
+      below += static_cast<double>(b.count) * (value - b.lower) /
+               (b.upper - b.lower);
+    }
+  }
+  return std::min(1.0, below / static_cast<double>(total));
+}
+
+void Histogram::Serialize(std::string &out) const {
+  auto count = static_cast<uint8_t>(buckets_.size());
+  out.append(reinterpret_cast<const char *>(&count), sizeof(count));
+  for (const auto &b : buckets_) {
+    auto bucket_count = static_cast<uint32_t>(b.count);
+    out.append(reinterpret_cast<const char *>(&b.lower), sizeof(b.lower));
+    out.append(reinterpret_cast<const char *>(&b.upper), sizeof(b.upper));
+    out.append(reinterpret_cast<const char *>(&bucket_count),
+               sizeof(bucket_count));
+  }
+}
+
+bool Histogram::Deserialize(const Byte *&p, const Byte *end) {
+  auto read = [&](auto &v) {
+    if (p + sizeof(v) > end) {
+      return false;
+    }
+    std::memcpy(&v, p, sizeof(v));
+    p += sizeof(v);
+    return true;
+  };
+  uint8_t count = 0;
+  if (!read(count)) {
+    return false;
+  }
+  buckets_.clear();
+  buckets_.reserve(count);
+  for (uint8_t i = 0; i < count; i++) {
+    Bucket b{};
+    uint32_t bucket_count = 0;
+    if (!read(b.lower) || !read(b.upper) || !read(bucket_count)) {
+      return false;
+    }
+    b.count = bucket_count;
+    buckets_.push_back(b);
+  }
+  return true;
+}
+
+void ColumnStatistics::Merge(const ColumnStatistics &other) {
+  row_count += other.row_count;
+  null_count += other.null_count;
+  distinct.Merge(other.distinct);
+  histogram.Merge(other.histogram);
+}
+} // namespace DB
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "common/Config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace DB {
+// HyperLogLog 基数估计：2^kPrecision 个寄存器（每个一字节），
+// 同一列的多个 sketch 逐寄存器取最大值即可合并
+class HyperLogLog {
+public:
+  static constexpr uint32_t kPrecision = 10;
+  static constexpr uint32_t kRegisters = 1u << kPrecision;
+
+private:
+  // 为空表示没有加入过任何值
+  std::vector<uint8_t> registers_;
+
+public:
+  // hash 需为 64 位均匀分布的 hash
+  void Add(uint64_t hash);
+
+  void Merge(const HyperLogLog &other);
+
+  bool Empty() const { return registers_.empty(); }
+
+  // 估计加入过的不同值个数，小基数时用 linear counting 修正
+  uint64_t Estimate() const;
+
+  // u16 寄存器个数（0 或 kRegisters）+ 寄存器
+  void Serialize(std::string &out) const;
+
+  bool Deserialize(const Byte *&p, const Byte *end);
+};
+
+// 数值列的等深直方图：每个桶 [lower, upper] 内的非 NULL 值个数大致相同
+// 合并多个 RowGroup 的直方图后桶之间可能重叠，估计时按桶内均匀分布处理
+class Histogram {
+public:
+  // RowGroup 级直方图的桶数
+  static constexpr uint32_t kBuckets = 16;
+  // 建桶时采样的值个数上限
+  static constexpr uint32_t kSampleSize = 4096;
+
+  struct Bucket {
+    double lower;
+    double upper;
+    uint64_t count;
+  };
+
+private:
+  std::vector<Bucket> buckets_;
+
+public:
+  // values 为全部非 NULL 值（无序），按采样的分位点分桶后精确计数
+  static Histogram Build(const std::vector<double> &values);
+
+  bool Empty() const { return buckets_.empty(); }
+
+  const std::vector<Bucket> &Buckets() const { return buckets_; }
+
+  uint64_t Total() const;
+
+  // 追加另一个直方图的桶，之后可用 Compact 收缩
+  void Merge(const Histogram &other);
+
+  // 按上界排序后相邻合并，桶数不超过 max_buckets
+  void Compact(uint32_t max_buckets);
+
+  // 估计 < value（inclusive 时 <=）的值所占比例
+  double FractionBelow(double value, bool inclusive) const;
+
+  // u8 桶数 + 若干 {f64 lower, f64 upper, u32 count}，只用于 RowGroup 级
+  void Serialize(std::string &out) const;
+
+  bool Deserialize(const Byte *&p, const Byte *end);
+};
+
+// 一列的统计信息：RowGroup 级由 SSTableBuilder 生成，表级由各 RowGroup 合并
+struct ColumnStatistics {
+  uint64_t row_count = 0;
+  uint64_t null_count = 0;
+  HyperLogLog distinct;
+  // 仅 Int / Double 列
+  Histogram histogram;
+
+  bool Empty() const { return row_count == 0; }
+
+  void Merge(const ColumnStatistics &other);
+};
+} // namespace DB
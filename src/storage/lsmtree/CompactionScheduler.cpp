@@ -2,6 +2,7 @@
 #include "common/Config.hpp"
 #include "common/Logger.hpp"
 #include "fmt/format.h"
+#include "storage/lsmtree/ChunkCompression.hpp"
 #include "storage/lsmtree/LSMTree.hpp"
 #include "storage/lsmtree/Manifest.hpp"
 #include "storage/lsmtree/builder/SSTableBuilder.hpp"
@@ -201,6 +202,14 @@ Status CompactionScheduler::DoCompaction(CompactionJob &job) {
     return tree_->InstallCompactionResults(job, job.input_sstables);
   }
 
+  // 合并前校验全部输入块，避免把损坏的数据写进新文件
+  for (auto &sstable : input_tables) {
+    auto status = sstable->VerifyChecksums();
+    if (!status.ok()) {
+      return status;
+    }
+  }
+
   // 创建合并用的迭代器 - 较新的表在前（输入层的表较新）
   for (auto &sstable : input_tables) {
     iters.push_back(std::make_shared<SSTableIterator>(sstable, column_types));
@@ -266,8 +275,20 @@ Status CompactionScheduler::DoCompaction(CompactionJob &job) {
   uint32_t new_table_id = tree_->GetNextTableId();
   std::vector<uint32_t> new_sstable_ids;
 
+  auto filter_columns = tree_->GetFilterColumns();
+  auto gorilla_columns = tree_->GetGorillaColumns();
+  auto sizing = tree_->GetRowGroupSizing();
+  // 下方已无重叠数据时输出即为该 key 范围的最底层
+  auto codec = ColumnCodecForLevel(job.output_level, can_drop_tombstone);
+  // 只在最底层聚簇：数据不再下沉，重排一次即可长期受益
+  ClusterSpec cluster;
+  if (can_drop_tombstone) {
+    cluster = tree_->GetClusterSpec();
+  }
   auto builder = std::make_unique<SSTableBuilder>(
-      path, new_table_id, column_types, primary_key_idx);
+      path, new_table_id, column_types, primary_key_idx,
+      DEFAULT_KEY_FILTER_TYPE, filter_columns, gorilla_columns, codec, sizing);
+  builder->SetClustering(cluster);
 
   std::string current_min_key;
   std::string current_max_key;
@@ -322,8 +343,11 @@ Status CompactionScheduler::DoCompaction(CompactionJob &job) {
 
       // 开始新 SSTable
       new_table_id = tree_->GetNextTableId();
-      builder = std::make_unique<SSTableBuilder>(path, new_table_id,
-                                                 column_types, primary_key_idx);
+      builder = std::make_unique<SSTableBuilder>(
+          path, new_table_id, column_types, primary_key_idx,
+          DEFAULT_KEY_FILTER_TYPE, filter_columns, gorilla_columns, codec,
+          sizing);
+      builder->SetClustering(cluster);
 
       current_min_key = key_str;
       current_max_key = key_str;
@@ -0,0 +1,58 @@
+#include "storage/lsmtree/Crc32c.hpp"
+#include "common/CpuFeature.hpp"
+
+#include <nmmintrin.h>
+
+#include <array>
+#include <cstring>
+
+namespace DB {
+// 反射多项式 0x82F63B78
+static constexpr std::array<uint32_t, 256> kCrc32cTable = [] {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < 256; i++) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1)));
+    }
+    table[i] = crc;
+  }
+  return table;
+}();
+
+static uint32_t Crc32cScalar(const uint8_t *p, size_t size, uint32_t crc) {
+  for (size_t i = 0; i < size; i++) {
+    crc = kCrc32cTable[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+[[gnu::target("sse4.2")]]
+static uint32_t Crc32cSSE42(const uint8_t *p, size_t size, uint32_t crc) {
+  uint64_t crc64 = crc;
+  while (size >= sizeof(uint64_t)) {
+    uint64_t word = 0;
+    std::memcpy(&word, p, sizeof(word));
+    crc64 = _mm_crc32_u64(crc64, word);
+    p += sizeof(word);
+    size -= sizeof(word);
+  }
+  auto crc32 = static_cast<uint32_t>(crc64);
+  while (size > 0) {
+    crc32 = _mm_crc32_u8(crc32, *p++);
+    size--;
+  }
+  return crc32;
+}
+
+uint32_t Crc32c(const void *data, size_t size, uint32_t crc) {
+  const auto *p = static_cast<const uint8_t *>(data);
+  crc = ~crc;
+  if (HasSSE42()) {
+    crc = Crc32cSSE42(p, size, crc);
+  } else {
+    crc = Crc32cScalar(p, size, crc);
+  }
+  return ~crc;
+}
+} // namespace DB
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DB {
+// CRC32C (Castagnoli)：支持 SSE4.2 时用 crc32 指令，否则查表
+// crc 为之前数据的结果，可分段累加计算
+uint32_t Crc32c(const void *data, size_t size, uint32_t crc = 0);
+} // namespace DB
@@ -0,0 +1,197 @@
+#include "storage/lsmtree/Gorilla.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace DB {
+static constexpr uint32_t kNoWindow = 64;
+static constexpr uint32_t kMaxLeading = 31;
+
+// 高位在前的 bit 写入器
+class BitWriter {
+  std::string &out_;
+  uint64_t acc_{0};
+  uint32_t used_{0};
+  uint64_t total_{0};
+
+  void Flush(uint32_t bytes) {
+    for (uint32_t i = 0; i < bytes; i++) {
+      out_.push_back(static_cast<char>(acc_ >> (56 - i * 8)));
+    }
+    acc_ = 0;
+    used_ = 0;
+  }
+
+public:
+  explicit BitWriter(std::string &out) : out_(out) {}
+
+  uint64_t BitCount() const { return total_; }
+
+  // 写入 value 的低 n 位 (1 <= n <= 64)
+  void Write(uint64_t value, uint32_t n) {
+    if (n < 64) {
+      value &= (uint64_t{1} << n) - 1;
+    }
+    total_ += n;
+    uint32_t space = 64 - used_;
+    if (n <= space) {
+      acc_ |= value << (space - n);
+      used_ += n;
+      if (used_ == 64) {
+        Flush(8);
+      }
+      return;
+    }
+    uint32_t rest = n - space;
+    acc_ |= value >> rest;
+    Flush(8);
+    acc_ = value << (64 - rest);
+    used_ = rest;
+  }
+
+  void Finish() { Flush((used_ + 7) / 8); }
+};
+
+// 高位在前的 bit 读取器，依赖数据末尾的 8 字节填充
+class BitReader {
+  const Byte *data_;
+  uint64_t pos_;
+
+public:
+  BitReader(const Byte *data, uint64_t pos) : data_(data), pos_(pos) {}
+
+  // 读取 n 位 (1 <= n <= 64)
+  uint64_t Read(uint32_t n) {
+    if (n > 56) {
+      uint64_t hi = Read(32);
+      return (hi << (n - 32)) | Read(n - 32);
+    }
+    uint64_t word = 0;
+    std::memcpy(&word, data_ + pos_ / 8, sizeof(word));
+    word = __builtin_bswap64(word) << (pos_ % 8);
+    pos_ += n;
+    return word >> (64 - n);
+  }
+};
+
+static uint64_t ToBits(double v) {
+  uint64_t bits = 0;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+
+static double FromBits(uint64_t bits) {
+  double v = 0.0;
+  std::memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+static void EncodeBlock(const double *values, uint32_t rows,
+                        BitWriter &writer) {
+  uint64_t prev = ToBits(values[0]);
+  writer.Write(prev, 64);
+  uint32_t window_leading = kNoWindow;
+  uint32_t window_trailing = 0;
+  for (uint32_t i = 1; i < rows; i++) {
+    uint64_t cur = ToBits(values[i]);
+    uint64_t x = cur ^ prev;
+    prev = cur;
+    if (x == 0) {
+      writer.Write(0, 1);
+      continue;
+    }
+    uint32_t leading = std::min<uint32_t>(__builtin_clzll(x), kMaxLeading);
+    uint32_t trailing = __builtin_ctzll(x);
+    if (window_leading != kNoWindow && leading >= window_leading &&
+        trailing >= window_trailing) {
+      writer.Write(0b10, 2);
+      writer.Write(x >> window_trailing,
+                   64 - window_leading - window_trailing);
+      continue;
+    }
+    uint32_t length = 64 - leading - trailing;
+    writer.Write(0b11, 2);
+    writer.Write(leading, 5);
+    writer.Write(length - 1, 6);
+    writer.Write(x >> trailing, length);
+    window_leading = leading;
+    window_trailing = trailing;
+  }
+}
+
+// 从 bit_offset 开始解码 n 个值，依次回调 f(value)
+template <typename F>
+static void DecodeValues(const Byte *stream, uint64_t bit_offset, uint32_t n,
+                         F &&f) {
+  if (n == 0) {
+    return;
+  }
+  BitReader reader(stream, bit_offset);
+  uint64_t prev = reader.Read(64);
+  f(FromBits(prev));
+  uint32_t window_leading = kNoWindow;
+  uint32_t window_trailing = 0;
+  for (uint32_t i = 1; i < n; i++) {
+    if (reader.Read(1) == 0) {
+      f(FromBits(prev));
+      continue;
+    }
+    if (reader.Read(1) == 1) {
+      window_leading = static_cast<uint32_t>(reader.Read(5));
+      uint32_t length = static_cast<uint32_t>(reader.Read(6)) + 1;
+      window_trailing = 64 - window_leading - length;
+    }
+    uint32_t length = 64 - window_leading - window_trailing;
+    prev ^= reader.Read(length) << window_trailing;
+    f(FromBits(prev));
+  }
+}
+
+void GorillaEncode(const double *values, uint32_t count, std::string &out) {
+  uint32_t blocks = (count + kGorillaBlockSize - 1) / kGorillaBlockSize;
+  size_t header_pos = out.size();
+  out.resize(header_pos + blocks * sizeof(uint32_t));
+  std::string stream;
+  BitWriter writer(stream);
+  for (uint32_t b = 0; b < blocks; b++) {
+    auto offset = static_cast<uint32_t>(writer.BitCount());
+    std::memcpy(out.data() + header_pos + b * sizeof(uint32_t), &offset,
+                sizeof(offset));
+    uint32_t begin = b * kGorillaBlockSize;
+    EncodeBlock(values + begin, std::min(kGorillaBlockSize, count - begin),
+                writer);
+  }
+  writer.Finish();
+  out.append(stream);
+  out.append(sizeof(uint64_t), '\0');
+}
+
+uint32_t GorillaView::BlockRows(uint32_t block) const {
+  return std::min(kGorillaBlockSize, count_ - block * kGorillaBlockSize);
+}
+
+void GorillaView::DecodeBlock(uint32_t block, double *out) const {
+  uint32_t offset = 0;
+  std::memcpy(&offset, data_ + block * sizeof(uint32_t), sizeof(offset));
+  const Byte *stream = data_ + BlockCount() * sizeof(uint32_t);
+  DecodeValues(stream, offset, BlockRows(block),
+               [&](double v) { *out++ = v; });
+}
+
+void GorillaView::Decode(double *out) const {
+  for (uint32_t b = 0; b < BlockCount(); b++) {
+    DecodeBlock(b, out + b * kGorillaBlockSize);
+  }
+}
+
+double GorillaView::Get(uint32_t row) const {
+  uint32_t block = row / kGorillaBlockSize;
+  uint32_t offset = 0;
+  std::memcpy(&offset, data_ + block * sizeof(uint32_t), sizeof(offset));
+  const Byte *stream = data_ + BlockCount() * sizeof(uint32_t);
+  double value = 0.0;
+  DecodeValues(stream, offset, row % kGorillaBlockSize + 1,
+               [&](double v) { value = v; });
+  return value;
+}
+} // namespace DB
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "common/Config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace DB {
+// clang-format off
+// Double 列的 Gorilla (XOR) 编码
+//
+//   [bit_offset u32 × 块数][bit stream][8 字节 0 填充]
+//
+// 每 kGorillaBlockSize 个值一块，bit_offset 为块在 bit stream 中的起始位，
+// 块之间互不依赖，可单独解码。块内第一个值原样写 64 bit，之后与前一个值 XOR:
+//   XOR 为 0                    '0'
+//   非 0 位落在上一个窗口内     '10' + 窗口内的有效位
+//   否则                        '11' + 前导 0 个数 (5 bit) + 有效位长度 - 1 (6 bit)
+//                               + 有效位，并以此作为新窗口
+// bit 按高位在前写入；末尾填充保证解码时按 8 字节读取不越界
+// NULL 行按 0 参与编码，读取时以 null bitmap 为准
+// clang-format on
+inline constexpr uint32_t kGorillaBlockSize = 256;
+
+// 编码 count 个值并追加到 out
+void GorillaEncode(const double *values, uint32_t count, std::string &out);
+
+// 已编码列数据的只读视图，data 指向 null bitmap 之后
+class GorillaView {
+  const Byte *data_;
+  uint32_t count_;
+
+public:
+  GorillaView(const Byte *data, uint32_t count) : data_(data), count_(count) {}
+
+  uint32_t BlockCount() const {
+    return (count_ + kGorillaBlockSize - 1) / kGorillaBlockSize;
+  }
+
+  // 第 block 块的行数（最后一块可能不满）
+  uint32_t BlockRows(uint32_t block) const;
+
+  // 解码第 block 块，out 需有 BlockRows(block) 个空间
+  void DecodeBlock(uint32_t block, double *out) const;
+
+  // 解码全部 count 个值
+  void Decode(double *out) const;
+
+  // 单值随机访问，需从所在块的开头解码
+  double Get(uint32_t row) const;
+};
+} // namespace DB
@@ -0,0 +1,75 @@
+#include "storage/lsmtree/KeyFilter.hpp"
+#include "storage/lsmtree/BinaryFuseFilter.hpp"
+#include "storage/lsmtree/BloomFilter.hpp"
+#include "storage/lsmtree/builder/BloomFilterBuilder.hpp"
+
+#include <cstring>
+
+namespace DB {
+
+std::string BuildKeyFilter(KeyFilterType type, const uint64_t *hashes,
+                           size_t count) {
+  if (count == 0) {
+    return {};
+  }
+  if (type == KeyFilterType::BinaryFuse8) {
+    std::string data;
+    if (BinaryFuseFilter::Build(hashes, count, data)) {
+      return data;
+    }
+    // 构建失败时不写过滤器，查询退化为直接查找
+    return {};
+  }
+  BloomFilterBuilder builder(count);
+  builder.AddHashes(hashes, count);
+  return std::move(builder.GetData());
+}
+
+bool KeyFilterMayContain(KeyFilterType type, std::string_view data,
+                         uint64_t hash) {
+  if (data.empty()) {
+    return true;
+  }
+  switch (type) {
+  case KeyFilterType::Bloom: return BloomFilter(data).MayContainKeyHash(hash);
+  case KeyFilterType::BinaryFuse8: {
+    BinaryFuseFilter filter;
+    return !filter.Reset(data) || filter.MayContainHash(hash);
+  }
+  }
+  return true;
+}
+
+void KeyFilterMayContainBatch(KeyFilterType type, std::string_view data,
+                              const uint64_t *hashes, size_t count,
+                              uint64_t *out_bitmap) {
+  size_t words = (count + 63) / 64;
+  if (!data.empty()) {
+    switch (type) {
+    case KeyFilterType::Bloom:
+      BloomFilter(data).MayContainBatch(hashes, count, out_bitmap);
+      return;
+    case KeyFilterType::BinaryFuse8: {
+      BinaryFuseFilter filter;
+      if (filter.Reset(data)) {
+        filter.MayContainBatch(hashes, count, out_bitmap);
+        return;
+      }
+      break;
+    }
+    }
+  }
+  std::memset(out_bitmap, 0xff, words * sizeof(uint64_t));
+}
+
+uint64_t HashColumnValue(ValueType::Type type, const void *data, size_t len) {
+  if (type == ValueType::Type::Double && len == sizeof(double)) {
+    double v = 0.0;
+    std::memcpy(&v, data, sizeof(double));
+    v = v == 0.0 ? 0.0 : v;
+    return BloomFilter::HashKey(reinterpret_cast<const Byte *>(&v),
+                                sizeof(v));
+  }
+  return BloomFilter::HashKey(static_cast<const Byte *>(data), len);
+}
+} // namespace DB
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "type/ValueType.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace DB {
+// RowGroup 主键过滤器类型，记录在 SSTable footer 的 filter_type 字段
+// RowGroupMeta::bloom 中的数据按该类型解释，为空表示没有过滤器
+enum class KeyFilterType : uint16_t {
+  Bloom = 0,       // 7 probe blocked bloom，约 12 bit/key
+  BinaryFuse8 = 1, // binary fuse，约 9 bit/key，误判率更低
+};
+
+inline constexpr KeyFilterType DEFAULT_KEY_FILTER_TYPE =
+    KeyFilterType::BinaryFuse8;
+
+// hashes 为 BloomFilter::HashKey 计算的 key hash
+std::string BuildKeyFilter(KeyFilterType type, const uint64_t *hashes,
+                           size_t count);
+
+// 未知类型或空过滤器一律返回可能存在
+bool KeyFilterMayContain(KeyFilterType type, std::string_view data,
+                         uint64_t hash);
+
+void KeyFilterMayContainBatch(KeyFilterType type, std::string_view data,
+                              const uint64_t *hashes, size_t count,
+                              uint64_t *out_bitmap);
+
+// 列值过滤器使用的 hash，data/len 为列的原始字节
+// Double 的 -0.0 归一为 0.0，保证相等比较的值 hash 相同
+uint64_t HashColumnValue(ValueType::Type type, const void *data, size_t len);
+} // namespace DB
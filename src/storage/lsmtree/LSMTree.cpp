@@ -7,6 +7,7 @@
 #include "storage/column/ColumnString.hpp"
 #include "storage/column/ColumnVector.hpp"
 #include "storage/lsmtree/BloomFilter.hpp"
+#include "storage/lsmtree/KeyFilter.hpp"
 #include "storage/lsmtree/ColumnReader.hpp"
 #include "storage/lsmtree/CompactionScheduler.hpp"
 #include "storage/lsmtree/Manifest.hpp"
@@ -14,11 +15,13 @@
 #include "storage/lsmtree/RowCodec.hpp"
 #include "storage/lsmtree/SelectionVector.hpp"
 #include "storage/lsmtree/Slice.hpp"
+#include "storage/lsmtree/SparseKeyIndex.hpp"
 #include "storage/lsmtree/TableOperator.hpp"
 
 #include <algorithm>
 #include <cstring>
 #include <filesystem>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
@@ -28,66 +31,8 @@
 #include <vector>
 
 namespace DB {
-static bool GetColumnValuePointer(const Byte *base, const RowGroupMeta &rg,
-                                  uint32_t row_idx, size_t col_idx,
-                                  ValueType::Type type, const Byte *&ptr,
-                                  uint32_t &len) {
-  // 从 PAX RowGroup 计算列值指针
-  if (row_idx >= rg.row_count) {
-    return false;
-  }
-  const auto &col = rg.columns[col_idx];
-
-  // 跳过 null bitmap
-  size_t bitmap_size = 0;
-  if (col.has_nulls) {
-    bitmap_size = (rg.row_count + 7) / 8;
-    // 检查该行是否为 null
-    const uint8_t *bitmap =
-        reinterpret_cast<const uint8_t *>(base + col.offset);
-    if ((bitmap[row_idx / 8] >> (row_idx % 8)) & 1) {
-      len = 0;
-      ptr = nullptr;
-      return true;
-    }
-  }
-
-  switch (type) {
-  case ValueType::Type::Int: {
-    len = sizeof(int);
-    ptr = base + col.offset + bitmap_size + row_idx * len;
-    return true;
-  }
-  case ValueType::Type::Double: {
-    len = sizeof(double);
-    ptr = base + col.offset + bitmap_size + row_idx * len;
-    return true;
-  }
-  case ValueType::Type::String: {
-    // 字符串 offsets 后接 data 区
-    const Byte *offsets_base = base + col.offset + bitmap_size;
-    uint32_t start = 0;
-    uint32_t end = 0;
-    std::memcpy(&start, offsets_base + row_idx * sizeof(uint32_t),
-                sizeof(uint32_t));
-    std::memcpy(&end, offsets_base + (row_idx + 1) * sizeof(uint32_t),
-                sizeof(uint32_t));
-    const Byte *data_base =
-        offsets_base + (rg.row_count + 1) * sizeof(uint32_t);
-    len = end - start;
-    ptr = data_base + start;
-    return true;
-  }
-  case ValueType::Type::Null:
-    len = 0;
-    ptr = nullptr;
-    return true;
-  }
-  return false;
-}
-
 static bool BuildRowFromRowGroup(
-    const Byte *base, const RowGroupMeta &rg, uint32_t row_idx,
+    const RowGroupData &data, uint32_t row_idx,
     const std::vector<std::shared_ptr<ValueType>> &column_types, Slice *row) {
   if (!row) {
     return false;
@@ -98,8 +43,10 @@ static bool BuildRowFromRowGroup(
   for (size_t col_idx = 0; col_idx < column_types.size(); col_idx++) {
     const Byte *ptr = nullptr;
     uint32_t len = 0;
-    if (!GetColumnValuePointer(base, rg, row_idx, col_idx,
-                               column_types[col_idx]->GetType(), ptr, len)) {
+    uint64_t scratch = 0;
+    if (!ColumnReader::GetValuePointer(data, row_idx, col_idx,
+                                       column_types[col_idx]->GetType(), ptr,
+                                       len, scratch)) {
       return false;
     }
     buffer.append(reinterpret_cast<const char *>(&len), sizeof(len));
@@ -179,9 +126,102 @@ static bool GetKeyFromKeyColumn(const Byte *base, const RowGroupMeta &rg,
   return false;
 }
 
-static bool FindRowIndex(const Byte *base, const RowGroupMeta &rg,
-                         const Slice &key, ValueType::Type key_type,
-                         uint16_t key_idx, uint32_t &row_idx) {
+static bool HasIntKeyIndex(const RowGroupMeta &rg) {
+  return !rg.learned_index.Empty() || !rg.key_index.Empty();
+}
+
+// 用 learned index 或稀疏索引把 key 的 lower_bound 位置缩小到 [begin, end]
+// 返回 false 表示 key 小于 RowGroup 内所有 key
+static bool NarrowIntKeyWindow(const RowGroupMeta &rg, int key,
+                               uint32_t &begin, uint32_t &end) {
+  if (!rg.learned_index.Empty()) {
+    rg.learned_index.Window(key, begin, end);
+    return begin < end || begin > 0;
+  }
+  return rg.key_index.Locate(key, rg.row_count, begin, end);
+}
+
+// int 主键 lower_bound：第一个 >= key 的行号
+static uint32_t IntKeyLowerBound(const Byte *base, const RowGroupMeta &rg,
+                                 int key) {
+  const int *keys = reinterpret_cast<const int *>(base + rg.key_column_offset);
+  uint32_t begin = 0;
+  uint32_t end = rg.row_count;
+  if (HasIntKeyIndex(rg)) {
+    if (!NarrowIntKeyWindow(rg, key, begin, end)) {
+      return 0;
+    }
+  }
+  uint32_t pos =
+      static_cast<uint32_t>(std::lower_bound(keys + begin, keys + end, key) -
+                            keys);
+  // 窗口越界（理论上不会发生）时退回全量二分
+  if ((begin > 0 && keys[begin - 1] >= key) ||
+      (pos == end && end < rg.row_count && keys[end] < key)) {
+    pos = static_cast<uint32_t>(
+        std::lower_bound(keys, keys + rg.row_count, key) - keys);
+  }
+  return pos;
+}
+
+// int 主键上的范围谓词直接由 key 列索引得到连续行区间，无需逐行求值
+static bool EvalKeyRangePredicate(const Byte *base, const RowGroupMeta &rg,
+                                  const ScanPredicate &pred,
+                                  std::vector<uint32_t> &rows) {
+  using Op = FunctionComparison::Operator;
+  if (pred.column_type != ValueType::Type::Int || pred.op == Op::NotEquals ||
+      rg.key_column_size != rg.row_count * sizeof(int)) {
+    return false;
+  }
+  int c = pred.const_int;
+  auto lower = [&](int k) { return IntKeyLowerBound(base, rg, k); };
+  // upper_bound(c) == lower_bound(c + 1)
+  auto upper = [&](int k) {
+    return k == std::numeric_limits<int>::max() ? rg.row_count : lower(k + 1);
+  };
+  uint32_t first = 0;
+  uint32_t last = rg.row_count;
+  switch (pred.op) {
+  case Op::Equals:
+    first = lower(c);
+    last = upper(c);
+    break;
+  case Op::Less: last = lower(c); break;
+  case Op::LessOrEquals: last = upper(c); break;
+  case Op::Greater: first = upper(c); break;
+  case Op::GreaterOrEquals: first = lower(c); break;
+  case Op::NotEquals: return false;
+  }
+  rows.clear();
+  if (first < last) {
+    rows.resize(last - first);
+    for (uint32_t i = 0; i < last - first; i++) {
+      rows[i] = first + i;
+    }
+  }
+  return true;
+}
+
+// 行级谓词求值：主键范围谓词走 key 列索引，其余只在候选页区间内逐行求值
+static void EvalRowGroupPredicate(const RowGroupData &data,
+                                  const ScanPredicate &pred, uint16_t pk_idx,
+                                  const std::vector<RowRange> &ranges,
+                                  std::vector<uint32_t> &rows) {
+  if (pred.column_idx == pk_idx &&
+      EvalKeyRangePredicate(data.Base(), data.Meta(), pred, rows)) {
+    return;
+  }
+  rows.clear();
+  for (const auto &range : ranges) {
+    ColumnReader::EvalPredicateOnRowGroup(data, pred, rows, range);
+  }
+}
+
+static bool FindRowIndex(const RowGroupData &data, const Slice &key,
+                         ValueType::Type key_type, uint16_t key_idx,
+                         uint32_t &row_idx) {
+  const auto &rg = data.Meta();
+  const Byte *base = data.Base();
   if (rg.row_count == 0) {
     return false;
   }
@@ -189,6 +229,26 @@ static bool FindRowIndex(const Byte *base, const RowGroupMeta &rg,
   // 使用 key 列进行二分查找（如果存在）
   bool use_key_column = (rg.key_column_size > 0);
 
+  // int 主键优先走 learned / 稀疏索引：定位到小窗口后 SIMD 查找
+  uint32_t begin = 0;
+  uint32_t end = 0;
+  if (use_key_column && key_type == ValueType::Type::Int &&
+      key.Size() == sizeof(int) && HasIntKeyIndex(rg)) {
+    int target = 0;
+    std::memcpy(&target, key.GetData(), sizeof(int));
+    if (!NarrowIntKeyWindow(rg, target, begin, end)) {
+      return false;
+    }
+    const int *keys =
+        reinterpret_cast<const int *>(base + rg.key_column_offset) + begin;
+    int64_t pos = SearchIntBlock(keys, end - begin, target);
+    if (pos < 0) {
+      return false;
+    }
+    row_idx = begin + static_cast<uint32_t>(pos);
+    return true;
+  }
+
   int left = 0;
   int right = static_cast<int>(rg.row_count) - 1;
 
@@ -196,10 +256,12 @@ static bool FindRowIndex(const Byte *base, const RowGroupMeta &rg,
     int mid = left + (right - left) / 2;
     const Byte *ptr = nullptr;
     uint32_t len = 0;
+    uint64_t scratch = 0;
     bool got =
         use_key_column
             ? GetKeyFromKeyColumn(base, rg, mid, key_type, ptr, len)
-            : GetColumnValuePointer(base, rg, mid, key_idx, key_type, ptr, len);
+            : ColumnReader::GetValuePointer(data, mid, key_idx, key_type, ptr,
+                                            len, scratch);
     if (!got) {
       return false;
     }
@@ -217,6 +279,52 @@ static bool FindRowIndex(const Byte *base, const RowGroupMeta &rg,
   return false;
 }
 
+// 按 max_key 二分定位可能包含 key 的 RowGroup，key 大于所有 RowGroup 时返回 -1
+static int LocateRowGroup(const SSTable &table, const Slice &key,
+                          ValueType::Type pk_type) {
+  int left = 0;
+  int right = static_cast<int>(table.rowgroups_.size()) - 1;
+  int candidate = -1;
+  while (left <= right) {
+    int mid = left + (right - left) / 2;
+    const auto &max_key_str = table.rowgroups_[mid].max_key;
+    int res = CompareKeys(reinterpret_cast<const Byte *>(max_key_str.data()),
+                          static_cast<uint32_t>(max_key_str.size()),
+                          key.GetData(), key.Size(), pk_type);
+    if (res >= 0) {
+      candidate = mid;
+      right = mid - 1;
+    } else {
+      left = mid + 1;
+    }
+  }
+  return candidate;
+}
+
+// 依次给出可能包含 key 的 RowGroup，after 为上一个候选（首次为 -1），
+// 没有更多候选时返回 -1。key 有序的文件按 max_key 二分只有一个候选，
+// 聚簇文件的 RowGroup 主键范围互相重叠，按主键 zone 逐个筛选
+static int NextRowGroup(const SSTable &table, const Slice &key,
+                        ValueType::Type pk_type, int after) {
+  if (table.key_ordered_) {
+    return after < 0 ? LocateRowGroup(table, key, pk_type) : -1;
+  }
+  for (int i = after + 1; i < static_cast<int>(table.rowgroups_.size());
+       i++) {
+    const auto &zone = table.rowgroups_[i].columns[table.primary_key_idx_].zone;
+    if (!zone.has_value ||
+        (CompareKeys(reinterpret_cast<const Byte *>(zone.min.data()),
+                     static_cast<uint32_t>(zone.min.size()), key.GetData(),
+                     key.Size(), pk_type) <= 0 &&
+         CompareKeys(reinterpret_cast<const Byte *>(zone.max.data()),
+                     static_cast<uint32_t>(zone.max.size()), key.GetData(),
+                     key.Size(), pk_type) >= 0)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
 // 根据 id 生成 WAL 文件路径
 static std::filesystem::path MakeWalPath(const std::filesystem::path &base,
                                          uint32_t id) {
@@ -234,6 +342,34 @@ static void ExtractSSTableKeyRange(const SSTableRef &sstable,
 
   // max_key 使用最后一个 rowgroup 的 max_key
   max_key = sstable->rowgroups_.back().max_key;
+  // 聚簇文件的 RowGroup 主键范围互相重叠，取各 RowGroup 主键 zone 的并集
+  auto pk = sstable->primary_key_idx_;
+  if (!sstable->key_ordered_) {
+    int min = 0;
+    int max = 0;
+    bool first = true;
+    for (const auto &rg : sstable->rowgroups_) {
+      const auto &zone = rg.columns[pk].zone;
+      if (!zone.has_value || zone.min.size() != sizeof(int) ||
+          zone.max.size() != sizeof(int)) {
+        continue;
+      }
+      int zone_min = 0;
+      int zone_max = 0;
+      std::memcpy(&zone_min, zone.min.data(), sizeof(int));
+      std::memcpy(&zone_max, zone.max.data(), sizeof(int));
+      if (first || zone_min < min) {
+        min = zone_min;
+        min_key = zone.min;
+      }
+      if (first || zone_max > max) {
+        max = zone_max;
+        max_key = zone.max;
+      }
+      first = false;
+    }
+    return;
+  }
 
   // min_key 优先使用 zone map 的 min
   const auto &first_rg = sstable->rowgroups_.front();
@@ -261,7 +397,9 @@ LSMTree::LSMTree(std::filesystem::path table_path,
                   std::move(buffer_pool_manager)),
       write_log_(write_log), table_number_(0),
       column_types_(std::move(column_types)),
-      primary_key_idx_(primary_key_idx) {
+      primary_key_idx_(primary_key_idx), row_cache_(RowCache::Default()),
+      row_cache_table_id_(RowCache::NewTableId()),
+      chunk_cache_(ChunkCache::Default()) {
   if (column_types_.empty()) {
     primary_key_idx_ = 0;
   } else if (primary_key_idx_ >= column_types_.size()) {
@@ -392,7 +530,9 @@ LSMTree::~LSMTree() {
     uint32_t out_id = sstable_id;
     std::ignore = TableOperator::BuildSSTable(column_path_, out_id, to_flush,
                                               column_types_, primary_key_idx_,
-                                              table_meta);
+                                              table_meta, filter_columns_,
+                                              gorilla_columns_,
+                                              rowgroup_sizing_);
 
     // 添加到 L0
     AddToL0(sstable_id, table_meta);
@@ -407,9 +547,89 @@ LSMTree::~LSMTree() {
   if (manifest_) {
     std::ignore = manifest_->Save(levels_);
   }
+
+  if (row_cache_) {
+    row_cache_->EraseTable(row_cache_table_id_);
+  }
+  EraseChunkCache();
+}
+
+void LSMTree::SetRowCache(RowCacheRef row_cache) {
+  std::unique_lock lock(latch_);
+  if (row_cache_) {
+    row_cache_->EraseTable(row_cache_table_id_);
+  }
+  row_cache_ = std::move(row_cache);
+}
+
+void LSMTree::SetChunkCache(ChunkCacheRef chunk_cache) {
+  std::unique_lock lock(latch_);
+  EraseChunkCache();
+  chunk_cache_ = std::move(chunk_cache);
+}
+
+void LSMTree::EraseChunkCache() {
+  if (!chunk_cache_) {
+    return;
+  }
+  for (const auto &[id, sst] : sstables_) {
+    chunk_cache_->EraseFile(sst->cache_id_);
+  }
+}
+
+void LSMTree::SetFilterColumns(std::vector<size_t> columns) {
+  std::unique_lock lock(latch_);
+  filter_columns_ = std::move(columns);
+}
+
+std::vector<size_t> LSMTree::GetFilterColumns() {
+  std::shared_lock lock(latch_);
+  return filter_columns_;
+}
+
+void LSMTree::SetGorillaColumns(std::vector<size_t> columns) {
+  std::unique_lock lock(latch_);
+  gorilla_columns_ = std::move(columns);
+}
+
+std::vector<size_t> LSMTree::GetGorillaColumns() {
+  std::shared_lock lock(latch_);
+  return gorilla_columns_;
+}
+
+void LSMTree::SetRowGroupSizing(const RowGroupSizing &sizing) {
+  std::unique_lock lock(latch_);
+  rowgroup_sizing_ = sizing;
+}
+
+RowGroupSizing LSMTree::GetRowGroupSizing() {
+  std::shared_lock lock(latch_);
+  return rowgroup_sizing_;
+}
+
+void LSMTree::SetClusterSpec(ClusterSpec spec) {
+  std::unique_lock lock(latch_);
+  cluster_spec_ = std::move(spec);
+}
+
+ClusterSpec LSMTree::GetClusterSpec() {
+  std::shared_lock lock(latch_);
+  return cluster_spec_;
+}
+
+void LSMTree::InvalidateRowCache(const Slice &key) {
+  if (!row_cache_) {
+    return;
+  }
+  // 先递增序号再删除：并发 GetValue 回填时会在分片锁内看到序号变化
+  write_seq_.fetch_add(1, std::memory_order_release);
+  row_cache_->Erase(row_cache_table_id_, key);
 }
 
 void LSMTree::AddToL0(uint32_t sstable_id, const SSTableRef &sstable) {
+  // 调用方持有 latch_，索引文件与 SSTable 同时对查询可见
+  BuildSecondaryIndexes(sstable_id, *sstable);
+
   std::string min_key, max_key;
   ExtractSSTableKeyRange(sstable, min_key, max_key);
 
@@ -457,7 +677,9 @@ Status LSMTree::Insert(const Slice &key, const Slice &value) {
       uint32_t out_id = sstable_id;
       auto s = TableOperator::BuildSSTable(column_path_, out_id, to_flush,
                                            column_types_, primary_key_idx_,
-                                           table_meta);
+                                           table_meta, filter_columns_,
+                                           gorilla_columns_,
+                                           rowgroup_sizing_);
       if (!s.ok()) {
         return s;
       }
@@ -482,7 +704,11 @@ Status LSMTree::Insert(const Slice &key, const Slice &value) {
     memtable_ = std::make_unique<MemTable>(
         MakeWalPath(column_path_, wal_number_++), write_log_, pk_type, false);
   }
-  return memtable_->Put(key, value);
+  auto s = memtable_->Put(key, value);
+  if (s.ok()) {
+    InvalidateRowCache(key);
+  }
+  return s;
 }
 
 Status LSMTree::BatchInsert(std::vector<std::pair<Slice, Slice>> &entries) {
@@ -527,7 +753,9 @@ Status LSMTree::BatchInsert(std::vector<std::pair<Slice, Slice>> &entries) {
         uint32_t out_id = sstable_id;
         auto s = TableOperator::BuildSSTable(column_path_, out_id, to_flush,
                                              column_types_, primary_key_idx_,
-                                             table_meta);
+                                             table_meta, filter_columns_,
+                                             gorilla_columns_,
+                                             rowgroup_sizing_);
         if (!s.ok()) {
           return s;
         }
@@ -556,6 +784,7 @@ Status LSMTree::BatchInsert(std::vector<std::pair<Slice, Slice>> &entries) {
       memtable_->SetDeferFlush(false);
       return s;
     }
+    InvalidateRowCache(key);
   }
 
   // 批次结束，flush WAL 并恢复默认模式
@@ -571,6 +800,10 @@ Status LSMTree::Remove(const Slice &key) {
 
 Status LSMTree::GetValue(const Slice &key, Slice *value) {
   std::shared_lock lock(latch_);
+  // 必须在查 memtable 之前读取写序号
+  uint64_t observed_seq = write_seq_.load(std::memory_order_acquire);
+  auto row_cache = row_cache_;
+  auto chunk_cache = chunk_cache_;
   Status status = memtable_->Get(key, value);
   if (status.ok()) {
     if (value->Size() == 0) {
@@ -595,11 +828,58 @@ Status LSMTree::GetValue(const Slice &key, Slice *value) {
   }
   lock2.unlock();
 
+  // 内存中没有该 key 时，先查行缓存再查 SSTable
+  if (row_cache && row_cache->Lookup(row_cache_table_id_, key, value)) {
+    LOG_DEBUG("GetValue: found in row cache");
+    return Status::OK();
+  }
+
   // 获取主键类型，用于类型感知比较
   auto pk_type = column_types_[primary_key_idx_]->GetType();
 
   // 搜索 SSTable（所有文件，从新到旧）
-  // 先收集所有 SSTable 引用（持有 latch_ 保护）
+  auto sst_to_search = CollectSSTablesNewestFirst();
+  uint64_t key_hash = BloomFilter::HashKey(key.GetData(), key.Size());
+
+  for (const auto &[id, sst_ref] : sst_to_search) {
+    auto &table = *sst_ref;
+
+    // SSTable 按 max_key 二分定位 RowGroup，使用类型感知比较
+    for (int candidate = NextRowGroup(table, key, pk_type, -1); candidate >= 0;
+         candidate = NextRowGroup(table, key, pk_type, candidate)) {
+      const auto &rg = table.rowgroups_[candidate];
+      // 过滤器先判定再查找
+      if (!KeyFilterMayContain(table.filter_type_, rg.bloom, key_hash)) {
+        continue;
+      }
+      // mmap 读取 RowGroup 数据
+      RowGroupData data(table, candidate, chunk_cache.get());
+      uint32_t row_idx = 0;
+      if (!FindRowIndex(data, key, pk_type, primary_key_idx_, row_idx)) {
+        continue;
+      }
+      if (!BuildRowFromRowGroup(data, row_idx, column_types_, value)) {
+        return Status::Error(ErrorCode::IOError, "Failed to read row");
+      }
+      if (value->Size() == 0) {
+        return Status::Error(ErrorCode::NotFound,
+                             "The key no mapping any value");
+      }
+      if (row_cache) {
+        row_cache->InsertIfUnchanged(row_cache_table_id_, key, *value,
+                                     write_seq_, observed_seq);
+      }
+      LOG_DEBUG("GetValue: found in SSTable {}", id);
+      return Status::OK();
+    }
+  }
+
+  return Status::Error(ErrorCode::NotFound, "The key no mapping any value");
+}
+
+std::vector<std::pair<uint32_t, SSTableRef>>
+LSMTree::CollectSSTablesNewestFirst() {
+  // 持有 latch_ 收集 SSTable 引用
   std::vector<std::pair<uint32_t, SSTableRef>> sst_to_search;
   {
     std::shared_lock sst_lock(latch_);
@@ -610,62 +890,143 @@ Status LSMTree::GetValue(const Slice &key, Slice *value) {
       }
     }
   }
-
-  // 按 ID 降序排序（最新的优先）
   std::sort(sst_to_search.begin(), sst_to_search.end(),
             [](const auto &a, const auto &b) { return a.first > b.first; });
+  return sst_to_search;
+}
 
-  for (const auto &[id, sst_ref] : sst_to_search) {
-    auto &table = *sst_ref;
+void LSMTree::MultiGet(const std::vector<Slice> &keys,
+                       std::vector<Slice> &values,
+                       std::vector<Status> &statuses) {
+  values.assign(keys.size(), Slice{});
+  statuses.assign(keys.size(), Status::Error(ErrorCode::NotFound,
+                                             "The key no mapping any value"));
+  // 内存中命中的 key 不再查 SSTable
+  std::vector<uint8_t> resolved(keys.size(), 0);
+  auto resolve = [&](size_t i) {
+    resolved[i] = 1;
+    if (values[i].Size() > 0) {
+      statuses[i] = Status::OK();
+    }
+  };
 
-    // SSTable 按 max_key 二分定位 RowGroup，使用类型感知比较
-    int left = 0;
-    int right = static_cast<int>(table.rowgroups_.size()) - 1;
-    int candidate = -1;
-    while (left <= right) {
-      int mid = left + (right - left) / 2;
-      const auto &max_key_str = table.rowgroups_[mid].max_key;
-      int res = CompareKeys(reinterpret_cast<const Byte *>(max_key_str.data()),
-                            static_cast<uint32_t>(max_key_str.size()),
-                            key.GetData(), key.Size(), pk_type);
-      if (res >= 0) {
-        candidate = mid;
-        right = mid - 1;
-      } else {
-        left = mid + 1;
+  uint64_t observed_seq = 0;
+  RowCacheRef row_cache;
+  ChunkCacheRef chunk_cache;
+  {
+    std::shared_lock lock(latch_);
+    observed_seq = write_seq_.load(std::memory_order_acquire);
+    row_cache = row_cache_;
+    chunk_cache = chunk_cache_;
+    for (size_t i = 0; i < keys.size(); i++) {
+      if (memtable_->Get(keys[i], &values[i]).ok()) {
+        resolve(i);
       }
     }
+  }
+  {
+    std::shared_lock lock(immutable_latch_);
+    for (size_t i = 0; i < keys.size(); i++) {
+      for (auto it = immutable_table_.rbegin();
+           !resolved[i] && it != immutable_table_.rend(); it++) {
+        if ((*it)->Get(keys[i], &values[i]).ok()) {
+          resolve(i);
+        }
+      }
+    }
+  }
 
-    if (candidate < 0) {
+  std::vector<size_t> pending;
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (resolved[i]) {
       continue;
     }
-    const auto &rg = table.rowgroups_[candidate];
-    // bloom 先判定再查找
-    if (!rg.bloom.empty()) {
-      BloomFilter bloom(rg.bloom);
-      if (!bloom.MayContain(key)) {
-        continue;
-      }
-    }
-    // mmap 读取 RowGroup 数据
-    const Byte *base =
-        table.data_file_->Data() + static_cast<size_t>(rg.offset);
-    uint32_t row_idx = 0;
-    if (!FindRowIndex(base, rg, key, column_types_[primary_key_idx_]->GetType(),
-                      primary_key_idx_, row_idx)) {
+    if (row_cache &&
+        row_cache->Lookup(row_cache_table_id_, keys[i], &values[i])) {
+      statuses[i] = Status::OK();
       continue;
     }
-    if (!BuildRowFromRowGroup(base, rg, row_idx, column_types_, value)) {
-      return Status::Error(ErrorCode::IOError, "Failed to read row");
+    pending.push_back(i);
+  }
+  if (pending.empty()) {
+    return;
+  }
+
+  // 每个 key 的过滤器 hash 只算一次，所有 SSTable 复用
+  std::vector<uint64_t> hashes(keys.size());
+  for (size_t i : pending) {
+    hashes[i] = BloomFilter::HashKey(keys[i].GetData(), keys[i].Size());
+  }
+
+  auto pk_type = column_types_[primary_key_idx_]->GetType();
+  std::vector<std::pair<int, size_t>> located;
+  std::vector<size_t> next_pending;
+  std::vector<uint64_t> batch_hashes;
+  std::vector<uint64_t> bitmap;
+  for (const auto &[id, sst_ref] : CollectSSTablesNewestFirst()) {
+    if (pending.empty()) {
+      break;
     }
-    if (value->Size() == 0) {
-      return Status::Error(ErrorCode::NotFound, "The key no mapping any value");
+    auto &table = *sst_ref;
+    located.clear();
+    next_pending.clear();
+    // 聚簇文件中一个 key 可能有多个候选 RowGroup，都未命中才留给更旧的文件
+    for (size_t i : pending) {
+      for (int rg_idx = NextRowGroup(table, keys[i], pk_type, -1); rg_idx >= 0;
+           rg_idx = NextRowGroup(table, keys[i], pk_type, rg_idx)) {
+        located.emplace_back(rg_idx, i);
+      }
     }
-    LOG_DEBUG("GetValue: found in SSTable {}", id);
-    return Status::OK();
-  }
+    std::sort(located.begin(), located.end());
 
-  return Status::Error(ErrorCode::NotFound, "The key no mapping any value");
+    for (size_t begin = 0; begin < located.size();) {
+      size_t end = begin;
+      while (end < located.size() &&
+             located[end].first == located[begin].first) {
+        end++;
+      }
+      const auto &rg = table.rowgroups_[located[begin].first];
+      size_t count = end - begin;
+      batch_hashes.resize(count);
+      for (size_t j = 0; j < count; j++) {
+        batch_hashes[j] = hashes[located[begin + j].second];
+      }
+      bitmap.resize((count + 63) / 64);
+      KeyFilterMayContainBatch(table.filter_type_, rg.bloom,
+                               batch_hashes.data(), count, bitmap.data());
+
+      // 同一 RowGroup 的多个 key 共享解压后的列
+      RowGroupData data(table, located[begin].first, chunk_cache.get());
+      for (size_t j = 0; j < count; j++) {
+        size_t i = located[begin + j].second;
+        uint32_t row_idx = 0;
+        if (resolved[i] || !(bitmap[j / 64] >> (j % 64) & 1) ||
+            !FindRowIndex(data, keys[i], pk_type, primary_key_idx_, row_idx)) {
+          continue;
+        }
+        resolved[i] = 1;
+        if (!BuildRowFromRowGroup(data, row_idx, column_types_, &values[i])) {
+          statuses[i] = Status::Error(ErrorCode::IOError, "Failed to read row");
+          continue;
+        }
+        if (values[i].Size() == 0) {
+          continue;
+        }
+        statuses[i] = Status::OK();
+        if (row_cache) {
+          row_cache->InsertIfUnchanged(row_cache_table_id_, keys[i], values[i],
+                                       write_seq_, observed_seq);
+        }
+      }
+      begin = end;
+    }
+    for (size_t i : pending) {
+      if (!resolved[i]) {
+        next_pending.push_back(i);
+      }
+    }
+    pending.swap(next_pending);
+  }
 }
 
 // 根据类型创建空列容器
@@ -733,45 +1094,20 @@ void LSMTree::ScanColumnFromSSTables(size_t column_idx,
     if (!sst->data_file_ || !sst->data_file_->Valid())
       continue;
 
-    const Byte *file_base = sst->data_file_->Data();
-
-    for (const auto &rg : sst->rowgroups_) {
+    for (size_t rg_idx = 0; rg_idx < sst->rowgroups_.size(); rg_idx++) {
+      const auto &rg = sst->rowgroups_[rg_idx];
       if (rg.row_count == 0 || column_idx >= rg.columns.size())
         continue;
-      const Byte *rg_base = file_base + static_cast<size_t>(rg.offset);
+      RowGroupData data(*sst, rg_idx, chunk_cache_.get());
 
       switch (col_type) {
-      case ValueType::Type::Int: {
-        const Byte *col_data = rg_base + rg.columns[column_idx].offset;
-        size_t bitmap_size = 0;
-        if (rg.columns[column_idx].has_nulls) {
-          bitmap_size = (rg.row_count + 7) / 8;
-          res->SetNullBitmapRaw(reinterpret_cast<const uint8_t *>(col_data),
-                                bitmap_size);
-          col_data += bitmap_size;
-        }
-        static_cast<ColumnVector<int> *>(res.get())->AddSpan(
-            reinterpret_cast<const int *>(col_data), rg.row_count,
-            sst->data_file_);
-        break;
-      }
-      case ValueType::Type::Double: {
-        const Byte *col_data = rg_base + rg.columns[column_idx].offset;
-        size_t bitmap_size = 0;
-        if (rg.columns[column_idx].has_nulls) {
-          bitmap_size = (rg.row_count + 7) / 8;
-          res->SetNullBitmapRaw(reinterpret_cast<const uint8_t *>(col_data),
-                                bitmap_size);
-          col_data += bitmap_size;
-        }
-        static_cast<ColumnVector<double> *>(res.get())->AddSpan(
-            reinterpret_cast<const double *>(col_data), rg.row_count,
-            sst->data_file_);
+      case ValueType::Type::Int:
+      case ValueType::Type::Double:
+        ColumnReader::AddSpan(data, column_idx, col_type, sst->data_file_,
+                              res);
         break;
-      }
       case ValueType::Type::String:
-        ColumnReader::ReadColumnFromRowGroup(rg, rg_base, column_idx, type,
-                                             res);
+        ColumnReader::ReadColumnFromRowGroup(data, column_idx, type, res);
         break;
       default: break;
       }
@@ -982,11 +1318,8 @@ void LSMTree::ReadColumnWithSV(size_t column_idx,
       if (sel.rowgroup_idx >= sstable->rowgroups_.size())
         break;
 
-      const auto &rg = sstable->rowgroups_[sel.rowgroup_idx];
-      const Byte *rg_base =
-          sstable->data_file_->Data() + static_cast<size_t>(rg.offset);
-      ColumnReader::ReadColumnWithSelection(rg, rg_base, column_idx, type, sel,
-                                            res);
+      RowGroupData data(*sstable, sel.rowgroup_idx, chunk_cache_.get());
+      ColumnReader::ReadColumnWithSelection(data, column_idx, type, sel, res);
       break;
     }
     }
@@ -1241,7 +1574,8 @@ SelectionVector LSMTree::BuildSelectionVectorInt() {
         valid_rows.reserve(rg.row_count);
 
         const Byte *rg_base = sst_base + static_cast<size_t>(rg.offset);
-        const Byte *col_base = rg_base + rg.columns[primary_key_idx_].offset;
+        // key 列始终为 plain int，主键列本身可能是 bit-packed
+        const Byte *col_base = rg_base + rg.key_column_offset;
         auto search_it = candidate_start;
 
         for (uint32_t row_idx = 0; row_idx < rg.row_count; ++row_idx) {
@@ -1268,7 +1602,8 @@ SelectionVector LSMTree::BuildSelectionVectorInt() {
         valid_rows.reserve(rg.row_count);
 
         const Byte *rg_base = sst_base + static_cast<size_t>(rg.offset);
-        const Byte *col_base = rg_base + rg.columns[primary_key_idx_].offset;
+        // key 列始终为 plain int，主键列本身可能是 bit-packed
+        const Byte *col_base = rg_base + rg.key_column_offset;
         auto search_it = mem_keys.begin();
 
         for (uint32_t row_idx = 0; row_idx < rg.row_count; ++row_idx) {
@@ -1451,15 +1786,17 @@ SelectionVector LSMTree::BuildSelectionVectorString() {
         std::vector<uint32_t> valid_rows;
         valid_rows.reserve(rg.row_count);
 
-        const Byte *rg_base = sst_base + static_cast<size_t>(rg.offset);
+        RowGroupData data(rg, sst_base + static_cast<size_t>(rg.offset));
         auto key_type = column_types_[primary_key_idx_]->GetType();
         auto search_it = candidate_start;
 
         for (uint32_t row_idx = 0; row_idx < rg.row_count; ++row_idx) {
           const Byte *key_ptr = nullptr;
           uint32_t key_len = 0;
-          if (!GetColumnValuePointer(rg_base, rg, row_idx, primary_key_idx_,
-                                     key_type, key_ptr, key_len)) {
+          uint64_t scratch = 0;
+          if (!ColumnReader::GetValuePointer(data, row_idx, primary_key_idx_,
+                                             key_type, key_ptr, key_len,
+                                             scratch)) {
             continue;
           }
 
@@ -1482,15 +1819,17 @@ SelectionVector LSMTree::BuildSelectionVectorString() {
         std::vector<uint32_t> valid_rows;
         valid_rows.reserve(rg.row_count);
 
-        const Byte *rg_base = sst_base + static_cast<size_t>(rg.offset);
+        RowGroupData data(rg, sst_base + static_cast<size_t>(rg.offset));
         auto key_type = column_types_[primary_key_idx_]->GetType();
         auto search_it = mem_keys.begin();
 
         for (uint32_t row_idx = 0; row_idx < rg.row_count; ++row_idx) {
           const Byte *key_ptr = nullptr;
           uint32_t key_len = 0;
-          if (!GetColumnValuePointer(rg_base, rg, row_idx, primary_key_idx_,
-                                     key_type, key_ptr, key_len)) {
+          uint64_t scratch = 0;
+          if (!ColumnReader::GetValuePointer(data, row_idx, primary_key_idx_,
+                                             key_type, key_ptr, key_len,
+                                             scratch)) {
             continue;
           }
 
@@ -1556,7 +1895,9 @@ Status LSMTree::FlushToSST() {
     uint32_t out_id = sstable_id;
     auto s = TableOperator::BuildSSTable(column_path_, out_id, to_flush,
                                          column_types_, primary_key_idx_,
-                                         table_meta);
+                                         table_meta, filter_columns_,
+                                         gorilla_columns_,
+                                         rowgroup_sizing_);
     if (!s.ok()) {
       return s;
     }
@@ -1590,8 +1931,12 @@ SSTableRef LSMTree::GetSSTable(uint32_t id) {
 }
 
 void LSMTree::RegisterSSTable(uint32_t id, SSTableRef sstable) {
-  std::unique_lock<std::shared_mutex> lock(latch_);
-  sstables_[id] = std::move(sstable);
+  {
+    std::unique_lock<std::shared_mutex> lock(latch_);
+    sstables_[id] = sstable;
+  }
+  // compaction 输入在安装结果前仍可见，索引文件可在锁外生成
+  BuildSecondaryIndexes(id, *sstable);
 }
 
 uint32_t LSMTree::GetNextTableId() {
@@ -1640,7 +1985,14 @@ Status LSMTree::InstallCompactionResults(
   }
 
   for (uint32_t id : ids_to_delete) {
-    sstables_.erase(id);
+    auto it = sstables_.find(id);
+    if (it == sstables_.end()) {
+      continue;
+    }
+    if (chunk_cache_) {
+      chunk_cache_->EraseFile(it->second->cache_id_);
+    }
+    sstables_.erase(it);
   }
 
   // 释放锁后删除文件
@@ -1653,6 +2005,13 @@ Status LSMTree::InstallCompactionResults(
     std::filesystem::remove(file_path, ec);
   }
 
+  std::shared_lock index_lock(index_latch_);
+  for (auto &[column_idx, index] : secondary_indexes_) {
+    for (uint32_t id : ids_to_delete) {
+      index->RemoveSSTable(id);
+    }
+  }
+
   return Status::OK();
 }
 
@@ -1668,6 +2027,224 @@ size_t LSMTree::GetL0FileCount() const {
   return levels_[0].sstables.size();
 }
 
+static uint32_t SSTableRowCount(const SSTable &sstable) {
+  uint32_t rows = 0;
+  for (const auto &rg : sstable.rowgroups_) {
+    rows += rg.row_count;
+  }
+  return rows;
+}
+
+static bool MatchesAllPredicates(const Byte *ptr, uint32_t len,
+                                 const std::vector<ScanPredicate> &predicates) {
+  for (const auto &pred : predicates) {
+    if (!ValueMatchesPredicate(ptr, len, pred)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status LSMTree::BuildSecondaryIndexFile(SecondaryIndex &index,
+                                        uint32_t sstable_id,
+                                        const SSTable &sstable) {
+  if (!sstable.data_file_ || !sstable.data_file_->Valid()) {
+    return Status::Error(ErrorCode::IOError, "SSTable data file not mapped");
+  }
+  auto column_idx = index.GetColumnIdx();
+  auto value_type = index.GetValueType();
+  auto pk_type = column_types_[primary_key_idx_]->GetType();
+
+  std::vector<SecondaryIndex::Entry> entries;
+  entries.reserve(SSTableRowCount(sstable));
+  for (const auto &rg : sstable.rowgroups_) {
+    RowGroupData data(
+        rg, sstable.data_file_->Data() + static_cast<size_t>(rg.offset));
+    for (uint32_t row = 0; row < rg.row_count; row++) {
+      const Byte *value = nullptr;
+      const Byte *key = nullptr;
+      uint32_t value_len = 0;
+      uint32_t key_len = 0;
+      uint64_t value_scratch = 0;
+      uint64_t key_scratch = 0;
+      if (!ColumnReader::GetValuePointer(data, row, column_idx, value_type,
+                                         value, value_len, value_scratch) ||
+          !ColumnReader::GetValuePointer(data, row, primary_key_idx_, pk_type,
+                                         key, key_len, key_scratch)) {
+        return Status::Error(ErrorCode::IOError, "Failed to read row");
+      }
+      // NULL（长度为 0）不入索引，任何比较谓词都不会命中
+      if (value_len == 0) {
+        continue;
+      }
+      entries.push_back({std::string(value, value_len),
+                         std::string(key, key_len)});
+    }
+  }
+  return index.AddSSTable(sstable_id, SSTableRowCount(sstable),
+                          std::move(entries));
+}
+
+void LSMTree::BuildSecondaryIndexes(uint32_t sstable_id,
+                                    const SSTable &sstable) {
+  std::vector<size_t> failed;
+  {
+    std::shared_lock index_lock(index_latch_);
+    for (auto &[column_idx, index] : secondary_indexes_) {
+      if (index->HasSSTable(sstable_id)) {
+        continue;
+      }
+      auto s = BuildSecondaryIndexFile(*index, sstable_id, sstable);
+      if (!s.ok()) {
+        LOG_ERROR("Build secondary index on column {} for SSTable {} failed: "
+                  "{}",
+                  column_idx, sstable_id, s.GetMessage());
+        failed.push_back(column_idx);
+      }
+    }
+  }
+  if (failed.empty()) {
+    return;
+  }
+  // 缺少文件的索引会漏掉行，停用后查询退回全表扫描
+  std::unique_lock index_lock(index_latch_);
+  for (auto column_idx : failed) {
+    secondary_indexes_.erase(column_idx);
+  }
+}
+
+Status LSMTree::CreateSecondaryIndex(size_t column_idx) {
+  if (column_idx >= column_types_.size() || column_idx == primary_key_idx_) {
+    return Status::Error(ErrorCode::CreateError,
+                         "Secondary index must be on a non-key column");
+  }
+  auto value_type = column_types_[column_idx]->GetType();
+  if (value_type == ValueType::Type::Null) {
+    return Status::Error(ErrorCode::CreateError,
+                         "Secondary index column type not supported");
+  }
+
+  // 持有 latch_ 阻止刷盘，保证建索引期间 SSTable 集合不变
+  std::shared_lock lock(latch_);
+  std::unique_lock index_lock(index_latch_);
+  if (secondary_indexes_.count(column_idx) > 0) {
+    return Status::OK();
+  }
+  auto index =
+      std::make_unique<SecondaryIndex>(column_path_, column_idx, value_type);
+  for (const auto &[id, sst] : sstables_) {
+    if (!sst || !sst->data_file_ || !sst->data_file_->Valid()) {
+      continue;
+    }
+    if (index->LoadSSTable(id, SSTableRowCount(*sst))) {
+      continue;
+    }
+    auto s = BuildSecondaryIndexFile(*index, id, *sst);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+  secondary_indexes_.emplace(column_idx, std::move(index));
+  return Status::OK();
+}
+
+bool LSMTree::HasSecondaryIndex(size_t column_idx) {
+  std::shared_lock index_lock(index_latch_);
+  return secondary_indexes_.count(column_idx) > 0;
+}
+
+bool LSMTree::EstimateIndexMatches(size_t column_idx,
+                                   const std::vector<ScanPredicate> &predicates,
+                                   size_t &matches, size_t &total) {
+  // 回表依赖 SSTable 点查，字符串主键暂不支持
+  if (column_types_[primary_key_idx_]->GetType() == ValueType::Type::String) {
+    return false;
+  }
+  std::shared_lock index_lock(index_latch_);
+  auto it = secondary_indexes_.find(column_idx);
+  if (it == secondary_indexes_.end()) {
+    return false;
+  }
+  it->second->Estimate(predicates, matches, total);
+  return true;
+}
+
+Status LSMTree::IndexScan(size_t column_idx,
+                          const std::vector<ScanPredicate> &predicates,
+                          std::vector<Slice> &rows) {
+  rows.clear();
+  std::vector<std::string> candidates;
+  {
+    // 同时持有 latch_，避免刷盘使行在 memtable 和索引之间“消失”
+    std::shared_lock lock(latch_);
+    std::shared_lock imm_lock(immutable_latch_);
+    std::shared_lock index_lock(index_latch_);
+    auto it = secondary_indexes_.find(column_idx);
+    if (it == secondary_indexes_.end()) {
+      return Status::Error(ErrorCode::NotFound,
+                           "No secondary index on this column");
+    }
+
+    auto collect = [&](const MemTable &mem) {
+      for (auto iter = mem.GetImpl().MakeIterator(); iter.Valid();
+           iter.Next()) {
+        auto row = iter.GetValueView();
+        const Byte *ptr = nullptr;
+        uint32_t len = 0;
+        if (row.empty() || !RowCodec::DecodeColumnRaw(row.data(), row.size(),
+                                                      column_idx, ptr, len)) {
+          continue;
+        }
+        if (MatchesAllPredicates(ptr, len, predicates)) {
+          candidates.push_back(iter.GetKey().ToString());
+        }
+      }
+    };
+    collect(*memtable_);
+    for (const auto &imm : immutable_table_) {
+      collect(*imm);
+    }
+    it->second->Lookup(predicates, candidates);
+  }
+
+  // 按主键顺序输出，与全表扫描一致
+  auto pk_type = column_types_[primary_key_idx_]->GetType();
+  auto compare = [&](const std::string &a, const std::string &b) {
+    return CompareKeys(a.data(), static_cast<uint32_t>(a.size()), b.data(),
+                       static_cast<uint32_t>(b.size()), pk_type);
+  };
+  std::sort(candidates.begin(), candidates.end(),
+            [&](const auto &a, const auto &b) { return compare(a, b) < 0; });
+  candidates.erase(std::unique(candidates.begin(), candidates.end(),
+                               [&](const auto &a, const auto &b) {
+                                 return compare(a, b) == 0;
+                               }),
+                   candidates.end());
+  std::vector<Slice> keys;
+  keys.reserve(candidates.size());
+  for (auto &key : candidates) {
+    keys.emplace_back(std::move(key));
+  }
+
+  // 候选行可能已被更新或删除，按最新版本重新校验
+  std::vector<Slice> values;
+  std::vector<Status> statuses;
+  MultiGet(keys, values, statuses);
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (!statuses[i].ok()) {
+      continue;
+    }
+    const Byte *ptr = nullptr;
+    uint32_t len = 0;
+    if (RowCodec::DecodeColumnRaw(values[i].GetData(), values[i].Size(),
+                                  column_idx, ptr, len) &&
+        MatchesAllPredicates(ptr, len, predicates)) {
+      rows.push_back(std::move(values[i]));
+    }
+  }
+  return Status::OK();
+}
+
 // 两个有序列表取交集
 static std::vector<uint32_t> IntersectSorted(const std::vector<uint32_t> &a,
                                              const std::vector<uint32_t> &b) {
@@ -1687,6 +2264,24 @@ static std::vector<uint32_t> IntersectSorted(const std::vector<uint32_t> &a,
   return result;
 }
 
+// RowGroup 上所有谓词的行级求值（AND），先按页索引裁剪出候选行区间
+static void EvalRowGroupPredicates(const RowGroupData &data,
+                                   const std::vector<ScanPredicate> &predicates,
+                                   uint16_t pk_idx,
+                                   std::vector<uint32_t> &matching) {
+  matching.clear();
+  auto ranges = PageRangesMayMatch(data.Meta(), predicates);
+  if (ranges.empty()) {
+    return;
+  }
+  EvalRowGroupPredicate(data, predicates[0], pk_idx, ranges, matching);
+  for (size_t p = 1; p < predicates.size() && !matching.empty(); p++) {
+    std::vector<uint32_t> next;
+    EvalRowGroupPredicate(data, predicates[p], pk_idx, ranges, next);
+    matching = IntersectSorted(matching, next);
+  }
+}
+
 void LSMTree::ScanColumnsFromSSTablesWithPredicates(
     const std::vector<size_t> &column_indices,
     const std::vector<ScanPredicate> &predicates,
@@ -1697,35 +2292,19 @@ void LSMTree::ScanColumnsFromSSTablesWithPredicates(
     if (!sst->data_file_ || !sst->data_file_->Valid())
       continue;
 
-    const Byte *file_base = sst->data_file_->Data();
-
     for (size_t rg_idx = 0; rg_idx < sst->rowgroups_.size(); rg_idx++) {
       const auto &rg = sst->rowgroups_[rg_idx];
       if (rg.row_count == 0)
         continue;
-      const Byte *rg_base = file_base + static_cast<size_t>(rg.offset);
-
-      // 1. ZoneMap 裁剪
-      bool skip = false;
-      for (const auto &pred : predicates) {
-        if (pred.column_idx < rg.columns.size() &&
-            !ZoneMapMayMatch(rg.columns[pred.column_idx].zone, pred)) {
-          skip = true;
-          break;
-        }
-      }
-      if (skip)
+      RowGroupData data(*sst, rg_idx, chunk_cache_.get());
+
+      // 1. ZoneMap + 列值过滤器裁剪
+      if (!RowGroupMayMatch(sst->filter_type_, rg, predicates))
         continue;
 
-      // 2. 行级过滤：在各谓词列上求值，取交集
+      // 2. 行级过滤：页索引裁剪后在各谓词列上求值，取交集
       std::vector<uint32_t> matching;
-      ColumnReader::EvalPredicateOnRowGroup(rg, rg_base, predicates[0],
-                                            matching);
-      for (size_t p = 1; p < predicates.size() && !matching.empty(); p++) {
-        std::vector<uint32_t> next;
-        ColumnReader::EvalPredicateOnRowGroup(rg, rg_base, predicates[p], next);
-        matching = IntersectSorted(matching, next);
-      }
+      EvalRowGroupPredicates(data, predicates, primary_key_idx_, matching);
 
       if (matching.empty())
         continue;
@@ -1738,38 +2317,16 @@ void LSMTree::ScanColumnsFromSSTablesWithPredicates(
           if (col_idx >= rg.columns.size())
             continue;
           auto col_type = column_types_[col_idx]->GetType();
-          const Byte *col_data = rg_base + rg.columns[col_idx].offset;
 
           switch (col_type) {
-          case ValueType::Type::Int: {
-            size_t bitmap_size = 0;
-            if (rg.columns[col_idx].has_nulls) {
-              bitmap_size = (rg.row_count + 7) / 8;
-              results[ci]->SetNullBitmapRaw(
-                  reinterpret_cast<const uint8_t *>(col_data), bitmap_size);
-              col_data += bitmap_size;
-            }
-            static_cast<ColumnVector<int> *>(results[ci].get())
-                ->AddSpan(reinterpret_cast<const int *>(col_data), rg.row_count,
-                          sst->data_file_);
-            break;
-          }
-          case ValueType::Type::Double: {
-            size_t bitmap_size = 0;
-            if (rg.columns[col_idx].has_nulls) {
-              bitmap_size = (rg.row_count + 7) / 8;
-              results[ci]->SetNullBitmapRaw(
-                  reinterpret_cast<const uint8_t *>(col_data), bitmap_size);
-              col_data += bitmap_size;
-            }
-            static_cast<ColumnVector<double> *>(results[ci].get())
-                ->AddSpan(reinterpret_cast<const double *>(col_data),
-                          rg.row_count, sst->data_file_);
+          case ValueType::Type::Int:
+          case ValueType::Type::Double:
+            ColumnReader::AddSpan(data, col_idx, col_type, sst->data_file_,
+                                  results[ci]);
             break;
-          }
           case ValueType::Type::String:
             ColumnReader::ReadColumnFromRowGroup(
-                rg, rg_base, col_idx, column_types_[col_idx], results[ci]);
+                data, col_idx, column_types_[col_idx], results[ci]);
             break;
           default: break;
           }
@@ -1787,11 +2344,183 @@ void LSMTree::ScanColumnsFromSSTablesWithPredicates(
           if (col_idx >= rg.columns.size())
             continue;
           ColumnReader::ReadColumnWithSelection(
-              rg, rg_base, col_idx, column_types_[col_idx], sel, results[ci]);
+              data, col_idx, column_types_[col_idx], sel, results[ci]);
+        }
+      }
+    }
+  }
+}
+
+TableStatisticsRef LSMTree::Analyze() {
+  auto stats = std::make_shared<TableStatistics>();
+  stats->columns.resize(column_types_.size());
+  {
+    std::shared_lock lock(latch_);
+    for (auto &[id, sst] : sstables_) {
+      for (const auto &rg : sst->rowgroups_) {
+        stats->row_count += rg.row_count;
+        for (size_t i = 0; i < rg.columns.size() && i < stats->columns.size();
+             i++) {
+          stats->columns[i].Merge(rg.columns[i].stats);
+        }
+      }
+    }
+  }
+  for (auto &column : stats->columns) {
+    column.histogram.Compact(TableStatistics::kHistogramBuckets);
+  }
+  std::lock_guard lock(stats_latch_);
+  table_stats_ = stats;
+  return table_stats_;
+}
+
+TableStatisticsRef LSMTree::GetTableStatistics() {
+  std::lock_guard lock(stats_latch_);
+  return table_stats_;
+}
+
+std::vector<ScanPredicate>
+LSMTree::OrderBySelectivity(const std::vector<ScanPredicate> &predicates) {
+  auto stats = GetTableStatistics();
+  if (!stats || predicates.size() < 2) {
+    return predicates;
+  }
+  std::vector<std::pair<double, size_t>> order;
+  order.reserve(predicates.size());
+  for (size_t i = 0; i < predicates.size(); i++) {
+    order.emplace_back(stats->EstimateSelectivity(predicates[i]), i);
+  }
+  std::stable_sort(
+      order.begin(), order.end(),
+      [](const auto &a, const auto &b) { return a.first < b.first; });
+  std::vector<ScanPredicate> ordered;
+  ordered.reserve(predicates.size());
+  for (const auto &[selectivity, i] : order) {
+    ordered.push_back(predicates[i]);
+  }
+  return ordered;
+}
+
+// 把 count 个非 NULL 值的部分聚合并入结果
+static void MergeAggregate(uint64_t count, double sum, double min, double max,
+                           ColumnAggregate &result) {
+  if (count == 0) {
+    return;
+  }
+  if (result.non_null_count == 0) {
+    result.min = min;
+    result.max = max;
+  } else {
+    result.min = std::min(result.min, min);
+    result.max = std::max(result.max, max);
+  }
+  result.non_null_count += count;
+  result.sum += sum;
+}
+
+// 把列中非 NULL 的值加入聚合结果
+template <typename T>
+static void FoldColumn(ColumnVector<T> &col, ColumnAggregate &result) {
+  const auto &values = col.Data();
+  for (size_t i = 0; i < values.size(); i++) {
+    if (!col.IsNull(i)) {
+      auto v = static_cast<double>(values[i]);
+      MergeAggregate(1, v, v, v, result);
+    }
+  }
+}
+
+// 数值 ZoneMap 中的 min / max
+template <typename T>
+static void DecodeZone(const ZoneMap &zone, double &min, double &max) {
+  T v_min{}, v_max{};
+  std::memcpy(&v_min, zone.min.data(), sizeof(T));
+  std::memcpy(&v_max, zone.max.data(), sizeof(T));
+  min = static_cast<double>(v_min);
+  max = static_cast<double>(v_max);
+}
+
+bool LSMTree::AggregateColumn(size_t column_idx,
+                              const std::vector<ScanPredicate> &predicates,
+                              ColumnAggregate &result) {
+  if (column_idx >= column_types_.size()) {
+    return false;
+  }
+  const auto &type = column_types_[column_idx];
+  const bool numeric = type->GetType() == ValueType::Type::Int ||
+                       type->GetType() == ValueType::Type::Double;
+
+  auto ordered = OrderBySelectivity(predicates);
+  std::shared_lock lock1(latch_), lock2(immutable_latch_);
+  if (HasInMemoryData()) {
+    return false;
+  }
+
+  result = ColumnAggregate{};
+  for (auto &[id, sst] : sstables_) {
+    if (!sst->data_file_ || !sst->data_file_->Valid()) {
+      continue;
+    }
+    for (size_t rg_idx = 0; rg_idx < sst->rowgroups_.size(); rg_idx++) {
+      const auto &rg = sst->rowgroups_[rg_idx];
+      if (rg.row_count == 0 ||
+          !RowGroupMayMatch(sst->filter_type_, rg, predicates)) {
+        continue;
+      }
+
+      // 整个 RowGroup 满足谓词：直接合并预聚合
+      const auto &col = rg.columns[column_idx];
+      if (RowGroupAllMatch(rg, predicates) &&
+          (!numeric || col.has_aggregate)) {
+        result.row_count += rg.row_count;
+        result.metadata_rowgroups++;
+        if (!numeric || col.non_null_count == 0 || !col.zone.has_value) {
+          continue;
+        }
+        double min = 0.0, max = 0.0;
+        if (type->GetType() == ValueType::Type::Int) {
+          DecodeZone<int>(col.zone, min, max);
+        } else {
+          DecodeZone<double>(col.zone, min, max);
+        }
+        MergeAggregate(col.non_null_count, col.sum, min, max, result);
+        continue;
+      }
+
+      // 部分满足（或旧文件没有预聚合）：行级过滤后只读取该列的匹配行
+      RowGroupData data(*sst, rg_idx, chunk_cache_.get());
+      RowGroupSelection sel;
+      sel.source = DataSource::SSTable;
+      sel.source_id = id;
+      sel.rowgroup_idx = static_cast<uint32_t>(rg_idx);
+      if (predicates.empty()) {
+        sel.count = rg.row_count;
+      } else {
+        EvalRowGroupPredicates(data, ordered, primary_key_idx_, sel.rows);
+        if (sel.rows.empty()) {
+          continue;
         }
+        if (sel.rows.size() == rg.row_count) {
+          sel.rows.clear();
+          sel.count = rg.row_count;
+        }
+      }
+      result.row_count += sel.RowCount();
+      result.scanned_rowgroups++;
+      if (!numeric) {
+        continue;
+      }
+      auto values = MakeEmptyColumn(type->GetType());
+      ColumnReader::ReadColumnWithSelection(data, column_idx, type, sel,
+                                            values);
+      if (type->GetType() == ValueType::Type::Int) {
+        FoldColumn(static_cast<ColumnVector<int> &>(*values), result);
+      } else {
+        FoldColumn(static_cast<ColumnVector<double> &>(*values), result);
       }
     }
   }
+  return true;
 }
 
 Status LSMTree::ScanColumnsWithPredicates(
@@ -1806,6 +2535,7 @@ Status LSMTree::ScanColumnsWithPredicates(
     }
   }
 
+  auto ordered = OrderBySelectivity(predicates);
   std::shared_lock lock1(latch_), lock2(immutable_latch_);
 
   for (size_t i = 0; i < column_indices.size(); i++) {
@@ -1814,7 +2544,7 @@ Status LSMTree::ScanColumnsWithPredicates(
 
   if (!HasInMemoryData()) {
     // 快速路径：直接从 SSTable 扫描 + 谓词过滤，所有数据都已过滤
-    ScanColumnsFromSSTablesWithPredicates(column_indices, predicates, results);
+    ScanColumnsFromSSTablesWithPredicates(column_indices, ordered, results);
     all_filtered = true;
     return Status::OK();
   }
@@ -1848,30 +2578,15 @@ Status LSMTree::ScanColumnsWithPredicates(
       continue;
 
     const auto &rg = sst->rowgroups_[sel.rowgroup_idx];
-    const Byte *rg_base =
-        sst->data_file_->Data() + static_cast<size_t>(rg.offset);
-
-    // ZoneMap 检查
-    bool skip = false;
-    for (const auto &pred : predicates) {
-      if (pred.column_idx < rg.columns.size() &&
-          !ZoneMapMayMatch(rg.columns[pred.column_idx].zone, pred)) {
-        skip = true;
-        break;
-      }
-    }
-    if (skip)
+    RowGroupData data(*sst, sel.rowgroup_idx, chunk_cache_.get());
+
+    // ZoneMap + 列值过滤器检查
+    if (!RowGroupMayMatch(sst->filter_type_, rg, ordered))
       continue;
 
-    // 行级过滤：在谓词列上求值
+    // 行级过滤：页索引裁剪后在谓词列上求值
     std::vector<uint32_t> pred_matching;
-    ColumnReader::EvalPredicateOnRowGroup(rg, rg_base, predicates[0],
-                                          pred_matching);
-    for (size_t p = 1; p < predicates.size() && !pred_matching.empty(); p++) {
-      std::vector<uint32_t> next;
-      ColumnReader::EvalPredicateOnRowGroup(rg, rg_base, predicates[p], next);
-      pred_matching = IntersectSorted(pred_matching, next);
-    }
+    EvalRowGroupPredicates(data, ordered, primary_key_idx_, pred_matching);
 
     if (pred_matching.empty())
       continue;
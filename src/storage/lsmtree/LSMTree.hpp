@@ -6,17 +6,23 @@
 #include "storage/column/Column.hpp"
 #include "storage/lsmtree/LevelMeta.hpp"
 #include "storage/lsmtree/MemTable.hpp"
+#include "storage/lsmtree/ChunkCache.hpp"
+#include "storage/lsmtree/RowCache.hpp"
 #include "storage/lsmtree/SSTable.hpp"
 #include "storage/lsmtree/ScanPredicate.hpp"
+#include "storage/lsmtree/SecondaryIndex.hpp"
 #include "storage/lsmtree/SelectionVector.hpp"
+#include "storage/lsmtree/SpaceFillingCurve.hpp"
 #include "storage/lsmtree/Slice.hpp"
 #include "storage/lsmtree/TableOperator.hpp"
+#include "storage/lsmtree/TableStatistics.hpp"
 #include "type/ValueType.hpp"
 
 #include <atomic>
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <thread>
 #include <vector>
@@ -27,6 +33,19 @@ namespace DB {
 class Manifest;
 class CompactionScheduler;
 
+// 单列聚合结果：NULL 行只计入 row_count，min / max 在 non_null_count > 0
+// 时有效；非数值列只统计 row_count
+struct ColumnAggregate {
+  uint64_t row_count{0};
+  uint64_t non_null_count{0};
+  double sum{0.0};
+  double min{0.0};
+  double max{0.0};
+  // 直接使用预聚合 / 需要扫描列数据的 RowGroup 数
+  size_t metadata_rowgroups{0};
+  size_t scanned_rowgroups{0};
+};
+
 class LSMTree : public IndexEngine<Slice, Slice, SliceCompare> {
   std::shared_mutex latch_;
   std::shared_mutex immutable_latch_;
@@ -50,6 +69,50 @@ class LSMTree : public IndexEngine<Slice, Slice, SliceCompare> {
   std::unique_ptr<CompactionScheduler> compaction_scheduler_;
   std::atomic<uint32_t> next_table_id_{0};
 
+  // 点查行缓存（nullptr 表示关闭），只缓存从 SSTable 还原的行
+  RowCacheRef row_cache_;
+  uint64_t row_cache_table_id_;
+  // 解压 / 解码后的列数据块缓存（nullptr 表示关闭），只用于查询路径，
+  // compaction 与迭代器顺序读取一次即丢弃，不经过缓存
+  ChunkCacheRef chunk_cache_;
+  // 每次写入递增，GetValue 回填缓存前据此判断期间是否发生过写入
+  std::atomic<uint64_t> write_seq_{0};
+
+  // 非主键列上的二级索引，column_idx -> index
+  // 锁顺序: latch_ -> index_latch_
+  std::shared_mutex index_latch_;
+  std::map<size_t, SecondaryIndexRef> secondary_indexes_;
+
+  // 构建 SSTable 时生成列值过滤器的列，受 latch_ 保护
+  std::vector<size_t> filter_columns_;
+  // 尝试 Gorilla 编码的 Double 列，受 latch_ 保护
+  std::vector<size_t> gorilla_columns_;
+  // RowGroup 切分策略，受 latch_ 保护
+  RowGroupSizing rowgroup_sizing_;
+  // 最底层 compaction 输出的聚簇方式，受 latch_ 保护
+  ClusterSpec cluster_spec_;
+
+  // 最近一次 ANALYZE 的表级统计，nullptr 表示未分析过
+  std::mutex stats_latch_;
+  TableStatisticsRef table_stats_;
+
+  // 按估计选择率升序排列谓词，行级过滤先求值最有选择性的谓词
+  std::vector<ScanPredicate>
+  OrderBySelectivity(const std::vector<ScanPredicate> &predicates);
+
+  // 写入后使缓存中的旧行失效，调用方需在写入 memtable 之后调用
+  void InvalidateRowCache(const Slice &key);
+
+  // 从列数据块缓存删除本表全部 SSTable 的条目，调用方需持有 latch_
+  void EraseChunkCache();
+
+  // 从 SSTable 收集索引条目并写出该 SSTable 的索引文件
+  Status BuildSecondaryIndexFile(SecondaryIndex &index, uint32_t sstable_id,
+                                 const SSTable &sstable);
+
+  // 为新 SSTable 生成所有二级索引文件，失败的索引会被停用
+  void BuildSecondaryIndexes(uint32_t sstable_id, const SSTable &sstable);
+
   // 主键类型特化的 BuildSelectionVector 实现
   SelectionVector BuildSelectionVectorInt();
   SelectionVector BuildSelectionVectorString();
@@ -62,6 +125,9 @@ class LSMTree : public IndexEngine<Slice, Slice, SliceCompare> {
   // 检查内存中是否有数据（memtable + immutable）
   bool HasInMemoryData() const;
 
+  // 收集可点查的 SSTable，按 id 降序（最新优先）
+  std::vector<std::pair<uint32_t, SSTableRef>> CollectSSTablesNewestFirst();
+
   // 快速路径：直接从 SSTable 读取列，跳过 BuildSelectionVector
   void ScanColumnFromSSTables(size_t column_idx,
                               const std::shared_ptr<ValueType> &type,
@@ -93,6 +159,11 @@ public:
 
   Status GetValue(const Slice &key, Slice *column) override;
 
+  // 批量点查，values/statuses 与 keys 一一对应
+  // SSTable 中把 key 按候选 RowGroup 聚合，过滤器批量探测后再逐个查找
+  void MultiGet(const std::vector<Slice> &keys, std::vector<Slice> &values,
+                std::vector<Status> &statuses);
+
   Status ScanColumn(size_t column_idx, ColumnPtr &res);
 
   // 多列并行扫描：BuildSelectionVector 只构建一次，多列读取并行执行
@@ -106,6 +177,35 @@ public:
                                    const std::vector<ScanPredicate> &predicates,
                                    bool &all_filtered);
 
+  // 用 RowGroup 预聚合回答满足谓词的行上的 COUNT / SUM / MIN / MAX：
+  // 所有行都满足谓词的 RowGroup 直接使用元数据，部分满足的只扫描匹配行
+  // 内存中还有数据时返回 false，由调用方走常规扫描
+  bool AggregateColumn(size_t column_idx,
+                       const std::vector<ScanPredicate> &predicates,
+                       ColumnAggregate &result);
+
+  // 合并所有 SSTable 中 RowGroup 级的列统计，刷新表级统计
+  // 只统计已落盘的数据，memtable 中的行不计入
+  TableStatisticsRef Analyze();
+
+  TableStatisticsRef GetTableStatistics();
+
+  // 在非主键列上建立二级索引：已有 SSTable 优先加载有效的索引文件，否则重建
+  Status CreateSecondaryIndex(size_t column_idx);
+
+  bool HasSecondaryIndex(size_t column_idx);
+
+  // 估计谓词在二级索引上命中的条目数，无法走索引时返回 false
+  bool EstimateIndexMatches(size_t column_idx,
+                            const std::vector<ScanPredicate> &predicates,
+                            size_t &matches, size_t &total);
+
+  // 通过二级索引读取满足谓词（均作用于 column_idx）的最新行
+  // memtable 直接扫描，SSTable 查索引得到候选主键，MultiGet 回表后再校验
+  Status IndexScan(size_t column_idx,
+                   const std::vector<ScanPredicate> &predicates,
+                   std::vector<Slice> &rows);
+
   // 构建去重后的 SelectionVector
   SelectionVector BuildSelectionVector();
 
@@ -118,6 +218,36 @@ public:
 
   uint16_t GetPrimaryKeyIndex() const { return primary_key_idx_; }
 
+  // 替换点查行缓存，传入 nullptr 关闭
+  void SetRowCache(RowCacheRef row_cache);
+
+  const RowCacheRef &GetRowCache() const { return row_cache_; }
+
+  // 替换列数据块缓存，传入 nullptr 关闭
+  void SetChunkCache(ChunkCacheRef chunk_cache);
+
+  const ChunkCacheRef &GetChunkCache() const { return chunk_cache_; }
+
+  // 设置需要列值过滤器的列，只影响之后写出的 SSTable
+  void SetFilterColumns(std::vector<size_t> columns);
+
+  std::vector<size_t> GetFilterColumns();
+
+  // 设置尝试 Gorilla 编码的列，只影响之后写出的 SSTable
+  void SetGorillaColumns(std::vector<size_t> columns);
+
+  std::vector<size_t> GetGorillaColumns();
+
+  // 设置 RowGroup 切分策略，只影响之后写出的 SSTable
+  void SetRowGroupSizing(const RowGroupSizing &sizing);
+
+  RowGroupSizing GetRowGroupSizing();
+
+  // 设置聚簇列与曲线，只影响之后最底层 compaction 写出的 SSTable
+  void SetClusterSpec(ClusterSpec spec);
+
+  ClusterSpec GetClusterSpec();
+
   const std::vector<std::shared_ptr<ValueType>> &GetColumnTypes() const {
     return column_types_;
   }
@@ -0,0 +1,123 @@
+#include "storage/lsmtree/LearnedKeyIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace DB {
+
+void LearnedKeyIndex::Build(const int *keys, uint32_t count,
+                            uint32_t epsilon) {
+  segments_.clear();
+  epsilon_ = epsilon;
+  row_count_ = count;
+  if (!keys || count == 0) {
+    return;
+  }
+
+  // shrinking cone：维护当前段可行斜率区间 [lo, hi]，
+  // 新点使区间为空时结束当前段
+  constexpr double kInf = std::numeric_limits<double>::infinity();
+  auto eps = static_cast<double>(epsilon);
+  uint32_t start = 0;
+  double lo = 0.0;
+  double hi = kInf;
+  auto close_segment = [&]() {
+    double slope = hi == kInf ? lo : (lo + hi) / 2;
+    segments_.push_back({keys[start], start, slope});
+  };
+
+  for (uint32_t i = 1; i < count; i++) {
+    double dx = static_cast<double>(keys[i]) - static_cast<double>(keys[start]);
+    if (keys[i] <= keys[i - 1]) {
+      // 非严格递增的 key 无法保证误差界
+      segments_.clear();
+      return;
+    }
+    double dy = static_cast<double>(i - start);
+    double s_lo = (dy - eps) / dx;
+    double s_hi = (dy + eps) / dx;
+    if (s_lo > hi || s_hi < lo) {
+      close_segment();
+      start = i;
+      lo = 0.0;
+      hi = kInf;
+      continue;
+    }
+    lo = std::max(lo, s_lo);
+    hi = std::min(hi, s_hi);
+  }
+  close_segment();
+}
+
+void LearnedKeyIndex::Window(int key, uint32_t &begin, uint32_t &end) const {
+  begin = end = 0;
+  if (segments_.empty()) {
+    return;
+  }
+  // 最后一个 first_key <= key 的段
+  auto it = std::upper_bound(
+      segments_.begin(), segments_.end(), key,
+      [](int k, const Segment &seg) { return k < seg.first_key; });
+  if (it == segments_.begin()) {
+    return;
+  }
+  const auto &seg = *(it - 1);
+  uint32_t next_start = it == segments_.end() ? row_count_ : it->start_row;
+
+  double predicted =
+      seg.start_row +
+      seg.slope * (static_cast<double>(key) - static_cast<double>(seg.first_key));
+  // 段间空隙里的 key 的 lower_bound 就是下一段起点
+  predicted = std::clamp(predicted, static_cast<double>(seg.start_row),
+                         static_cast<double>(next_start));
+  auto pos = static_cast<int64_t>(std::floor(predicted));
+  int64_t lo = pos - static_cast<int64_t>(epsilon_) - 1;
+  int64_t hi = pos + static_cast<int64_t>(epsilon_) + 2;
+  begin = static_cast<uint32_t>(std::max<int64_t>(lo, 0));
+  end = static_cast<uint32_t>(std::min<int64_t>(hi, row_count_));
+}
+
+void LearnedKeyIndex::Serialize(std::string &out) const {
+  auto append = [&](const auto &v) {
+    out.append(reinterpret_cast<const char *>(&v), sizeof(v));
+  };
+  auto count = static_cast<uint32_t>(segments_.size());
+  append(epsilon_);
+  append(row_count_);
+  append(count);
+  for (const auto &seg : segments_) {
+    append(seg.first_key);
+    append(seg.start_row);
+    append(seg.slope);
+  }
+}
+
+bool LearnedKeyIndex::Deserialize(const Byte *data, size_t size) {
+  const Byte *p = data;
+  const Byte *end = data + size;
+  auto read = [&](auto &v) {
+    if (p + sizeof(v) > end) {
+      return false;
+    }
+    std::memcpy(&v, p, sizeof(v));
+    p += sizeof(v);
+    return true;
+  };
+  uint32_t count = 0;
+  if (!read(epsilon_) || !read(row_count_) || !read(count)) {
+    return false;
+  }
+  segments_.clear();
+  segments_.reserve(count);
+  for (uint32_t i = 0; i < count; i++) {
+    Segment seg{};
+    if (!read(seg.first_key) || !read(seg.start_row) || !read(seg.slope)) {
+      return false;
+    }
+    segments_.push_back(seg);
+  }
+  return p == end;
+}
+} // namespace DB
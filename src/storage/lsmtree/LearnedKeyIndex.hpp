@@ -0,0 +1,50 @@
+#pragma once
+
+#include "common/Config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace DB {
+// RowGroup 内 int 主键的 learned index（PGM 风格分段线性模型）
+// 每段 pos ≈ start_row + slope * (key - first_key)，对训练集中的 key
+// 预测误差不超过 epsilon，查找只需一次模型计算加 2 * epsilon 行的小范围搜索
+class LearnedKeyIndex {
+  struct Segment {
+    int first_key;
+    uint32_t start_row;
+    double slope;
+  };
+
+  uint32_t epsilon_{0};
+  uint32_t row_count_{0};
+  std::vector<Segment> segments_;
+
+public:
+  LearnedKeyIndex() = default;
+
+  // keys 需严格递增，否则不构建索引
+  void Build(const int *keys, uint32_t count, uint32_t epsilon);
+
+  bool Empty() const { return segments_.empty(); }
+
+  size_t SegmentCount() const { return segments_.size(); }
+
+  uint32_t Epsilon() const { return epsilon_; }
+
+  // 序列化后的字节数，用于和稀疏索引比较取舍
+  size_t SerializedSize() const {
+    return sizeof(uint32_t) * 3 +
+           segments_.size() * (sizeof(int) + sizeof(uint32_t) + sizeof(double));
+  }
+
+  // 返回包含 key 的 lower_bound 位置的行窗口 [begin, end)
+  void Window(int key, uint32_t &begin, uint32_t &end) const;
+
+  void Serialize(std::string &out) const;
+
+  bool Deserialize(const Byte *data, size_t size);
+};
+} // namespace DB
@@ -0,0 +1,130 @@
+#include "storage/lsmtree/RowCache.hpp"
+#include "common/Config.hpp"
+#include "common/Hash.hpp"
+
+#include <cstring>
+
+namespace DB {
+
+RowCache::RowCache(size_t capacity_bytes)
+    : capacity_per_shard_(capacity_bytes / kShardCount) {}
+
+std::shared_ptr<RowCache> RowCache::Default() {
+  static std::shared_ptr<RowCache> cache =
+      ROW_CACHE_CAPACITY == 0 ? nullptr
+                              : std::make_shared<RowCache>(ROW_CACHE_CAPACITY);
+  return cache;
+}
+
+uint64_t RowCache::NewTableId() {
+  static std::atomic<uint64_t> next_id{0};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string RowCache::MakeKey(uint64_t table_id, const Slice &key) {
+  std::string cache_key(sizeof(table_id) + key.Size(), '\0');
+  std::memcpy(cache_key.data(), &table_id, sizeof(table_id));
+  if (key.Size() > 0) {
+    std::memcpy(cache_key.data() + sizeof(table_id), key.GetData(),
+                key.Size());
+  }
+  return cache_key;
+}
+
+RowCache::Shard &RowCache::GetShard(const std::string &cache_key) {
+  return shards_[Hash64(std::string_view(cache_key)) % kShardCount];
+}
+
+void RowCache::EvictIfNeeded(Shard &shard) {
+  while (shard.usage > capacity_per_shard_ && !shard.lru.empty()) {
+    auto &victim = shard.lru.back();
+    shard.usage -= victim.key.size() + victim.row.size() + kEntryOverhead;
+    shard.index.erase(victim.key);
+    shard.lru.pop_back();
+  }
+}
+
+bool RowCache::Lookup(uint64_t table_id, const Slice &key, Slice *row) {
+  auto cache_key = MakeKey(table_id, key);
+  auto &shard = GetShard(cache_key);
+  std::lock_guard lock(shard.mutex);
+  auto it = shard.index.find(cache_key);
+  if (it == shard.index.end()) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  // 命中后移到 LRU 头部
+  shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+  *row = Slice{it->second->row};
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void RowCache::InsertIfUnchanged(uint64_t table_id, const Slice &key,
+                                 const Slice &row,
+                                 const std::atomic<uint64_t> &write_seq,
+                                 uint64_t observed_seq) {
+  auto cache_key = MakeKey(table_id, key);
+  size_t charge = cache_key.size() + row.Size() + kEntryOverhead;
+  if (charge > capacity_per_shard_) {
+    return;
+  }
+  auto &shard = GetShard(cache_key);
+  std::lock_guard lock(shard.mutex);
+  // 在分片锁内检查写序号：写入方递增序号后才会来抢同一把锁执行 Erase
+  if (write_seq.load(std::memory_order_acquire) != observed_seq) {
+    return;
+  }
+  auto it = shard.index.find(cache_key);
+  if (it != shard.index.end()) {
+    shard.usage -= it->second->key.size() + it->second->row.size() +
+                   kEntryOverhead;
+    shard.lru.erase(it->second);
+    shard.index.erase(it);
+  }
+  shard.lru.push_front(Entry{std::move(cache_key), row.ToString()});
+  shard.index.emplace(shard.lru.front().key, shard.lru.begin());
+  shard.usage += charge;
+  EvictIfNeeded(shard);
+}
+
+void RowCache::Erase(uint64_t table_id, const Slice &key) {
+  auto cache_key = MakeKey(table_id, key);
+  auto &shard = GetShard(cache_key);
+  std::lock_guard lock(shard.mutex);
+  auto it = shard.index.find(cache_key);
+  if (it == shard.index.end()) {
+    return;
+  }
+  shard.usage -=
+      it->second->key.size() + it->second->row.size() + kEntryOverhead;
+  shard.lru.erase(it->second);
+  shard.index.erase(it);
+}
+
+void RowCache::EraseTable(uint64_t table_id) {
+  for (auto &shard : shards_) {
+    std::lock_guard lock(shard.mutex);
+    for (auto it = shard.lru.begin(); it != shard.lru.end();) {
+      uint64_t id = 0;
+      std::memcpy(&id, it->key.data(), sizeof(id));
+      if (id != table_id) {
+        ++it;
+        continue;
+      }
+      shard.usage -= it->key.size() + it->row.size() + kEntryOverhead;
+      shard.index.erase(it->key);
+      it = shard.lru.erase(it);
+    }
+  }
+}
+
+size_t RowCache::Usage() {
+  size_t usage = 0;
+  for (auto &shard : shards_) {
+    std::lock_guard lock(shard.mutex);
+    usage += shard.usage;
+  }
+  return usage;
+}
+} // namespace DB
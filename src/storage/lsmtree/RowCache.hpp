@@ -0,0 +1,78 @@
+#pragma once
+
+#include "storage/lsmtree/Slice.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace DB {
+// 点查行缓存：按 (table, primary key) 缓存 SSTable 中还原出的行编码
+// 分片 LRU，每个分片独立加锁，按字节数限制容量
+class RowCache {
+  static constexpr size_t kShardCount = 16;
+  // 每个条目除 key/value 外的近似额外开销
+  static constexpr size_t kEntryOverhead = 64;
+
+  struct Entry {
+    std::string key;
+    std::string row;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::list<Entry> lru; // 头部最近使用
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+    size_t usage{0};
+  };
+
+  size_t capacity_per_shard_;
+  std::array<Shard, kShardCount> shards_;
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+
+  static std::string MakeKey(uint64_t table_id, const Slice &key);
+
+  Shard &GetShard(const std::string &cache_key);
+
+  // 调用方需持有 shard.mutex
+  void EvictIfNeeded(Shard &shard);
+
+public:
+  explicit RowCache(size_t capacity_bytes);
+
+  // 进程级共享缓存，容量为 ROW_CACHE_CAPACITY，为 0 时返回 nullptr
+  static std::shared_ptr<RowCache> Default();
+
+  // 为每个打开的表分配唯一 id，作为缓存 key 的前缀
+  static uint64_t NewTableId();
+
+  bool Lookup(uint64_t table_id, const Slice &key, Slice *row);
+
+  // 仅当 write_seq 仍等于 observed_seq 时插入，避免与并发写交错后缓存旧值
+  // 写入方需先递增 write_seq 再调用 Erase
+  void InsertIfUnchanged(uint64_t table_id, const Slice &key, const Slice &row,
+                         const std::atomic<uint64_t> &write_seq,
+                         uint64_t observed_seq);
+
+  void Erase(uint64_t table_id, const Slice &key);
+
+  // 删除某个表的全部条目
+  void EraseTable(uint64_t table_id);
+
+  size_t Usage();
+
+  uint64_t Hits() const { return hits_.load(std::memory_order_relaxed); }
+
+  uint64_t Misses() const { return misses_.load(std::memory_order_relaxed); }
+};
+
+using RowCacheRef = std::shared_ptr<RowCache>;
+} // namespace DB
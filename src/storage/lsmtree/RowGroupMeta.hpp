@@ -1,26 +1,90 @@
 #pragma once
 
 #include "common/Config.hpp"
+#include "storage/lsmtree/ColumnStatistics.hpp"
+#include "storage/lsmtree/LearnedKeyIndex.hpp"
+#include "storage/lsmtree/SparseKeyIndex.hpp"
 #include "type/ValueType.hpp"
 
 #include <cstdint>
 #include <cstring>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace DB {
+// v3 起 RowGroupMeta 末尾的扩展段类型，读取时跳过未知类型
+enum class RowGroupExtension : uint16_t {
+  SparseKeyIndex = 1,
+  LearnedKeyIndex = 2,
+  ColumnFilters = 3,
+  PageIndex = 4,
+  ColumnAggregates = 5,
+  ColumnStatistics = 6,
+};
+
+// 列数据编码方式，v4 起记录在 ColumnChunkMeta 中
+enum class ColumnEncoding : uint8_t {
+  Plain = 0,               // 定长数组 / offsets + data
+  Dictionary = 1,          // 有序字典 + 定宽编码，仅 String 列
+  BitPacked = 2,           // FOR + bit-packing，仅 Int 列
+  RunLength = 3,           // run-length，Int / Double 列
+  DictionaryRunLength = 4, // 有序字典 + run-length 编码，仅 String 列
+  Gorilla = 5,             // XOR 浮点编码，仅声明了 GORILLA 的 Double 列
+};
+
+// 列数据块的通用压缩算法，v5 起记录在 ColumnChunkMeta 中
+enum class ColumnCodec : uint8_t {
+  None = 0,
+  LZ4 = 1,
+  Zstd = 2,
+};
+
+inline bool IsDictionaryEncoding(ColumnEncoding encoding) {
+  return encoding == ColumnEncoding::Dictionary ||
+         encoding == ColumnEncoding::DictionaryRunLength;
+}
+
+// 字典编码的编码宽度：不超过 256 项用 u8，否则 u16
+inline uint32_t DictionaryCodeWidth(uint32_t dict_count) {
+  return dict_count <= 256 ? sizeof(uint8_t) : sizeof(uint16_t);
+}
+
 struct ZoneMap {
   bool has_value = false;
   std::string min;
   std::string max;
 };
 
+// 页级统计：列数据块按 RowGroupMeta::page_rows 行分页
+struct PageZoneMap {
+  uint32_t null_count = 0;
+  ZoneMap zone;
+};
+
 struct ColumnChunkMeta {
   uint32_t offset = 0;
   uint32_t size = 0;
   ZoneMap zone;
   bool has_nulls = false;
+  ColumnEncoding encoding = ColumnEncoding::Plain;
+  // 压缩时 offset / size 为压缩后的数据，uncompressed_size 为解压后的字节数
+  ColumnCodec codec = ColumnCodec::None;
+  uint32_t uncompressed_size = 0;
+  // v6 起：磁盘上 [offset, offset + size) 的 CRC32C
+  uint32_t checksum = 0;
+  // 声明了 BLOOM 的列的值过滤器，类型与主键过滤器相同，为空表示没有
+  std::string filter;
+  // 页索引，为空表示没有
+  std::vector<PageZoneMap> pages;
+  // 预聚合（仅 Int / Double 列）：非 NULL 行数与和，数值列的 zone 即精确
+  // min / max
+  bool has_aggregate = false;
+  uint32_t non_null_count = 0;
+  double sum = 0.0;
+  // 基数 sketch 与直方图，row_count 为 0 表示没有
+  ColumnStatistics stats;
 };
 
 struct RowGroupMeta {
@@ -32,6 +96,144 @@ struct RowGroupMeta {
   // 新增：key 列的偏移和大小（相对于 RowGroup 数据起始）
   uint32_t key_column_offset = 0;
   uint32_t key_column_size = 0;
+  // v6 起各列块与 Key 列带 CRC32C，旧文件为 false
+  bool has_checksums = false;
+  uint32_t key_column_checksum = 0;
+  // int 主键的稀疏索引（仅内存布局，序列化为扩展段）
+  SparseKeyIndex key_index;
+  // int 主键的 learned index，与稀疏索引二选一
+  LearnedKeyIndex learned_index;
+  // 页索引每页的行数，0 表示没有页索引
+  uint32_t page_rows = 0;
+
+  uint32_t PageCount() const {
+    return page_rows == 0 ? 0 : (row_count + page_rows - 1) / page_rows;
+  }
+
+  // ZoneMap 按列类型序列化：has_value (u8) + 定长 min / max 或
+  // 长度加字节的字符串前缀
+  static void SerializeZone(ValueType::Type type, const ZoneMap &zone,
+                            std::string &out) {
+    auto append = [&](const auto &v) {
+      out.append(reinterpret_cast<const char *>(&v), sizeof(v));
+    };
+    uint8_t has_value = zone.has_value ? 1 : 0;
+    append(has_value);
+    switch (type) {
+    case ValueType::Type::Int: {
+      // 数值 zonemap 使用定长二进制
+      int v_min = 0;
+      int v_max = 0;
+      if (zone.has_value && zone.min.size() == sizeof(int) &&
+          zone.max.size() == sizeof(int)) {
+        std::memcpy(&v_min, zone.min.data(), sizeof(int));
+        std::memcpy(&v_max, zone.max.data(), sizeof(int));
+      }
+      append(v_min);
+      append(v_max);
+      break;
+    }
+    case ValueType::Type::Double: {
+      // 数值 zonemap 使用定长二进制
+      double v_min = 0.0;
+      double v_max = 0.0;
+      if (zone.has_value && zone.min.size() == sizeof(double) &&
+          zone.max.size() == sizeof(double)) {
+        std::memcpy(&v_min, zone.min.data(), sizeof(double));
+        std::memcpy(&v_max, zone.max.data(), sizeof(double));
+      }
+      append(v_min);
+      append(v_max);
+      break;
+    }
+    case ValueType::Type::String: {
+      // 字符串 zonemap 以长度加字节保存
+      uint16_t min_len = 0;
+      uint16_t max_len = 0;
+      if (zone.has_value) {
+        min_len = static_cast<uint16_t>(zone.min.size());
+        max_len = static_cast<uint16_t>(zone.max.size());
+      }
+      append(min_len);
+      if (min_len > 0) {
+        out.append(zone.min.data(), min_len);
+      }
+      append(max_len);
+      if (max_len > 0) {
+        out.append(zone.max.data(), max_len);
+      }
+      break;
+    }
+    case ValueType::Type::Null: break;
+    }
+  }
+
+  static bool DeserializeZone(const Byte *&p, const Byte *end,
+                              ValueType::Type type, ZoneMap &zone) {
+    auto read = [&](auto &v) {
+      if (p + sizeof(v) > end) {
+        return false;
+      }
+      std::memcpy(&v, p, sizeof(v));
+      p += sizeof(v);
+      return true;
+    };
+    uint8_t has_value = 0;
+    if (!read(has_value)) {
+      return false;
+    }
+    zone.has_value = has_value != 0;
+    switch (type) {
+    case ValueType::Type::Int: {
+      // 数值 zonemap 固定长度读取
+      int v_min = 0;
+      int v_max = 0;
+      if (!read(v_min) || !read(v_max)) {
+        return false;
+      }
+      if (zone.has_value) {
+        zone.min.assign(reinterpret_cast<const char *>(&v_min),
+                        sizeof(v_min));
+        zone.max.assign(reinterpret_cast<const char *>(&v_max),
+                        sizeof(v_max));
+      }
+      break;
+    }
+    case ValueType::Type::Double: {
+      // 数值 zonemap 固定长度读取
+      double v_min = 0.0;
+      double v_max = 0.0;
+      if (!read(v_min) || !read(v_max)) {
+        return false;
+      }
+      if (zone.has_value) {
+        zone.min.assign(reinterpret_cast<const char *>(&v_min),
+                        sizeof(v_min));
+        zone.max.assign(reinterpret_cast<const char *>(&v_max),
+                        sizeof(v_max));
+      }
+      break;
+    }
+    case ValueType::Type::String: {
+      // 字符串 zonemap 读出长度和字节
+      uint16_t min_len = 0;
+      uint16_t max_len = 0;
+      if (!read(min_len) || p + min_len > end) {
+        return false;
+      }
+      zone.min.assign(reinterpret_cast<const char *>(p), min_len);
+      p += min_len;
+      if (!read(max_len) || p + max_len > end) {
+        return false;
+      }
+      zone.max.assign(reinterpret_cast<const char *>(p), max_len);
+      p += max_len;
+      break;
+    }
+    case ValueType::Type::Null: break;
+    }
+    return true;
+  }
 
   void Serialize(const std::vector<std::shared_ptr<ValueType>> &types,
                  std::string &out) const {
@@ -46,57 +248,15 @@ struct RowGroupMeta {
       const auto &col = columns[i];
       append(col.offset);
       append(col.size);
-      uint8_t has_value = col.zone.has_value ? 1 : 0;
-      append(has_value);
-      switch (types[i]->GetType()) {
-      case ValueType::Type::Int: {
-        // 数值 zonemap 使用定长二进制
-        int v_min = 0;
-        int v_max = 0;
-        if (col.zone.has_value && col.zone.min.size() == sizeof(int) &&
-            col.zone.max.size() == sizeof(int)) {
-          std::memcpy(&v_min, col.zone.min.data(), sizeof(int));
-          std::memcpy(&v_max, col.zone.max.data(), sizeof(int));
-        }
-        append(v_min);
-        append(v_max);
-        break;
-      }
-      case ValueType::Type::Double: {
-        // 数值 zonemap 使用定长二进制
-        double v_min = 0.0;
-        double v_max = 0.0;
-        if (col.zone.has_value && col.zone.min.size() == sizeof(double) &&
-            col.zone.max.size() == sizeof(double)) {
-          std::memcpy(&v_min, col.zone.min.data(), sizeof(double));
-          std::memcpy(&v_max, col.zone.max.data(), sizeof(double));
-        }
-        append(v_min);
-        append(v_max);
-        break;
-      }
-      case ValueType::Type::String: {
-        // 字符串 zonemap 以长度加字节保存
-        uint16_t min_len = 0;
-        uint16_t max_len = 0;
-        if (col.zone.has_value) {
-          min_len = static_cast<uint16_t>(col.zone.min.size());
-          max_len = static_cast<uint16_t>(col.zone.max.size());
-        }
-        append(min_len);
-        if (min_len > 0) {
-          out.append(col.zone.min.data(), min_len);
-        }
-        append(max_len);
-        if (max_len > 0) {
-          out.append(col.zone.max.data(), max_len);
-        }
-        break;
-      }
-      case ValueType::Type::Null: break;
-      }
+      SerializeZone(types[i]->GetType(), col.zone, out);
       uint8_t col_has_nulls = col.has_nulls ? 1 : 0;
       append(col_has_nulls);
+      append(static_cast<uint8_t>(col.encoding));
+      append(static_cast<uint8_t>(col.codec));
+      if (col.codec != ColumnCodec::None) {
+        append(col.uncompressed_size);
+      }
+      append(col.checksum);
     }
 
     uint32_t bloom_size = static_cast<uint32_t>(bloom.size());
@@ -113,11 +273,241 @@ struct RowGroupMeta {
     // 新增：key 列偏移和大小
     append(key_column_offset);
     append(key_column_size);
+    append(key_column_checksum);
+
+    // 扩展段：u16 数量 + 若干 {u16 tag, u32 len, data}
+    std::vector<std::pair<RowGroupExtension, std::string>> extensions;
+    if (!key_index.Empty()) {
+      std::string blob;
+      key_index.Serialize(blob);
+      extensions.emplace_back(RowGroupExtension::SparseKeyIndex,
+                              std::move(blob));
+    }
+    if (!learned_index.Empty()) {
+      std::string blob;
+      learned_index.Serialize(blob);
+      extensions.emplace_back(RowGroupExtension::LearnedKeyIndex,
+                              std::move(blob));
+    }
+    // 列过滤器：u16 数量 + 若干 {u16 列号, u32 长度, data}
+    std::string filters;
+    uint16_t filter_count = 0;
+    for (size_t i = 0; i < columns.size(); i++) {
+      if (columns[i].filter.empty()) {
+        continue;
+      }
+      auto col_idx = static_cast<uint16_t>(i);
+      auto filter_size = static_cast<uint32_t>(columns[i].filter.size());
+      filters.append(reinterpret_cast<const char *>(&col_idx),
+                     sizeof(col_idx));
+      filters.append(reinterpret_cast<const char *>(&filter_size),
+                     sizeof(filter_size));
+      filters.append(columns[i].filter);
+      filter_count++;
+    }
+    if (filter_count > 0) {
+      std::string blob(reinterpret_cast<const char *>(&filter_count),
+                       sizeof(filter_count));
+      blob.append(filters);
+      extensions.emplace_back(RowGroupExtension::ColumnFilters,
+                              std::move(blob));
+    }
+    // 页索引：page_rows (u32) + 各列依次 {null_count (u32), ZoneMap}[页数]
+    if (page_rows > 0) {
+      std::string blob(reinterpret_cast<const char *>(&page_rows),
+                       sizeof(page_rows));
+      for (size_t i = 0; i < columns.size(); i++) {
+        for (const auto &page : columns[i].pages) {
+          blob.append(reinterpret_cast<const char *>(&page.null_count),
+                      sizeof(page.null_count));
+          SerializeZone(types[i]->GetType(), page.zone, blob);
+        }
+      }
+      extensions.emplace_back(RowGroupExtension::PageIndex, std::move(blob));
+    }
+    // 预聚合：u16 数量 + 若干 {u16 列号, u32 非 NULL 行数, f64 和}
+    std::string aggregates;
+    uint16_t aggregate_count = 0;
+    for (size_t i = 0; i < columns.size(); i++) {
+      if (!columns[i].has_aggregate) {
+        continue;
+      }
+      auto col_idx = static_cast<uint16_t>(i);
+      aggregates.append(reinterpret_cast<const char *>(&col_idx),
+                        sizeof(col_idx));
+      aggregates.append(
+          reinterpret_cast<const char *>(&columns[i].non_null_count),
+          sizeof(columns[i].non_null_count));
+      aggregates.append(reinterpret_cast<const char *>(&columns[i].sum),
+                        sizeof(columns[i].sum));
+      aggregate_count++;
+    }
+    if (aggregate_count > 0) {
+      std::string blob(reinterpret_cast<const char *>(&aggregate_count),
+                       sizeof(aggregate_count));
+      blob.append(aggregates);
+      extensions.emplace_back(RowGroupExtension::ColumnAggregates,
+                              std::move(blob));
+    }
+    // 列统计：u16 数量 + 若干 {u16 列号, u32 NULL 行数, HyperLogLog,
+    // Histogram}
+    std::string stats;
+    uint16_t stats_count = 0;
+    for (size_t i = 0; i < columns.size(); i++) {
+      const auto &col_stats = columns[i].stats;
+      if (col_stats.Empty()) {
+        continue;
+      }
+      auto col_idx = static_cast<uint16_t>(i);
+      auto null_count = static_cast<uint32_t>(col_stats.null_count);
+      stats.append(reinterpret_cast<const char *>(&col_idx), sizeof(col_idx));
+      stats.append(reinterpret_cast<const char *>(&null_count),
+                   sizeof(null_count));
+      col_stats.distinct.Serialize(stats);
+      col_stats.histogram.Serialize(stats);
+      stats_count++;
+    }
+    if (stats_count > 0) {
+      std::string blob(reinterpret_cast<const char *>(&stats_count),
+                       sizeof(stats_count));
+      blob.append(stats);
+      extensions.emplace_back(RowGroupExtension::ColumnStatistics,
+                              std::move(blob));
+    }
+    uint16_t ext_count = static_cast<uint16_t>(extensions.size());
+    append(ext_count);
+    for (const auto &[tag, blob] : extensions) {
+      uint16_t ext_tag = static_cast<uint16_t>(tag);
+      uint32_t ext_len = static_cast<uint32_t>(blob.size());
+      append(ext_tag);
+      append(ext_len);
+      out.append(blob);
+    }
+  }
+
+  static bool DeserializeColumnFilters(const Byte *p, const Byte *end,
+                                       RowGroupMeta &out) {
+    auto read = [&](auto &v) {
+      if (p + sizeof(v) > end) {
+        return false;
+      }
+      std::memcpy(&v, p, sizeof(v));
+      p += sizeof(v);
+      return true;
+    };
+    uint16_t count = 0;
+    if (!read(count)) {
+      return false;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+      uint16_t col_idx = 0;
+      uint32_t filter_size = 0;
+      if (!read(col_idx) || !read(filter_size) || p + filter_size > end ||
+          col_idx >= out.columns.size()) {
+        return false;
+      }
+      out.columns[col_idx].filter.assign(reinterpret_cast<const char *>(p),
+                                         filter_size);
+      p += filter_size;
+    }
+    return true;
+  }
+
+  static bool DeserializeColumnAggregates(const Byte *p, const Byte *end,
+                                          RowGroupMeta &out) {
+    auto read = [&](auto &v) {
+      if (p + sizeof(v) > end) {
+        return false;
+      }
+      std::memcpy(&v, p, sizeof(v));
+      p += sizeof(v);
+      return true;
+    };
+    uint16_t count = 0;
+    if (!read(count)) {
+      return false;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+      uint16_t col_idx = 0;
+      uint32_t non_null_count = 0;
+      double sum = 0.0;
+      if (!read(col_idx) || !read(non_null_count) || !read(sum) ||
+          col_idx >= out.columns.size()) {
+        return false;
+      }
+      auto &col = out.columns[col_idx];
+      col.has_aggregate = true;
+      col.non_null_count = non_null_count;
+      col.sum = sum;
+    }
+    return true;
+  }
+
+  static bool DeserializeColumnStatistics(const Byte *p, const Byte *end,
+                                          RowGroupMeta &out) {
+    auto read = [&](auto &v) {
+      if (p + sizeof(v) > end) {
+        return false;
+      }
+      std::memcpy(&v, p, sizeof(v));
+      p += sizeof(v);
+      return true;
+    };
+    uint16_t count = 0;
+    if (!read(count)) {
+      return false;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+      uint16_t col_idx = 0;
+      uint32_t null_count = 0;
+      if (!read(col_idx) || !read(null_count) ||
+          col_idx >= out.columns.size()) {
+        return false;
+      }
+      auto &stats = out.columns[col_idx].stats;
+      stats.row_count = out.row_count;
+      stats.null_count = null_count;
+      if (!stats.distinct.Deserialize(p, end) ||
+          !stats.histogram.Deserialize(p, end)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static bool
+  DeserializePageIndex(const Byte *p, const Byte *end,
+                       const std::vector<std::shared_ptr<ValueType>> &types,
+                       RowGroupMeta &out) {
+    if (p + sizeof(out.page_rows) > end) {
+      return false;
+    }
+    std::memcpy(&out.page_rows, p, sizeof(out.page_rows));
+    p += sizeof(out.page_rows);
+    if (out.page_rows == 0) {
+      return false;
+    }
+    uint32_t page_count = out.PageCount();
+    for (size_t i = 0; i < out.columns.size(); i++) {
+      auto &pages = out.columns[i].pages;
+      pages.resize(page_count);
+      for (auto &page : pages) {
+        if (p + sizeof(page.null_count) > end) {
+          return false;
+        }
+        std::memcpy(&page.null_count, p, sizeof(page.null_count));
+        p += sizeof(page.null_count);
+        if (!DeserializeZone(p, end, types[i]->GetType(), page.zone)) {
+          return false;
+        }
+      }
+    }
+    return true;
   }
 
   static bool Deserialize(const Byte *&p, const Byte *end,
                           const std::vector<std::shared_ptr<ValueType>> &types,
-                          RowGroupMeta &out) {
+                          uint16_t version, RowGroupMeta &out) {
     // 按固定顺序解码 RowGroup 元数据
     auto read = [&](auto &v) {
       if (p + sizeof(v) > end) {
@@ -141,75 +531,39 @@ struct RowGroupMeta {
       if (!read(col.offset) || !read(col.size)) {
         return false;
       }
-      uint8_t has_value = 0;
-      if (!read(has_value)) {
+      if (!DeserializeZone(p, end, types[i]->GetType(), col.zone)) {
         return false;
       }
-      col.zone.has_value = has_value != 0;
-      switch (types[i]->GetType()) {
-      case ValueType::Type::Int: {
-        // 数值 zonemap 固定长度读取
-        int v_min = 0;
-        int v_max = 0;
-        if (!read(v_min) || !read(v_max)) {
-          return false;
-        }
-        if (col.zone.has_value) {
-          col.zone.min.assign(reinterpret_cast<const char *>(&v_min),
-                              sizeof(v_min));
-          col.zone.max.assign(reinterpret_cast<const char *>(&v_max),
-                              sizeof(v_max));
-        }
-        break;
+      uint8_t col_has_nulls = 0;
+      if (!read(col_has_nulls)) {
+        return false;
       }
-      case ValueType::Type::Double: {
-        // 数值 zonemap 固定长度读取
-        double v_min = 0.0;
-        double v_max = 0.0;
-        if (!read(v_min) || !read(v_max)) {
+      col.has_nulls = col_has_nulls != 0;
+      // v4 起记录列编码，旧版本均为 Plain
+      if (version >= 4) {
+        uint8_t encoding = 0;
+        if (!read(encoding) ||
+            encoding > static_cast<uint8_t>(ColumnEncoding::Gorilla)) {
           return false;
         }
-        if (col.zone.has_value) {
-          col.zone.min.assign(reinterpret_cast<const char *>(&v_min),
-                              sizeof(v_min));
-          col.zone.max.assign(reinterpret_cast<const char *>(&v_max),
-                              sizeof(v_max));
-        }
-        break;
+        col.encoding = static_cast<ColumnEncoding>(encoding);
       }
-      case ValueType::Type::String: {
-        // 字符串 zonemap 读出长度和字节
-        uint16_t min_len = 0;
-        uint16_t max_len = 0;
-        if (!read(min_len)) {
-          return false;
-        }
-        if (p + min_len > end) {
+      // v5 起记录压缩算法，压缩的列再带解压后大小
+      if (version >= 5) {
+        uint8_t codec = 0;
+        if (!read(codec) || codec > static_cast<uint8_t>(ColumnCodec::Zstd)) {
           return false;
         }
-        if (min_len > 0) {
-          col.zone.min.assign(reinterpret_cast<const char *>(p), min_len);
-          p += min_len;
-        }
-        if (!read(max_len)) {
+        col.codec = static_cast<ColumnCodec>(codec);
+        if (col.codec != ColumnCodec::None &&
+            !read(col.uncompressed_size)) {
           return false;
         }
-        if (p + max_len > end) {
-          return false;
-        }
-        if (max_len > 0) {
-          col.zone.max.assign(reinterpret_cast<const char *>(p), max_len);
-          p += max_len;
-        }
-        break;
       }
-      case ValueType::Type::Null: break;
-      }
-      uint8_t col_has_nulls = 0;
-      if (!read(col_has_nulls)) {
+      // v6 起记录列块校验和
+      if (version >= 6 && !read(col.checksum)) {
         return false;
       }
-      col.has_nulls = col_has_nulls != 0;
       out.columns.emplace_back(std::move(col));
     }
 
@@ -240,6 +594,60 @@ struct RowGroupMeta {
     if (!read(out.key_column_size)) {
       return false;
     }
+    out.has_checksums = version >= 6;
+    if (out.has_checksums && !read(out.key_column_checksum)) {
+      return false;
+    }
+
+    // v2 没有扩展段
+    if (version < 3) {
+      return true;
+    }
+    uint16_t ext_count = 0;
+    if (!read(ext_count)) {
+      return false;
+    }
+    for (uint16_t i = 0; i < ext_count; i++) {
+      uint16_t ext_tag = 0;
+      uint32_t ext_len = 0;
+      if (!read(ext_tag) || !read(ext_len) || p + ext_len > end) {
+        return false;
+      }
+      switch (static_cast<RowGroupExtension>(ext_tag)) {
+      case RowGroupExtension::SparseKeyIndex:
+        if (!out.key_index.Deserialize(p, ext_len)) {
+          return false;
+        }
+        break;
+      case RowGroupExtension::LearnedKeyIndex:
+        if (!out.learned_index.Deserialize(p, ext_len)) {
+          return false;
+        }
+        break;
+      case RowGroupExtension::ColumnFilters:
+        if (!DeserializeColumnFilters(p, p + ext_len, out)) {
+          return false;
+        }
+        break;
+      case RowGroupExtension::PageIndex:
+        if (!DeserializePageIndex(p, p + ext_len, types, out)) {
+          return false;
+        }
+        break;
+      case RowGroupExtension::ColumnAggregates:
+        if (!DeserializeColumnAggregates(p, p + ext_len, out)) {
+          return false;
+        }
+        break;
+      case RowGroupExtension::ColumnStatistics:
+        if (!DeserializeColumnStatistics(p, p + ext_len, out)) {
+          return false;
+        }
+        break;
+      default: break;
+      }
+      p += ext_len;
+    }
     return true;
   }
 };
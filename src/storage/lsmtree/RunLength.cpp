@@ -0,0 +1,40 @@
+#include "storage/lsmtree/RunLength.hpp"
+
+namespace DB {
+uint32_t CountRuns(const Byte *values, uint32_t count, size_t width) {
+  if (count == 0) {
+    return 0;
+  }
+  uint32_t runs = 1;
+  for (uint32_t i = 1; i < count; i++) {
+    if (std::memcmp(values + i * width, values + (i - 1) * width, width) != 0) {
+      runs++;
+    }
+  }
+  return runs;
+}
+
+void RunLengthEncode(const Byte *values, uint32_t count, size_t width,
+                     std::string &out) {
+  uint32_t runs = CountRuns(values, count, width);
+  size_t begin = out.size();
+  out.resize(begin + RunLengthSize(runs, width));
+  char *header = out.data() + begin;
+  char *ends = header + sizeof(uint32_t);
+  char *run_values = ends + static_cast<size_t>(runs) * sizeof(uint32_t);
+  std::memcpy(header, &runs, sizeof(runs));
+
+  uint32_t run = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    const Byte *v = values + i * width;
+    if (i + 1 < count && std::memcmp(v, v + width, width) == 0) {
+      continue;
+    }
+    // i 是当前 run 的最后一行
+    uint32_t end = i + 1;
+    std::memcpy(ends + run * sizeof(uint32_t), &end, sizeof(end));
+    std::memcpy(run_values + run * width, v, width);
+    run++;
+  }
+}
+} // namespace DB
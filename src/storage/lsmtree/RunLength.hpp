@@ -0,0 +1,74 @@
+#pragma once
+
+#include "common/Config.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace DB {
+// clang-format off
+// 定长值的 run-length 编码，用于 Int / Double 列及字典编码 String 列的编码区
+//
+//   [run_count u32][run_end u32 × run_count][value × run_count]
+//
+// run_end 为该 run 的结束行（不含），单调递增，最后一个等于行数；
+// value 为该 run 的值，按位比较（double 的 -0.0 与 0.0 视为不同的 run）
+// NULL 行按 0 参与编码，读取时以 null bitmap 为准
+// clang-format on
+
+// 统计 count 个 width 字节定长值的 run 数
+uint32_t CountRuns(const Byte *values, uint32_t count, size_t width);
+
+// runs 个 run 编码后的字节数
+inline size_t RunLengthSize(uint32_t runs, size_t width) {
+  return sizeof(uint32_t) +
+         static_cast<size_t>(runs) * (sizeof(uint32_t) + width);
+}
+
+// 编码 count 个值并追加到 out
+void RunLengthEncode(const Byte *values, uint32_t count, size_t width,
+                     std::string &out);
+
+// 已编码数据的只读视图，data 指向编码区起始
+class RunLengthView {
+  uint32_t runs_{0};
+  const uint32_t *ends_{nullptr};
+  const Byte *values_{nullptr};
+  size_t width_{0};
+
+public:
+  RunLengthView(const Byte *data, size_t width) : width_(width) {
+    std::memcpy(&runs_, data, sizeof(runs_));
+    ends_ = reinterpret_cast<const uint32_t *>(data + sizeof(runs_));
+    values_ = reinterpret_cast<const Byte *>(ends_ + runs_);
+  }
+
+  uint32_t RunCount() const { return runs_; }
+
+  const uint32_t *RunEnds() const { return ends_; }
+
+  uint32_t RunBegin(uint32_t run) const {
+    return run == 0 ? 0 : ends_[run - 1];
+  }
+
+  uint32_t RunEnd(uint32_t run) const { return ends_[run]; }
+
+  // 第 run 个 run 的值所在地址
+  const Byte *ValuePtr(uint32_t run) const { return values_ + run * width_; }
+
+  template <typename T> T Value(uint32_t run) const {
+    T v{};
+    std::memcpy(&v, ValuePtr(run), sizeof(T));
+    return v;
+  }
+
+  // 二分定位 row 所在的 run
+  uint32_t FindRun(uint32_t row) const {
+    return static_cast<uint32_t>(std::upper_bound(ends_, ends_ + runs_, row) -
+                                 ends_);
+  }
+};
+} // namespace DB
@@ -0,0 +1,92 @@
+#include "storage/lsmtree/SSTable.hpp"
+#include "common/Logger.hpp"
+#include "fmt/format.h"
+#include "storage/lsmtree/Crc32c.hpp"
+
+#include <cstring>
+
+namespace DB {
+void SSTable::ResetChecksumState() {
+  size_t count = rowgroups_.size() * (column_count_ + size_t{1});
+  chunk_verified_ = std::make_unique<std::atomic<uint8_t>[]>(count);
+}
+
+bool SSTable::VerifyChunk(size_t rg_idx, size_t col_idx) const {
+  const auto &rg = rowgroups_[rg_idx];
+  if (!rg.has_checksums) {
+    return true;
+  }
+  std::atomic<uint8_t> *state = nullptr;
+  if (chunk_verified_) {
+    state = &chunk_verified_[rg_idx * (column_count_ + size_t{1}) + col_idx];
+    uint8_t verified = state->load(std::memory_order_acquire);
+    if (verified != 0) {
+      return verified == 1;
+    }
+  }
+  bool key_column = col_idx == rg.columns.size();
+  uint32_t offset = key_column ? rg.key_column_offset
+                               : rg.columns[col_idx].offset;
+  uint32_t size =
+      key_column ? rg.key_column_size : rg.columns[col_idx].size;
+  uint32_t expected = key_column ? rg.key_column_checksum
+                                 : rg.columns[col_idx].checksum;
+  size_t begin = static_cast<size_t>(rg.offset) + offset;
+  bool ok = data_file_ && data_file_->Valid() &&
+            begin + size <= data_file_->Size() &&
+            Crc32c(data_file_->Data() + begin, size) == expected;
+  ChecksumStats::verified_chunks.fetch_add(1, std::memory_order_relaxed);
+  ChecksumStats::verified_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (!ok) {
+    ChecksumStats::mismatches.fetch_add(1, std::memory_order_relaxed);
+    LOG_ERROR("SSTable {} checksum mismatch: rowgroup={}, column={}",
+              sstable_id_, rg_idx, col_idx);
+  }
+  if (state) {
+    state->store(ok ? 1 : 2, std::memory_order_release);
+  }
+  return ok;
+}
+
+Status SSTable::VerifyChecksums() const {
+  for (size_t rg_idx = 0; rg_idx < rowgroups_.size(); rg_idx++) {
+    for (size_t col_idx = 0; col_idx <= rowgroups_[rg_idx].columns.size();
+         col_idx++) {
+      if (!VerifyChunk(rg_idx, col_idx)) {
+        return Status::Error(
+            ErrorCode::IOError,
+            fmt::format("SSTable {} rowgroup {} column {} corrupted",
+                        sstable_id_, rg_idx, col_idx));
+      }
+    }
+  }
+  return Status::OK();
+}
+
+void SSTable::DetectKeyOrder(ValueType::Type pk_type) {
+  key_ordered_ = true;
+  if (pk_type != ValueType::Type::Int) {
+    return;
+  }
+  int prev_max = 0;
+  bool has_prev = false;
+  for (const auto &rg : rowgroups_) {
+    if (primary_key_idx_ >= rg.columns.size()) {
+      return;
+    }
+    const auto &zone = rg.columns[primary_key_idx_].zone;
+    if (!zone.has_value || zone.min.size() != sizeof(int) ||
+        zone.max.size() != sizeof(int)) {
+      continue;
+    }
+    int min = 0;
+    std::memcpy(&min, zone.min.data(), sizeof(min));
+    if (has_prev && prev_max >= min) {
+      key_ordered_ = false;
+      return;
+    }
+    std::memcpy(&prev_max, zone.max.data(), sizeof(prev_max));
+    has_prev = true;
+  }
+}
+} // namespace DB
@@ -1,9 +1,14 @@
 #pragma once
 
+#include "common/Status.hpp"
 #include "storage/MMapFile.hpp"
+#include "storage/lsmtree/ChunkCache.hpp"
+#include "storage/lsmtree/KeyFilter.hpp"
 #include "storage/lsmtree/RowGroupMeta.hpp"
+#include "type/ValueType.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <sys/types.h>
@@ -22,6 +27,8 @@ namespace DB {
 // ├─────────────────────────────────────┤  offset: meta_offset
 // │        元数据区 (Metadata)           │
 // │  RowGroupMeta[0] ... RowGroupMeta[N]│
+// ├─────────────────────────────────────┤  offset: meta_offset + meta_size
+// │   meta_checksum (u32, v6)           │
 // ├─────────────────────────────────────┤  offset: file_size - 28
 // │          Footer (28 bytes)          │
 // └─────────────────────────────────────┘
@@ -34,6 +41,8 @@ namespace DB {
 // ┌──────────────────────────────────────────────┐
 // │ Column[0] | Column[1] | ... | Column[N]      │
 // ├──────────────────────────────────────────────┤
+// │ Key 列 (定长主键按行连续存放)                  │
+// ├──────────────────────────────────────────────┤
 // │ Padding (填充到 4KB 对齐)                     │
 // └──────────────────────────────────────────────┘
 //
@@ -56,6 +65,33 @@ namespace DB {
 //   └───────────┴───────────┴─────┴─────────────┴──────────────────┘
 //   (通过 offset[i+1] - offset[i] 计算第 i 行字符串长度)
 //
+//   String 列 (Dictionary 编码, D = 字典项数):
+//   ┌──────────┬──────────────────────┬───────────┬─────────────────────┐
+//   │ D (u32)  │ dict_offset[D+1] u32 │ dict data │ code[R] (u8 / u16)  │
+//   └──────────┴──────────────────────┴───────────┴─────────────────────┘
+//   字典按字节序排序，编码保序；D <= 256 时 code 为 u8，否则为 u16
+//
+//   Int 列 (BitPacked 编码): 每 1024 行一块的 FOR + bit-packing，
+//   块头与 lane 交错布局见 BitPacking.hpp
+//
+//   Int / Double 列 (RunLength 编码, N = run 数):
+//   ┌──────────┬────────────────────┬─────────────────────┐
+//   │ N (u32)  │ run_end[N] u32     │ value[N] (4 / 8 B)  │
+//   └──────────┴────────────────────┴─────────────────────┘
+//   run_end 为各 run 的结束行（不含），最后一个等于 R
+//
+//   String 列 (DictionaryRunLength 编码): 与 Dictionary 编码相同的字典，
+//   code 区改为上述 run-length 格式，value 为 u8 / u16 code
+//
+//   Double 列 (Gorilla 编码): 每 256 行一块的 XOR 编码，块起始 bit 偏移表
+//   后接 bit stream，格式见 Gorilla.hpp
+//
+//   有 NULL 的列在以上数据前附加 null bitmap ((R + 7) / 8 bytes)
+//
+//   v5 起非主键列可整块压缩 (LZ4 / Zstd)：null bitmap 与编码数据一起压缩，
+//   col.offset / col.size 指向压缩后的数据，读取时先解压再按编码解析；
+//   主键列与 Key 列始终不压缩
+//
 // ============================================================================
 //                         2. 元数据区 - RowGroupMeta
 // ============================================================================
@@ -72,13 +108,40 @@ namespace DB {
 // │     Int:    min (4B) + max (4B)                         │
 // │     Double: min (8B) + max (8B)                         │
 // │     String: min_len (u16) + min_data + max_len (u16) + max_data │
+// │   has_nulls     (u8)     是否有 null bitmap             │
+// │   encoding      (u8)     ColumnEncoding (v4)            │
+// │   codec         (u8)     ColumnCodec (v5)               │
+// │   raw_size      (u32)    解压后字节数，仅 codec != None │
+// │   checksum      (u32)    列块 CRC32C (v6)               │
 // ├─────────────────────────────────────────────────────────┤
-// │ bloom_size      (u32)    布隆过滤器字节数               │
-// │ bloom_data      (bloom_size bytes)                     │
+// │ bloom_size      (u32)    主键过滤器字节数               │
+// │ bloom_data      (bloom_size bytes) 类型见 footer        │
 // │ key_size        (u32)    最大主键字节数                  │
 // │ max_key         (key_size bytes)                        │
+// │ key_col_offset  (u32)    Key 列在 RowGroup 内的偏移      │
+// │ key_col_size    (u32)    Key 列字节数                    │
+// │ key_checksum    (u32)    Key 列 CRC32C (v6)              │
+// ├─────────────────────────────────────────────────────────┤
+// │ ext_count       (u16)    扩展段数量 (v3)                 │
+// ├────────────────────────── 重复 ext_count 次 ────────────┤
+// │   tag           (u16)    RowGroupExtension              │
+// │   len           (u32)    扩展数据字节数                  │
+// │   data          (len bytes)                             │
 // └────────────────────────────────────────────────────────┘
 //
+// 扩展段:
+//   SparseKeyIndex: interval (u32) + count (u32) + 每 interval 行采样的
+//                   int key[count]，加载后在内存中重排为 S-tree
+//   LearnedKeyIndex: epsilon (u32) + row_count (u32) + seg_count (u32) +
+//                    {first_key (i32), start_row (u32), slope (f64)}[seg_count]
+//                    与 SparseKeyIndex 二选一，取序列化后更小的一个
+//   ColumnFilters: count (u16) + {col_idx (u16), len (u32), data}[count]
+//                  声明 BLOOM 的列的值过滤器，类型见 footer
+//   PageIndex: page_rows (u32) + 各列依次 {null_count (u32), ZoneMap}[页数]
+//              页数 = ceil(row_count / page_rows)，ZoneMap 格式同列元数据；
+//              RowGroup 超过一页时写入，谓词扫描据此跳过不可能匹配的页
+//   未识别的扩展段按 len 跳过
+//
 // ============================================================================
 //                         3. Footer (固定 28 bytes)
 // ============================================================================
@@ -89,8 +152,8 @@ namespace DB {
 // │ rowgroup_count   (u32)  RowGroup 数量 │
 // │ column_count     (u16)  列数          │
 // │ primary_key_idx  (u16)  主键列索引    │
-// │ version          (u16)  版本号 = 1    │
-// │ reserved         (u16)  保留 = 0      │
+// │ version          (u16)  版本号 = 6    │
+// │ filter_type      (u16)  KeyFilterType │
 // │ magic            (u32)  0x5A4B5254    │
 // └──────────────────────────────────────┘
 //
@@ -99,18 +162,65 @@ namespace DB {
 // ============================================================================
 //
 // 1. 读 Footer (文件末尾 28 bytes) -> 得到 meta_offset, meta_size
-// 2. 读 Metadata (meta_offset 处) -> 反序列化所有 RowGroupMeta
+// 2. 读 Metadata (meta_offset 处) -> 校验 meta_checksum，
+//    反序列化所有 RowGroupMeta
 // 3. mmap 整个文件 -> 通过 RowGroupMeta.offset 直接访问数据
 //
+// 校验和: v6 起元数据区与每个列块（磁盘上的字节，压缩列为压缩后数据）、
+//         Key 列都带 CRC32C。元数据打开时校验；列块在首次访问时校验，
+//         结果按块缓存；compaction 读取输入前校验全部列块
+//
+// 聚簇文件: 底层 compaction 可按空间填充曲线把行重新分配到 RowGroup，
+//          RowGroup 内仍按主键有序，但 RowGroup 之间的主键范围会重叠。
+//          格式不变，打开时由主键 zone map 判断，点查按 zone 逐个筛选
+//          RowGroup，顺序迭代按主键归并各 RowGroup
+//
+// 兼容性: 可读取 v2（无扩展段）、v3（无列编码字段）、v4（无压缩字段）、
+//         v5（无校验和）和 v6 文件
+//         filter_type 原为保留字段，旧文件为 0 即 Bloom
+//
 // clang-format on
 
+inline constexpr uint32_t kSSTableMagic = 0x5A4B5254; // ZKRT
+inline constexpr uint16_t kSSTableVersion = 6;
+inline constexpr uint16_t kSSTableMinVersion = 2;
+
+// 进程级 CRC32C 校验计数
+struct ChecksumStats {
+  inline static std::atomic<uint64_t> verified_chunks{0};
+  inline static std::atomic<uint64_t> verified_bytes{0};
+  inline static std::atomic<uint64_t> mismatches{0};
+};
+
 struct SSTable {
   uint32_t sstable_id_;
+  // 进程内唯一，作为 ChunkCache 的 key（sstable_id_ 只在表内唯一）
+  uint64_t cache_id_{ChunkCache::NewFileId()};
   uint32_t rowgroup_count_{};
   uint16_t column_count_{};
   uint16_t primary_key_idx_{};
+  KeyFilterType filter_type_{KeyFilterType::Bloom};
   std::vector<RowGroupMeta> rowgroups_;
   std::shared_ptr<MMapFile> data_file_;
+  // 各块的校验状态，下标 rg_idx * (column_count_ + 1) + col_idx，
+  // col_idx == column_count_ 为 Key 列；0 未校验，1 通过，2 不匹配
+  std::unique_ptr<std::atomic<uint8_t>[]> chunk_verified_;
+  // RowGroup 之间按主键有序（max_key 可二分），聚簇文件为 false
+  bool key_ordered_{true};
+
+  // rowgroups_ 与 data_file_ 就绪后调用，清空校验状态
+  void ResetChecksumState();
+
+  // 校验一个块，结果缓存，之后的调用只读一次原子变量；
+  // 没有校验和的旧文件总是返回 true
+  bool VerifyChunk(size_t rg_idx, size_t col_idx) const;
+
+  // 校验全部列块与 Key 列，compaction 读取输入前调用
+  Status VerifyChecksums() const;
+
+  // rowgroups_ 就绪后调用，由 int 主键的 zone map 判断 key_ordered_，
+  // 其它主键类型不会聚簇
+  void DetectKeyOrder(ValueType::Type pk_type);
 };
 
 using SSTableRef = std::shared_ptr<SSTable>;
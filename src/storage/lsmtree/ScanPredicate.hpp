@@ -1,12 +1,18 @@
 #pragma once
 
+#include "common/Config.hpp"
 #include "function/FunctionComparison.hpp"
+#include "storage/lsmtree/KeyFilter.hpp"
 #include "storage/lsmtree/RowGroupMeta.hpp"
 #include "type/ValueType.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace DB {
 
@@ -88,4 +94,197 @@ inline bool ZoneMapMayMatch(const ZoneMap &zone, const ScanPredicate &pred) {
   return true;
 }
 
+// 列值过滤器裁剪：仅对 Equals 生效，过滤器判定不存在时可跳过 RowGroup
+inline bool ColumnFilterMayMatch(KeyFilterType filter_type,
+                                 const ColumnChunkMeta &col,
+                                 const ScanPredicate &pred) {
+  if (col.filter.empty() ||
+      pred.op != FunctionComparison::Operator::Equals) {
+    return true;
+  }
+  uint64_t hash = 0;
+  switch (pred.column_type) {
+  case ValueType::Type::Int:
+    hash = HashColumnValue(pred.column_type, &pred.const_int,
+                           sizeof(pred.const_int));
+    break;
+  case ValueType::Type::Double:
+    hash = HashColumnValue(pred.column_type, &pred.const_double,
+                           sizeof(pred.const_double));
+    break;
+  case ValueType::Type::String:
+    hash = HashColumnValue(pred.column_type, pred.const_string.data(),
+                           pred.const_string.size());
+    break;
+  default: return true;
+  }
+  return KeyFilterMayContain(filter_type, col.filter, hash);
+}
+
+// RowGroup 级裁剪：ZoneMap 与列值过滤器任一判定不匹配即可跳过
+inline bool RowGroupMayMatch(KeyFilterType filter_type, const RowGroupMeta &rg,
+                             const std::vector<ScanPredicate> &predicates) {
+  for (const auto &pred : predicates) {
+    if (pred.column_idx >= rg.columns.size()) {
+      continue;
+    }
+    const auto &col = rg.columns[pred.column_idx];
+    if (!ZoneMapMayMatch(col.zone, pred) ||
+        !ColumnFilterMayMatch(filter_type, col, pred)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 判断 RowGroup 中该列的所有值是否都满足谓词，仅数值列的 ZoneMap 是精确的
+// 列中有 NULL 时 NULL 行不满足任何谓词，返回 false
+inline bool ZoneMapAllMatch(const ColumnChunkMeta &col,
+                            const ScanPredicate &pred) {
+  if (col.has_nulls || !col.zone.has_value) {
+    return false;
+  }
+  using Op = FunctionComparison::Operator;
+  auto all_match = [&](auto zone_min, auto zone_max, auto c) {
+    switch (pred.op) {
+    case Op::Greater: return zone_min > c;
+    case Op::GreaterOrEquals: return zone_min >= c;
+    case Op::Less: return zone_max < c;
+    case Op::LessOrEquals: return zone_max <= c;
+    case Op::Equals: return zone_min == c && zone_max == c;
+    case Op::NotEquals: return zone_max < c || zone_min > c;
+    }
+    return false;
+  };
+  switch (pred.column_type) {
+  case ValueType::Type::Int: {
+    if (col.zone.min.size() != sizeof(int) ||
+        col.zone.max.size() != sizeof(int)) {
+      return false;
+    }
+    int zone_min = 0, zone_max = 0;
+    std::memcpy(&zone_min, col.zone.min.data(), sizeof(int));
+    std::memcpy(&zone_max, col.zone.max.data(), sizeof(int));
+    return all_match(zone_min, zone_max, pred.const_int);
+  }
+  case ValueType::Type::Double: {
+    if (col.zone.min.size() != sizeof(double) ||
+        col.zone.max.size() != sizeof(double)) {
+      return false;
+    }
+    double zone_min = 0.0, zone_max = 0.0;
+    std::memcpy(&zone_min, col.zone.min.data(), sizeof(double));
+    std::memcpy(&zone_max, col.zone.max.data(), sizeof(double));
+    return all_match(zone_min, zone_max, pred.const_double);
+  }
+  default: return false;
+  }
+}
+
+// RowGroup 的所有行都满足全部谓词时返回 true，此时可直接使用元数据
+inline bool RowGroupAllMatch(const RowGroupMeta &rg,
+                             const std::vector<ScanPredicate> &predicates) {
+  for (const auto &pred : predicates) {
+    if (pred.column_idx >= rg.columns.size() ||
+        !ZoneMapAllMatch(rg.columns[pred.column_idx], pred)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// RowGroup 内的行区间 [begin, end)
+struct RowRange {
+  uint32_t begin;
+  uint32_t end;
+};
+
+// 页级裁剪：返回可能包含匹配行的页对应的行区间（相邻页合并，有序）
+// 没有页索引时返回整个 RowGroup；全为 NULL 的页不会匹配任何谓词
+inline std::vector<RowRange>
+PageRangesMayMatch(const RowGroupMeta &rg,
+                   const std::vector<ScanPredicate> &predicates) {
+  std::vector<RowRange> ranges;
+  uint32_t page_count = rg.PageCount();
+  if (page_count == 0) {
+    ranges.push_back({0, rg.row_count});
+    return ranges;
+  }
+  for (uint32_t page = 0; page < page_count; page++) {
+    uint32_t begin = page * rg.page_rows;
+    uint32_t end = std::min(begin + rg.page_rows, rg.row_count);
+    bool may_match = true;
+    for (const auto &pred : predicates) {
+      if (pred.column_idx >= rg.columns.size()) {
+        continue;
+      }
+      const auto &pages = rg.columns[pred.column_idx].pages;
+      if (page >= pages.size()) {
+        continue;
+      }
+      const auto &stats = pages[page];
+      if (stats.null_count == end - begin ||
+          !ZoneMapMayMatch(stats.zone, pred)) {
+        may_match = false;
+        break;
+      }
+    }
+    if (!may_match) {
+      continue;
+    }
+    if (!ranges.empty() && ranges.back().end == begin) {
+      ranges.back().end = end;
+    } else {
+      ranges.push_back({begin, end});
+    }
+  }
+  return ranges;
+}
+
+// 单个列值上的谓词求值，ptr/len 为行编码中的原始值，len 为 0 表示 NULL（不匹配）
+inline bool ValueMatchesPredicate(const Byte *ptr, uint32_t len,
+                                  const ScanPredicate &pred) {
+  using Op = FunctionComparison::Operator;
+  int cmp = 0;
+  switch (pred.column_type) {
+  case ValueType::Type::Int: {
+    if (len != sizeof(int)) {
+      return false;
+    }
+    int v = 0;
+    std::memcpy(&v, ptr, sizeof(int));
+    cmp = v < pred.const_int ? -1 : (v > pred.const_int ? 1 : 0);
+    break;
+  }
+  case ValueType::Type::Double: {
+    if (len != sizeof(double)) {
+      return false;
+    }
+    double v = 0.0;
+    std::memcpy(&v, ptr, sizeof(double));
+    cmp = v < pred.const_double ? -1 : (v > pred.const_double ? 1 : 0);
+    break;
+  }
+  case ValueType::Type::String: {
+    if (len == 0) {
+      return false;
+    }
+    cmp = std::string_view(reinterpret_cast<const char *>(ptr), len)
+              .compare(pred.const_string);
+    break;
+  }
+  default: return false;
+  }
+
+  switch (pred.op) {
+  case Op::Greater: return cmp > 0;
+  case Op::GreaterOrEquals: return cmp >= 0;
+  case Op::Less: return cmp < 0;
+  case Op::LessOrEquals: return cmp <= 0;
+  case Op::Equals: return cmp == 0;
+  case Op::NotEquals: return cmp != 0;
+  }
+  return false;
+}
+
 } // namespace DB
@@ -0,0 +1,319 @@
+#include "storage/lsmtree/SecondaryIndex.hpp"
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace DB {
+
+static constexpr uint32_t kSecondaryIndexMagic = 0x5A4B5349; // ZKSI
+static constexpr uint16_t kSecondaryIndexVersion = 1;
+static constexpr size_t kSecondaryIndexHeaderSize =
+    sizeof(uint32_t) + sizeof(uint16_t) + sizeof(uint8_t) * 2 +
+    sizeof(uint32_t) * 2;
+
+// 类型感知的列值比较（与 SSTable 中 key 的比较规则一致）
+static int CompareValues(std::string_view a, std::string_view b,
+                         ValueType::Type type) {
+  switch (type) {
+  case ValueType::Type::Int: {
+    int x = 0, y = 0;
+    std::memcpy(&x, a.data(), sizeof(int));
+    std::memcpy(&y, b.data(), sizeof(int));
+    return x < y ? -1 : (x > y ? 1 : 0);
+  }
+  case ValueType::Type::Double: {
+    double x = 0.0, y = 0.0;
+    std::memcpy(&x, a.data(), sizeof(double));
+    std::memcpy(&y, b.data(), sizeof(double));
+    return x < y ? -1 : (x > y ? 1 : 0);
+  }
+  default: return a.compare(b);
+  }
+}
+
+static void AppendOffsets(std::string &buffer,
+                          const std::vector<SecondaryIndex::Entry> &entries,
+                          std::string SecondaryIndex::Entry::*field) {
+  uint32_t offset = 0;
+  buffer.append(reinterpret_cast<const char *>(&offset), sizeof(offset));
+  for (const auto &e : entries) {
+    offset += static_cast<uint32_t>((e.*field).size());
+    buffer.append(reinterpret_cast<const char *>(&offset), sizeof(offset));
+  }
+  for (const auto &e : entries) {
+    buffer.append(e.*field);
+  }
+}
+
+int SecondaryIndex::IndexFile::Compare(uint32_t i,
+                                       const ScanPredicate &pred) const {
+  switch (value_type) {
+  case ValueType::Type::Int: {
+    int v = 0;
+    std::memcpy(&v, values + i * sizeof(int), sizeof(int));
+    return v < pred.const_int ? -1 : (v > pred.const_int ? 1 : 0);
+  }
+  case ValueType::Type::Double: {
+    double v = 0.0;
+    std::memcpy(&v, values + i * sizeof(double), sizeof(double));
+    return v < pred.const_double ? -1 : (v > pred.const_double ? 1 : 0);
+  }
+  default: {
+    uint32_t start = 0, end = 0;
+    std::memcpy(&start, values + i * sizeof(uint32_t), sizeof(uint32_t));
+    std::memcpy(&end, values + (i + 1) * sizeof(uint32_t), sizeof(uint32_t));
+    return std::string_view(value_data + start, end - start)
+        .compare(pred.const_string);
+  }
+  }
+}
+
+std::pair<uint32_t, uint32_t> SecondaryIndex::IndexFile::Range(
+    const std::vector<ScanPredicate> &predicates) const {
+  // 第一个满足 Compare(i) >= 0 (strict 时 > 0) 的位置
+  auto bound = [&](const ScanPredicate &pred, bool strict) {
+    uint32_t lo = 0, hi = count;
+    while (lo < hi) {
+      uint32_t mid = lo + (hi - lo) / 2;
+      int res = Compare(mid, pred);
+      if (res < 0 || (strict && res == 0)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  };
+
+  using Op = FunctionComparison::Operator;
+  uint32_t first = 0;
+  uint32_t last = count;
+  for (const auto &pred : predicates) {
+    if (pred.column_type != value_type) {
+      continue;
+    }
+    switch (pred.op) {
+    case Op::Equals:
+      first = std::max(first, bound(pred, false));
+      last = std::min(last, bound(pred, true));
+      break;
+    case Op::Greater: first = std::max(first, bound(pred, true)); break;
+    case Op::GreaterOrEquals:
+      first = std::max(first, bound(pred, false));
+      break;
+    case Op::Less: last = std::min(last, bound(pred, false)); break;
+    case Op::LessOrEquals: last = std::min(last, bound(pred, true)); break;
+    case Op::NotEquals: break;
+    }
+  }
+  return {first, std::max(first, last)};
+}
+
+std::string_view SecondaryIndex::IndexFile::Key(uint32_t i) const {
+  uint32_t start = 0, end = 0;
+  std::memcpy(&start, key_offsets + i * sizeof(uint32_t), sizeof(uint32_t));
+  std::memcpy(&end, key_offsets + (i + 1) * sizeof(uint32_t),
+              sizeof(uint32_t));
+  return {key_data + start, end - start};
+}
+
+std::filesystem::path SecondaryIndex::MakePath(uint32_t sstable_id) const {
+  return dir_ / fmt::format("{}.{}.sidx", sstable_id, column_idx_);
+}
+
+std::shared_ptr<SecondaryIndex::IndexFile>
+SecondaryIndex::OpenFile(uint32_t sstable_id, uint32_t sstable_rows) const {
+  auto file = std::make_shared<MMapFile>(MakePath(sstable_id));
+  if (!file->Valid() || file->Size() < kSecondaryIndexHeaderSize) {
+    return nullptr;
+  }
+  const Byte *p = file->Data();
+  const Byte *end = p + file->Size();
+  uint32_t magic = 0;
+  uint16_t version = 0;
+  uint8_t value_type = 0;
+  uint32_t rows = 0;
+  auto index = std::make_shared<IndexFile>();
+  std::memcpy(&magic, p, sizeof(magic));
+  p += sizeof(magic);
+  std::memcpy(&version, p, sizeof(version));
+  p += sizeof(version);
+  std::memcpy(&value_type, p, sizeof(value_type));
+  p += sizeof(value_type) * 2;
+  std::memcpy(&rows, p, sizeof(rows));
+  p += sizeof(rows);
+  std::memcpy(&index->count, p, sizeof(index->count));
+  p += sizeof(index->count);
+  if (magic != kSecondaryIndexMagic || version != kSecondaryIndexVersion ||
+      value_type != static_cast<uint8_t>(value_type_) ||
+      rows != sstable_rows || index->count > sstable_rows) {
+    return nullptr;
+  }
+
+  // 定位 offsets + data 段，返回 data 段起点
+  auto offsets_section = [&](const Byte *&offsets) -> const Byte * {
+    size_t offsets_size = (static_cast<size_t>(index->count) + 1) *
+                          sizeof(uint32_t);
+    if (static_cast<size_t>(end - p) < offsets_size) {
+      return nullptr;
+    }
+    offsets = p;
+    uint32_t data_size = 0;
+    std::memcpy(&data_size, p + index->count * sizeof(uint32_t),
+                sizeof(uint32_t));
+    const Byte *data = p + offsets_size;
+    if (static_cast<size_t>(end - data) < data_size) {
+      return nullptr;
+    }
+    p = data + data_size;
+    return data;
+  };
+
+  index->value_type = value_type_;
+  switch (value_type_) {
+  case ValueType::Type::Int:
+  case ValueType::Type::Double: {
+    size_t width = value_type_ == ValueType::Type::Int ? sizeof(int)
+                                                       : sizeof(double);
+    if (static_cast<size_t>(end - p) < index->count * width) {
+      return nullptr;
+    }
+    index->values = p;
+    p += index->count * width;
+    break;
+  }
+  case ValueType::Type::String:
+    index->value_data = offsets_section(index->values);
+    if (!index->value_data) {
+      return nullptr;
+    }
+    break;
+  case ValueType::Type::Null: return nullptr;
+  }
+  index->key_data = offsets_section(index->key_offsets);
+  if (!index->key_data || p != end) {
+    return nullptr;
+  }
+  index->file = std::move(file);
+  return index;
+}
+
+std::vector<std::shared_ptr<SecondaryIndex::IndexFile>>
+SecondaryIndex::SnapshotFiles() {
+  std::vector<std::shared_ptr<IndexFile>> files;
+  std::lock_guard lock(mutex_);
+  files.reserve(files_.size());
+  for (const auto &[id, file] : files_) {
+    files.push_back(file);
+  }
+  return files;
+}
+
+Status SecondaryIndex::AddSSTable(uint32_t sstable_id, uint32_t sstable_rows,
+                                  std::vector<Entry> entries) {
+  std::sort(entries.begin(), entries.end(),
+            [&](const Entry &a, const Entry &b) {
+              int res = CompareValues(a.value, b.value, value_type_);
+              return res != 0 ? res < 0 : a.key < b.key;
+            });
+
+  std::string buffer;
+  auto append = [&](const auto &v) {
+    buffer.append(reinterpret_cast<const char *>(&v), sizeof(v));
+  };
+  append(kSecondaryIndexMagic);
+  append(kSecondaryIndexVersion);
+  append(static_cast<uint8_t>(value_type_));
+  append(uint8_t{0});
+  append(sstable_rows);
+  append(static_cast<uint32_t>(entries.size()));
+  if (value_type_ == ValueType::Type::String) {
+    AppendOffsets(buffer, entries, &Entry::value);
+  } else {
+    for (const auto &e : entries) {
+      buffer.append(e.value);
+    }
+  }
+  AppendOffsets(buffer, entries, &Entry::key);
+
+  // 先写临时文件再改名，避免崩溃后留下半个索引文件
+  auto path = MakePath(sstable_id);
+  auto tmp_path = path;
+  tmp_path += ".tmp";
+  {
+    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+      return Status::Error(ErrorCode::FileNotOpen,
+                           "Failed to create secondary index file");
+    }
+    ofs.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!ofs.good()) {
+      return Status::Error(ErrorCode::IOError,
+                           "Failed to write secondary index file");
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    return Status::Error(ErrorCode::IOError,
+                         "Failed to install secondary index file");
+  }
+
+  auto index = OpenFile(sstable_id, sstable_rows);
+  if (!index) {
+    return Status::Error(ErrorCode::IOError,
+                         "Failed to load secondary index file");
+  }
+  std::lock_guard lock(mutex_);
+  files_[sstable_id] = std::move(index);
+  return Status::OK();
+}
+
+bool SecondaryIndex::LoadSSTable(uint32_t sstable_id, uint32_t sstable_rows) {
+  auto index = OpenFile(sstable_id, sstable_rows);
+  if (!index) {
+    return false;
+  }
+  std::lock_guard lock(mutex_);
+  files_[sstable_id] = std::move(index);
+  return true;
+}
+
+bool SecondaryIndex::HasSSTable(uint32_t sstable_id) {
+  std::lock_guard lock(mutex_);
+  return files_.count(sstable_id) > 0;
+}
+
+void SecondaryIndex::RemoveSSTable(uint32_t sstable_id) {
+  {
+    std::lock_guard lock(mutex_);
+    files_.erase(sstable_id);
+  }
+  // 正在查询的线程持有 mmap 引用，删除文件不影响其读取
+  std::error_code ec;
+  std::filesystem::remove(MakePath(sstable_id), ec);
+}
+
+void SecondaryIndex::Lookup(const std::vector<ScanPredicate> &predicates,
+                            std::vector<std::string> &keys) {
+  for (const auto &file : SnapshotFiles()) {
+    auto [first, last] = file->Range(predicates);
+    for (uint32_t i = first; i < last; i++) {
+      keys.emplace_back(file->Key(i));
+    }
+  }
+}
+
+void SecondaryIndex::Estimate(const std::vector<ScanPredicate> &predicates,
+                              size_t &matches, size_t &total) {
+  matches = 0;
+  total = 0;
+  for (const auto &file : SnapshotFiles()) {
+    auto [first, last] = file->Range(predicates);
+    matches += last - first;
+    total += file->count;
+  }
+}
+} // namespace DB
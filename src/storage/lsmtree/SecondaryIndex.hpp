@@ -0,0 +1,108 @@
+#pragma once
+
+#include "common/Config.hpp"
+#include "common/Status.hpp"
+#include "storage/MMapFile.hpp"
+#include "storage/lsmtree/ScanPredicate.hpp"
+#include "type/ValueType.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace DB {
+// clang-format off
+// 非主键列上的二级索引：每个 SSTable 对应一个有序索引文件
+// <sstable_id>.<column_idx>.sidx，随 flush / compaction 生成，随旧 SSTable 删除
+// memtable 中的行查询时直接扫描，不进索引
+//
+// 索引文件格式:
+//   magic (u32) + version (u16) + value_type (u8) + reserved (u8) +
+//   sstable_rows (u32) + count (u32)
+//   values: Int / Double 为定长数组，String 为 offsets[count + 1] (u32) + data
+//   keys:   offsets[count + 1] (u32) + data（主键原始字节）
+//   条目按 (列值, 主键) 排序，NULL 值不入索引
+// clang-format on
+class SecondaryIndex {
+public:
+  struct Entry {
+    std::string value;
+    std::string key;
+  };
+
+private:
+  // 已加载的单个索引文件
+  struct IndexFile {
+    std::shared_ptr<MMapFile> file;
+    ValueType::Type value_type{ValueType::Type::Null};
+    uint32_t count{0};
+    const Byte *values{nullptr};
+    const Byte *value_data{nullptr};
+    const Byte *key_offsets{nullptr};
+    const Byte *key_data{nullptr};
+
+    // 第 i 个值与谓词常量比较，返回 <0 / 0 / >0
+    int Compare(uint32_t i, const ScanPredicate &pred) const;
+
+    // 所有谓词共同确定的有序区间 [first, last)
+    std::pair<uint32_t, uint32_t>
+    Range(const std::vector<ScanPredicate> &predicates) const;
+
+    std::string_view Key(uint32_t i) const;
+  };
+
+  std::filesystem::path dir_;
+  size_t column_idx_;
+  ValueType::Type value_type_;
+
+  std::mutex mutex_;
+  std::map<uint32_t, std::shared_ptr<IndexFile>> files_;
+
+  std::shared_ptr<IndexFile> OpenFile(uint32_t sstable_id,
+                                      uint32_t sstable_rows) const;
+
+  std::vector<std::shared_ptr<IndexFile>> SnapshotFiles();
+
+public:
+  SecondaryIndex(std::filesystem::path dir, size_t column_idx,
+                 ValueType::Type value_type)
+      : dir_(std::move(dir)), column_idx_(column_idx),
+        value_type_(value_type) {}
+
+  size_t GetColumnIdx() const { return column_idx_; }
+
+  ValueType::Type GetValueType() const { return value_type_; }
+
+  std::filesystem::path MakePath(uint32_t sstable_id) const;
+
+  // 排序后写出并加载索引文件，sstable_rows 用于重新打开时校验文件是否过期
+  Status AddSSTable(uint32_t sstable_id, uint32_t sstable_rows,
+                    std::vector<Entry> entries);
+
+  // 加载已有的索引文件，文件缺失、损坏或行数不符时返回 false
+  bool LoadSSTable(uint32_t sstable_id, uint32_t sstable_rows);
+
+  bool HasSSTable(uint32_t sstable_id);
+
+  // 卸载并删除索引文件
+  void RemoveSSTable(uint32_t sstable_id);
+
+  // 谓词均作用于本列（AND 语义），NotEquals 不缩小范围
+  // 只返回候选主键：较新版本可能已修改该列，调用方需回表校验
+  void Lookup(const std::vector<ScanPredicate> &predicates,
+              std::vector<std::string> &keys);
+
+  // 规划用：命中条目数与条目总数
+  void Estimate(const std::vector<ScanPredicate> &predicates, size_t &matches,
+                size_t &total);
+};
+
+using SecondaryIndexRef = std::unique_ptr<SecondaryIndex>;
+} // namespace DB
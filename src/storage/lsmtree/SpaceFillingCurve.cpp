@@ -0,0 +1,48 @@
+#include "storage/lsmtree/SpaceFillingCurve.hpp"
+
+namespace DB {
+uint64_t ZOrderIndex(const uint32_t *coords, size_t dims, uint32_t bits) {
+  // 从最高位开始，每一位依次取各维的该位
+  uint64_t index = 0;
+  for (uint32_t b = bits; b-- > 0;) {
+    for (size_t d = 0; d < dims; d++) {
+      index = (index << 1) | ((coords[d] >> b) & 1);
+    }
+  }
+  return index;
+}
+
+uint64_t HilbertIndex(uint32_t *coords, size_t dims, uint32_t bits) {
+  if (bits == 0 || dims == 0) {
+    return 0;
+  }
+  // J. Skilling, "Programming the Hilbert curve" (2004)：
+  // 先逐位做反射 / 交换，再做 Gray 编码，得到的转置形式按位交错即为下标
+  uint32_t top = 1u << (bits - 1);
+  for (uint32_t q = top; q > 1; q >>= 1) {
+    uint32_t p = q - 1;
+    for (size_t d = 0; d < dims; d++) {
+      if (coords[d] & q) {
+        coords[0] ^= p;
+      } else {
+        uint32_t t = (coords[0] ^ coords[d]) & p;
+        coords[0] ^= t;
+        coords[d] ^= t;
+      }
+    }
+  }
+  for (size_t d = 1; d < dims; d++) {
+    coords[d] ^= coords[d - 1];
+  }
+  uint32_t t = 0;
+  for (uint32_t q = top; q > 1; q >>= 1) {
+    if (coords[dims - 1] & q) {
+      t ^= q - 1;
+    }
+  }
+  for (size_t d = 0; d < dims; d++) {
+    coords[d] ^= t;
+  }
+  return ZOrderIndex(coords, dims, bits);
+}
+} // namespace DB
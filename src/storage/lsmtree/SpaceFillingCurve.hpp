@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DB {
+// 聚簇写入使用的空间填充曲线
+enum class ClusterCurve : uint8_t {
+  // 各维坐标按位交错，计算简单，但曲线在象限之间会跳跃
+  ZOrder = 0,
+  // 相邻位置的点在空间上也相邻，同样大小的 RowGroup 覆盖的区域更紧凑
+  Hilbert = 1,
+};
+
+// 按若干非主键列聚簇：同一 RowGroup 内的行在这些列上取值相近，
+// 多列过滤时 zone map 能跳过更多 RowGroup
+struct ClusterSpec {
+  static constexpr size_t kMaxColumns = 4;
+
+  std::vector<size_t> columns;
+  ClusterCurve curve = ClusterCurve::ZOrder;
+
+  bool Empty() const { return columns.empty(); }
+};
+
+// coords 为 dims 个坐标，每个只取低 bits 位，dims * bits 不超过 64
+uint64_t ZOrderIndex(const uint32_t *coords, size_t dims, uint32_t bits);
+
+// Skilling 的 n 维 Hilbert 变换，会改写 coords
+uint64_t HilbertIndex(uint32_t *coords, size_t dims, uint32_t bits);
+} // namespace DB
@@ -0,0 +1,166 @@
+#include "storage/lsmtree/SparseKeyIndex.hpp"
+#include "common/CpuFeature.hpp"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace DB {
+
+void SparseKeyIndex::Build(const int *keys, uint32_t count,
+                           uint32_t interval) {
+  interval_ = interval;
+  samples_.clear();
+  if (!keys || count == 0 || interval == 0) {
+    tree_.clear();
+    tree_idx_.clear();
+    return;
+  }
+  samples_.reserve((count + interval - 1) / interval);
+  for (uint32_t i = 0; i < count; i += interval) {
+    samples_.push_back(keys[i]);
+  }
+  BuildTree();
+}
+
+void SparseKeyIndex::BuildTree() {
+  size_t n = samples_.size();
+  size_t node_count = (n + kNodeKeys - 1) / kNodeKeys;
+  tree_.assign(node_count * kNodeKeys, std::numeric_limits<int>::max());
+  tree_idx_.assign(node_count * kNodeKeys, static_cast<uint32_t>(n));
+
+  // 中序遍历依次填入有序采样，节点 k 的第 i 个孩子为 k * 9 + i + 1
+  size_t next = 0;
+  auto fill = [&](auto &self, size_t node) -> void {
+    if (node >= node_count) {
+      return;
+    }
+    for (uint32_t i = 0; i < kNodeKeys; i++) {
+      self(self, node * (kNodeKeys + 1) + i + 1);
+      if (next < n) {
+        tree_[node * kNodeKeys + i] = samples_[next];
+        tree_idx_[node * kNodeKeys + i] = static_cast<uint32_t>(next);
+        next++;
+      }
+    }
+    self(self, node * (kNodeKeys + 1) + kNodeKeys + 1);
+  };
+  fill(fill, 0);
+}
+
+// 单节点内第一个 > key 的槽位，节点有序所以命中的 lane 是连续后缀
+[[gnu::target("avx2")]]
+static uint32_t NodeUpperBoundAVX2(const int *node, int key) {
+  __m256i keys = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(node));
+  __m256i gt = _mm256_cmpgt_epi32(keys, _mm256_set1_epi32(key));
+  auto mask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(gt)));
+  return mask == 0 ? 8 : static_cast<uint32_t>(__builtin_ctz(mask));
+}
+
+static uint32_t NodeUpperBoundScalar(const int *node, int key) {
+  uint32_t i = 0;
+  while (i < 8 && node[i] <= key) {
+    i++;
+  }
+  return i;
+}
+
+int64_t SparseKeyIndex::FindBlock(int key) const {
+  if (samples_.empty()) {
+    return -1;
+  }
+  size_t node_count = tree_.size() / kNodeKeys;
+  size_t upper = samples_.size();
+  auto *upper_bound = HasAVX2() ? NodeUpperBoundAVX2 : NodeUpperBoundScalar;
+  size_t node = 0;
+  while (node < node_count) {
+    uint32_t i = upper_bound(tree_.data() + node * kNodeKeys, key);
+    if (i < kNodeKeys) {
+      upper = tree_idx_[node * kNodeKeys + i];
+    }
+    node = node * (kNodeKeys + 1) + i + 1;
+  }
+  return static_cast<int64_t>(upper) - 1;
+}
+
+bool SparseKeyIndex::Locate(int key, uint32_t row_count, uint32_t &begin,
+                            uint32_t &end) const {
+  int64_t block = FindBlock(key);
+  if (block < 0) {
+    return false;
+  }
+  begin = static_cast<uint32_t>(block) * interval_;
+  if (begin >= row_count) {
+    return false;
+  }
+  end = std::min(begin + interval_, row_count);
+  return true;
+}
+
+void SparseKeyIndex::Serialize(std::string &out) const {
+  auto append = [&](const auto &v) {
+    out.append(reinterpret_cast<const char *>(&v), sizeof(v));
+  };
+  auto count = static_cast<uint32_t>(samples_.size());
+  append(interval_);
+  append(count);
+  out.append(reinterpret_cast<const char *>(samples_.data()),
+             samples_.size() * sizeof(int));
+}
+
+bool SparseKeyIndex::Deserialize(const Byte *data, size_t size) {
+  uint32_t count = 0;
+  if (size < sizeof(interval_) + sizeof(count)) {
+    return false;
+  }
+  std::memcpy(&interval_, data, sizeof(interval_));
+  std::memcpy(&count, data + sizeof(interval_), sizeof(count));
+  data += sizeof(interval_) + sizeof(count);
+  size -= sizeof(interval_) + sizeof(count);
+  if (size != static_cast<size_t>(count) * sizeof(int) || interval_ == 0) {
+    return false;
+  }
+  samples_.resize(count);
+  std::memcpy(samples_.data(), data, size);
+  BuildTree();
+  return true;
+}
+
+[[gnu::target("avx2")]]
+static int64_t SearchIntBlockAVX2(const int *keys, uint32_t count, int key) {
+  __m256i target = _mm256_set1_epi32(key);
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i));
+    auto eq = static_cast<uint32_t>(_mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpeq_epi32(v, target))));
+    if (eq != 0) {
+      return i + __builtin_ctz(eq);
+    }
+    // 有序块：本组最大值已超过 key 则不必继续
+    if (keys[i + 7] > key) {
+      return -1;
+    }
+  }
+  for (; i < count; i++) {
+    if (keys[i] == key) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int64_t SearchIntBlock(const int *keys, uint32_t count, int key) {
+  if (HasAVX2()) {
+    return SearchIntBlockAVX2(keys, count, key);
+  }
+  const int *it = std::lower_bound(keys, keys + count, key);
+  if (it != keys + count && *it == key) {
+    return it - keys;
+  }
+  return -1;
+}
+} // namespace DB
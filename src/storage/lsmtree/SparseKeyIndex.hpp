@@ -0,0 +1,53 @@
+#pragma once
+
+#include "common/Config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace DB {
+// RowGroup 内 int 主键的稀疏索引：每 interval 行采样一个 key
+// 内存中按 S-tree（每节点 8 个 key 的静态 B 树）布局，查找时 AVX2 逐节点比较，
+// 命中后只需在 interval 行的小块内做最终查找
+class SparseKeyIndex {
+  static constexpr uint32_t kNodeKeys = 8;
+
+  uint32_t interval_{0};
+  // 有序采样，序列化使用
+  std::vector<int> samples_;
+  // S-tree 节点：tree_[node * 8 + i]，填充槽位为 INT_MAX
+  std::vector<int> tree_;
+  // 槽位对应的采样下标，填充槽位为 samples_.size()
+  std::vector<uint32_t> tree_idx_;
+
+  void BuildTree();
+
+public:
+  SparseKeyIndex() = default;
+
+  // keys 为 RowGroup 内有序的 key 列
+  void Build(const int *keys, uint32_t count, uint32_t interval);
+
+  bool Empty() const { return samples_.empty(); }
+
+  uint32_t Interval() const { return interval_; }
+
+  size_t SampleCount() const { return samples_.size(); }
+
+  // 返回最后一个 <= key 的采样下标，key 小于所有采样时返回 -1
+  int64_t FindBlock(int key) const;
+
+  // 定位 key 可能所在的行区间 [begin, end)
+  bool Locate(int key, uint32_t row_count, uint32_t &begin,
+              uint32_t &end) const;
+
+  void Serialize(std::string &out) const;
+
+  bool Deserialize(const Byte *data, size_t size);
+};
+
+// 在有序 int 块内查找 key，返回块内下标，未找到返回 -1
+int64_t SearchIntBlock(const int *keys, uint32_t count, int key);
+} // namespace DB
@@ -3,6 +3,8 @@
 #include "common/Logger.hpp"
 #include "common/Status.hpp"
 #include "fmt/format.h"
+#include "storage/lsmtree/ChunkCompression.hpp"
+#include "storage/lsmtree/Crc32c.hpp"
 #include "storage/lsmtree/Slice.hpp"
 #include "storage/lsmtree/builder/SSTableBuilder.hpp"
 #include "storage/lsmtree/iterator/Iterator.hpp"
@@ -20,8 +22,15 @@ Status TableOperator::BuildSSTable(
     std::filesystem::path path, uint32_t &table_id,
     std::vector<MemTableRef> &memtables,
     const std::vector<std::shared_ptr<ValueType>> &column_types,
-    uint16_t primary_key_idx, SSTableRef &sstable_meta) {
-  SSTableBuilder builder(path, table_id, column_types, primary_key_idx);
+    uint16_t primary_key_idx, SSTableRef &sstable_meta,
+    const std::vector<size_t> &filter_columns,
+    const std::vector<size_t> &gorilla_columns,
+    const RowGroupSizing &sizing) {
+  // flush 结果进入 L0
+  SSTableBuilder builder(path, table_id, column_types, primary_key_idx,
+                         DEFAULT_KEY_FILTER_TYPE, filter_columns,
+                         gorilla_columns, ColumnCodecForLevel(0, false),
+                         sizing);
   std::vector<std::shared_ptr<Iterator>> iters;
   // 新到旧合并 memtable
   for (auto it = memtables.rbegin(); it != memtables.rend(); it++) {
@@ -52,9 +61,6 @@ Status TableOperator::BuildSSTable(
   return s;
 }
 
-static constexpr uint32_t kSSTableMagic = 0x5A4B5254; // ZKRT
-static constexpr uint16_t kSSTableVersion = 2;
-
 static Status ReadRange(std::filesystem::path path, uint32_t offset,
                         uint32_t size,
                         std::shared_ptr<BufferPoolManager> buffer_pool,
@@ -126,37 +132,54 @@ Status TableOperator::ReadSSTable(
   uint16_t column_count = 0;
   uint16_t primary_key_idx = 0;
   uint16_t version = 0;
-  uint16_t reserved = 0;
+  uint16_t filter_type = 0;
   uint32_t magic = 0;
   if (!read(meta_offset) || !read(meta_size) || !read(rowgroup_count) ||
       !read(column_count) || !read(primary_key_idx) || !read(version) ||
-      !read(reserved) || !read(magic)) {
+      !read(filter_type) || !read(magic)) {
     return Status::Error(ErrorCode::IOError, "SSTable footer corrupted");
   }
   // 校验版本和列数
-  if (magic != kSSTableMagic || version != kSSTableVersion) {
+  if (magic != kSSTableMagic || version < kSSTableMinVersion ||
+      version > kSSTableVersion) {
     return Status::Error(ErrorCode::IOError, "SSTable version mismatch");
   }
   if (column_count != column_types.size()) {
     return Status::Error(ErrorCode::IOError, "SSTable column count mismatch");
   }
-  if (meta_offset + meta_size > file_size) {
+  // v6 起元数据区后紧跟 u32 校验和
+  uint32_t checksum_size = version >= 6 ? sizeof(uint32_t) : 0;
+  if (uint64_t{meta_offset} + meta_size + checksum_size >
+      file_size - footer_size) {
     return Status::Error(ErrorCode::IOError, "SSTable meta out of range");
   }
 
   std::string meta_blob;
   // 读取 RowGroup 元数据段
-  status = ReadRange(path, meta_offset, meta_size, buffer_pool, meta_blob);
+  status = ReadRange(path, meta_offset, meta_size + checksum_size,
+                     buffer_pool, meta_blob);
   if (!status.ok()) {
     return status;
   }
+  if (checksum_size > 0) {
+    uint32_t expected = 0;
+    std::memcpy(&expected, meta_blob.data() + meta_size, sizeof(expected));
+    meta_blob.resize(meta_size);
+    ChecksumStats::verified_bytes.fetch_add(meta_size,
+                                            std::memory_order_relaxed);
+    if (Crc32c(meta_blob.data(), meta_blob.size()) != expected) {
+      ChecksumStats::mismatches.fetch_add(1, std::memory_order_relaxed);
+      return Status::Error(ErrorCode::IOError,
+                           "SSTable meta checksum mismatch");
+    }
+  }
   p = reinterpret_cast<const Byte *>(meta_blob.data());
   end = p + meta_blob.size();
   sstable_meta->rowgroups_.clear();
   sstable_meta->rowgroups_.reserve(rowgroup_count);
   for (uint32_t i = 0; i < rowgroup_count; i++) {
     RowGroupMeta meta;
-    if (!RowGroupMeta::Deserialize(p, end, column_types, meta)) {
+    if (!RowGroupMeta::Deserialize(p, end, column_types, version, meta)) {
       return Status::Error(ErrorCode::IOError, "SSTable meta corrupted");
     }
     sstable_meta->rowgroups_.push_back(std::move(meta));
@@ -165,7 +188,12 @@ Status TableOperator::ReadSSTable(
   sstable_meta->rowgroup_count_ = rowgroup_count;
   sstable_meta->column_count_ = column_count;
   sstable_meta->primary_key_idx_ = primary_key_idx;
+  sstable_meta->filter_type_ = static_cast<KeyFilterType>(filter_type);
   sstable_meta->data_file_ = std::make_shared<MMapFile>(path);
+  sstable_meta->ResetChecksumState();
+  if (primary_key_idx < column_types.size()) {
+    sstable_meta->DetectKeyOrder(column_types[primary_key_idx]->GetType());
+  }
   LOG_INFO("ReadSSTable: id={}, rowgroups={}, columns={}, pk_idx={}",
            sstable_meta->sstable_id_, rowgroup_count, column_count,
            primary_key_idx);
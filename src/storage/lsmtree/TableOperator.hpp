@@ -4,10 +4,12 @@
 #include "common/Status.hpp"
 #include "storage/lsmtree/MemTable.hpp"
 #include "storage/lsmtree/SSTable.hpp"
+#include "storage/lsmtree/builder/SSTableBuilder.hpp"
 #include "type/ValueType.hpp"
 
 #include <cstdint>
 #include <filesystem>
+#include <vector>
 
 namespace DB {
 struct TableOperator {
@@ -17,7 +19,10 @@ struct TableOperator {
   BuildSSTable(std::filesystem::path path, uint32_t &table_id,
                std::vector<MemTableRef> &memtables,
                const std::vector<std::shared_ptr<ValueType>> &column_types,
-               uint16_t primary_key_idx, SSTableRef &sstable_meta);
+               uint16_t primary_key_idx, SSTableRef &sstable_meta,
+               const std::vector<size_t> &filter_columns = {},
+               const std::vector<size_t> &gorilla_columns = {},
+               const RowGroupSizing &sizing = {});
 
   static Status StartCompaction(std::vector<SSTableRef> tables);
 
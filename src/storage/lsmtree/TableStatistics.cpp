@@ -0,0 +1,62 @@
+#include "storage/lsmtree/TableStatistics.hpp"
+
+#include <algorithm>
+
+namespace DB {
+// 没有直方图时范围谓词的默认选择率
+static constexpr double kDefaultRangeSelectivity = 1.0 / 3;
+
+double TableStatistics::EstimateSelectivity(const ScanPredicate &pred) const {
+  if (pred.column_idx >= columns.size()) {
+    return 1.0;
+  }
+  const auto &stats = columns[pred.column_idx];
+  if (stats.row_count == 0) {
+    return 1.0;
+  }
+  // NULL 不满足任何谓词
+  double non_null = static_cast<double>(stats.row_count - stats.null_count) /
+                    static_cast<double>(stats.row_count);
+  uint64_t distinct = std::max<uint64_t>(1, stats.distinct.Estimate());
+  double equals = 1.0 / static_cast<double>(distinct);
+
+  const auto &histogram = stats.histogram;
+  double value = 0.0;
+  bool numeric = !histogram.Empty();
+  if (pred.column_type == ValueType::Type::Int) {
+    value = pred.const_int;
+  } else if (pred.column_type == ValueType::Type::Double) {
+    value = pred.const_double;
+  } else {
+    numeric = false;
+  }
+
+  using Op = FunctionComparison::Operator;
+  double fraction = kDefaultRangeSelectivity;
+  switch (pred.op) {
+  case Op::Equals:
+    fraction = equals;
+    // 常量落在直方图范围之外
+    if (numeric && (histogram.FractionBelow(value, true) == 0.0 ||
+                    histogram.FractionBelow(value, false) >= 1.0)) {
+      fraction = 0.0;
+    }
+    break;
+  case Op::NotEquals: fraction = 1.0 - equals; break;
+  case Op::Less:
+  case Op::LessOrEquals:
+    if (numeric) {
+      fraction = histogram.FractionBelow(value, pred.op == Op::LessOrEquals);
+    }
+    break;
+  case Op::Greater:
+  case Op::GreaterOrEquals:
+    if (numeric) {
+      fraction =
+          1.0 - histogram.FractionBelow(value, pred.op == Op::Greater);
+    }
+    break;
+  }
+  return std::clamp(non_null * fraction, 0.0, 1.0);
+}
+} // namespace DB
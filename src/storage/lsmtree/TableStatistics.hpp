@@ -0,0 +1,24 @@
+#pragma once
+
+#include "storage/lsmtree/ColumnStatistics.hpp"
+#include "storage/lsmtree/ScanPredicate.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace DB {
+// ANALYZE 生成的表级统计：合并所有 SSTable 中各 RowGroup 的列统计
+struct TableStatistics {
+  // 表级直方图的桶数上限
+  static constexpr uint32_t kHistogramBuckets = 64;
+
+  uint64_t row_count = 0;
+  std::vector<ColumnStatistics> columns;
+
+  // 估计满足谓词的行所占比例，没有该列统计时返回 1
+  double EstimateSelectivity(const ScanPredicate &pred) const;
+};
+
+using TableStatisticsRef = std::shared_ptr<const TableStatistics>;
+} // namespace DB
@@ -0,0 +1,52 @@
+#include "storage/lsmtree/builder/BloomFilterBuilder.hpp"
+#include "common/CpuFeature.hpp"
+#include "storage/lsmtree/BloomFilterKernel.hpp"
+
+namespace DB {
+
+// 把 7 个探测位展开成 16 个 uint32 的块掩码（lo 为字 0..7，hi 为字 8..15），
+// 整块 OR 写回，避免逐字节读改写
+[[gnu::target("avx2")]]
+static void AddHashesAVX2(Byte *data, size_t num_blocks, const uint64_t *hashes,
+                          size_t count) {
+  const __m256i idx_lo = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256i idx_hi = _mm256_setr_epi32(8, 9, 10, 11, 12, 13, 14, 15);
+  for (size_t i = 0; i < count; i++) {
+    const uint64_t h = hashes[i];
+    Byte *block = data + ((h >> 32) % num_blocks) * kBloomBlockBytes;
+    __m256i word;
+    __m256i bit;
+    BloomProbeLanesAVX2(static_cast<uint32_t>(h), word, bit);
+
+    __m256i mask_lo = _mm256_setzero_si256();
+    __m256i mask_hi = _mm256_setzero_si256();
+    for (int p = 0; p < static_cast<int>(kBloomNumProbes); p++) {
+      const __m256i lane = _mm256_set1_epi32(p);
+      __m256i w = _mm256_permutevar8x32_epi32(word, lane);
+      __m256i b = _mm256_permutevar8x32_epi32(bit, lane);
+      mask_lo = _mm256_or_si256(
+          mask_lo, _mm256_and_si256(_mm256_cmpeq_epi32(w, idx_lo), b));
+      mask_hi = _mm256_or_si256(
+          mask_hi, _mm256_and_si256(_mm256_cmpeq_epi32(w, idx_hi), b));
+    }
+
+    auto *lo = reinterpret_cast<__m256i *>(block);
+    auto *hi = reinterpret_cast<__m256i *>(block + 32);
+    _mm256_storeu_si256(lo, _mm256_or_si256(_mm256_loadu_si256(lo), mask_lo));
+    _mm256_storeu_si256(hi, _mm256_or_si256(_mm256_loadu_si256(hi), mask_hi));
+  }
+}
+
+void BloomFilterBuilder::AddHashes(const uint64_t *hashes, size_t count) {
+  if (num_blocks_ == 0) {
+    return;
+  }
+  if (HasAVX2()) {
+    AddHashesAVX2(data_.data(), num_blocks_, hashes, count);
+    return;
+  }
+  for (size_t i = 0; i < count; i++) {
+    AddHash(hashes[i]);
+  }
+}
+} // namespace DB
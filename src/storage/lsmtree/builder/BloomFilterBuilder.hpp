@@ -5,6 +5,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
 
 namespace DB {
 class BloomFilterBuilder {
@@ -25,7 +26,10 @@ public:
   }
 
   void AddKey(const Slice &key) {
-    uint64_t h = Hash64(key.GetData(), key.Size());
+    AddHash(Hash64(key.GetData(), key.Size()));
+  }
+
+  void AddHash(uint64_t h) {
     uint32_t block_idx = (h >> 32) % num_blocks_;
 
     uint32_t current_h = static_cast<uint32_t>(h);
@@ -39,6 +43,9 @@ public:
     }
   }
 
+  // 批量插入预先算好的 hash，AVX2 下每个 key 一次生成整块掩码再 OR 入 block
+  void AddHashes(const uint64_t *hashes, size_t count);
+
   std::string &GetData() { return data_; }
 };
 } // namespace DB
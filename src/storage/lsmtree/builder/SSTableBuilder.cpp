@@ -1,8 +1,14 @@
 #include "storage/lsmtree/builder/SSTableBuilder.hpp"
 
 #include "common/Config.hpp"
+#include "storage/lsmtree/BitPacking.hpp"
+#include "storage/lsmtree/BloomFilter.hpp"
+#include "storage/lsmtree/ChunkCompression.hpp"
+#include "storage/lsmtree/Crc32c.hpp"
+#include "storage/lsmtree/Gorilla.hpp"
+#include "storage/lsmtree/KeyFilter.hpp"
 #include "storage/lsmtree/RowCodec.hpp"
-#include "storage/lsmtree/builder/BloomFilterBuilder.hpp"
+#include "storage/lsmtree/RunLength.hpp"
 
 #include "fmt/format.h"
 
@@ -10,12 +16,11 @@
 #include <cstring>
 #include <fstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace DB {
-static constexpr uint32_t kSSTableMagic = 0x5A4B5254; // ZKRT
-static constexpr uint16_t kSSTableVersion = 2;
-
 static size_t AlignTo(size_t size, size_t alignment) {
   // 向上对齐到指定字节边界
   if (alignment == 0) {
@@ -140,7 +145,8 @@ struct ZoneMapBuilder {
 };
 
 struct ColumnBuilder {
-  explicit ColumnBuilder(ValueType::Type type) : type(type), zone(type) {
+  explicit ColumnBuilder(ValueType::Type type)
+      : type(type), zone(type), page_zone(type) {
     if (type == ValueType::Type::String) {
       offsets.push_back(0);
     }
@@ -153,8 +159,74 @@ struct ColumnBuilder {
   std::vector<uint8_t> null_bitmap;
   bool has_nulls = false;
   uint32_t row_count = 0;
+  // 已写满的页与当前页的统计
+  std::vector<PageZoneMap> pages;
+  ZoneMapBuilder page_zone;
+  uint32_t page_nulls = 0;
+  // 预聚合与基数 sketch
+  uint32_t non_null_count = 0;
+  double sum = 0.0;
+  HyperLogLog distinct;
 
   void Append(const Byte *value, uint32_t len) {
+    AppendValue(value, len);
+    if (!value || len == 0) {
+      page_nulls++;
+    } else {
+      page_zone.Update(value, len);
+      non_null_count++;
+      distinct.Add(HashColumnValue(type, value, len));
+      if (type == ValueType::Type::Int && len == sizeof(int)) {
+        int v = 0;
+        std::memcpy(&v, value, sizeof(v));
+        sum += v;
+      } else if (type == ValueType::Type::Double && len == sizeof(double)) {
+        double v = 0.0;
+        std::memcpy(&v, value, sizeof(v));
+        sum += v;
+      }
+    }
+    if (row_count % PAGE_INDEX_ROWS == 0) {
+      pages.push_back({page_nulls, page_zone.Finish()});
+      page_zone = ZoneMapBuilder(type);
+      page_nulls = 0;
+    }
+  }
+
+  // 包含未写满的最后一页
+  std::vector<PageZoneMap> FinishPages() const {
+    auto result = pages;
+    if (row_count % PAGE_INDEX_ROWS != 0) {
+      result.push_back({page_nulls, page_zone.Finish()});
+    }
+    return result;
+  }
+
+  // 数值列的等深直方图，跳过 NULL
+  Histogram BuildHistogram() const {
+    if (type != ValueType::Type::Int && type != ValueType::Type::Double) {
+      return {};
+    }
+    std::vector<double> values;
+    values.reserve(non_null_count);
+    for (uint32_t row = 0; row < row_count; row++) {
+      if (has_nulls && (null_bitmap[row / 8] & (1 << (row % 8)))) {
+        continue;
+      }
+      if (type == ValueType::Type::Int) {
+        int v = 0;
+        std::memcpy(&v, data.data() + row * sizeof(int), sizeof(v));
+        values.push_back(v);
+      } else {
+        double v = 0.0;
+        std::memcpy(&v, data.data() + row * sizeof(double), sizeof(v));
+        values.push_back(v);
+      }
+    }
+    return Histogram::Build(values);
+  }
+
+  void AppendValue(const Byte *value, uint32_t len) {
     // Track null bitmap
     size_t byte_idx = row_count / 8;
     if (byte_idx >= null_bitmap.size()) {
@@ -197,18 +269,177 @@ struct ColumnBuilder {
   }
 };
 
+// 低基数 String 列编码为有序字典 + 定宽编码，追加到 out；编码区 run 较少时
+// 改用 run-length。字典项超过上限或编码后不比 plain 更小时返回 false
+static bool EncodeDictionary(const ColumnBuilder &col, std::string &out,
+                             ColumnEncoding &encoding) {
+  std::unordered_map<std::string_view, uint32_t> codes;
+  size_t dict_bytes = 0;
+  auto value = [&](uint32_t row) {
+    return std::string_view(col.data)
+        .substr(col.offsets[row], col.offsets[row + 1] - col.offsets[row]);
+  };
+  for (uint32_t i = 0; i < col.row_count; i++) {
+    auto v = value(i);
+    // 空串即 NULL，不进字典
+    if (v.empty() || !codes.emplace(v, 0).second) {
+      continue;
+    }
+    dict_bytes += v.size();
+    if (codes.size() > STRING_DICTIONARY_MAX_ENTRIES) {
+      return false;
+    }
+  }
+  if (codes.empty()) {
+    return false;
+  }
+  auto count = static_cast<uint32_t>(codes.size());
+  uint32_t width = DictionaryCodeWidth(count);
+
+  // 按字节序排序，使编码保序，范围谓词可直接比较编码
+  std::vector<std::string_view> dict;
+  dict.reserve(count);
+  for (const auto &[v, code] : codes) {
+    dict.push_back(v);
+  }
+  std::sort(dict.begin(), dict.end());
+  for (uint32_t code = 0; code < count; code++) {
+    codes[dict[code]] = code;
+  }
+  // NULL 行编码为 0，读取时以 null bitmap 为准
+  std::string code_data;
+  code_data.reserve(static_cast<size_t>(col.row_count) * width);
+  for (uint32_t i = 0; i < col.row_count; i++) {
+    auto v = value(i);
+    uint32_t code = v.empty() ? 0 : codes[v];
+    if (width == sizeof(uint8_t)) {
+      code_data.push_back(static_cast<char>(code));
+    } else {
+      auto code16 = static_cast<uint16_t>(code);
+      code_data.append(reinterpret_cast<const char *>(&code16),
+                       sizeof(code16));
+    }
+  }
+  uint32_t runs = CountRuns(code_data.data(), col.row_count, width);
+  bool run_length = RunLengthSize(runs, width) < code_data.size();
+  size_t code_size = run_length ? RunLengthSize(runs, width) : code_data.size();
+  size_t dict_size = sizeof(uint32_t) * (count + 2) + dict_bytes + code_size;
+  size_t plain_size = col.offsets.size() * sizeof(uint32_t) + col.data.size();
+  if (dict_size >= plain_size) {
+    return false;
+  }
+
+  auto append = [&](const auto &v) {
+    out.append(reinterpret_cast<const char *>(&v), sizeof(v));
+  };
+  append(count);
+  uint32_t offset = 0;
+  append(offset);
+  for (auto v : dict) {
+    offset += static_cast<uint32_t>(v.size());
+    append(offset);
+  }
+  for (auto v : dict) {
+    out.append(v);
+  }
+  if (run_length) {
+    RunLengthEncode(code_data.data(), col.row_count, width, out);
+    encoding = ColumnEncoding::DictionaryRunLength;
+  } else {
+    out.append(code_data);
+    encoding = ColumnEncoding::Dictionary;
+  }
+  return true;
+}
+
+// Int / Double 列在 plain、bit-packing (仅 Int)、Gorilla (声明了 GORILLA 的
+// Double 列)、run-length 中取最小的编码
+static ColumnEncoding EncodeFixed(const ColumnBuilder &col, bool gorilla,
+                                  std::string &out) {
+  size_t width = FixedSize(col.type);
+  ColumnEncoding encoding = ColumnEncoding::Plain;
+  size_t best_size = col.data.size();
+  std::string encoded;
+  if (col.type == ValueType::Type::Int) {
+    BitPackEncode(reinterpret_cast<const int *>(col.data.data()),
+                  col.row_count, encoded);
+    if (encoded.size() < best_size) {
+      encoding = ColumnEncoding::BitPacked;
+      best_size = encoded.size();
+    }
+  } else if (gorilla) {
+    GorillaEncode(reinterpret_cast<const double *>(col.data.data()),
+                  col.row_count, encoded);
+    if (encoded.size() < best_size) {
+      encoding = ColumnEncoding::Gorilla;
+      best_size = encoded.size();
+    }
+  }
+  uint32_t runs = CountRuns(col.data.data(), col.row_count, width);
+  if (RunLengthSize(runs, width) < best_size) {
+    RunLengthEncode(col.data.data(), col.row_count, width, out);
+    return ColumnEncoding::RunLength;
+  }
+  out.append(encoding == ColumnEncoding::Plain ? col.data : encoded);
+  return encoding;
+}
+
+// 把 data 中 begin 起的整个列数据块替换为压缩结果，至少省下 1/8 才采用
+static void CompressColumn(ColumnCodec codec, size_t begin, std::string &data,
+                           ColumnChunkMeta &meta) {
+  size_t raw_size = data.size() - begin;
+  if (codec == ColumnCodec::None || raw_size < COLUMN_COMPRESSION_MIN_SIZE) {
+    return;
+  }
+  std::string compressed;
+  if (!CompressChunk(codec, data.data() + begin, raw_size, compressed) ||
+      compressed.size() > raw_size - raw_size / 8) {
+    return;
+  }
+  data.resize(begin);
+  data.append(compressed);
+  meta.codec = codec;
+  meta.uncompressed_size = static_cast<uint32_t>(raw_size);
+}
+
 class RowGroupBuilder {
   std::vector<std::shared_ptr<ValueType>> column_types_;
+  uint16_t primary_key_idx_;
+  ValueType::Type key_type_;
   std::vector<ColumnBuilder> columns_;
   std::vector<Slice> keys_;
   uint32_t row_count_{0};
   size_t current_size_{0};
-  size_t target_size_;
+  RowGroupSizing sizing_;
+  // 当前 RowGroup 的 int 主键所在的 key_boundary 区间
+  int64_t key_bucket_{0};
+  KeyFilterType filter_type_;
+  // 需要值过滤器的列及其非 NULL 值的 hash
+  std::vector<size_t> filter_columns_;
+  std::vector<std::vector<uint64_t>> filter_hashes_;
+  // 各列是否尝试 Gorilla 编码
+  std::vector<bool> gorilla_;
+  // 非主键列数据块的压缩算法
+  ColumnCodec codec_;
 
 public:
   RowGroupBuilder(std::vector<std::shared_ptr<ValueType>> column_types,
-                  size_t target_size)
-      : column_types_(std::move(column_types)), target_size_(target_size) {
+                  uint16_t primary_key_idx, RowGroupSizing sizing,
+                  KeyFilterType filter_type,
+                  std::vector<size_t> filter_columns,
+                  const std::vector<size_t> &gorilla_columns,
+                  ColumnCodec codec)
+      : column_types_(std::move(column_types)),
+        primary_key_idx_(primary_key_idx),
+        key_type_(column_types_.empty()
+                      ? ValueType::Type::Null
+                      : column_types_[primary_key_idx]->GetType()),
+        sizing_(sizing), filter_type_(filter_type),
+        filter_columns_(std::move(filter_columns)),
+        gorilla_(column_types_.size(), false), codec_(codec) {
+    for (auto idx : gorilla_columns) {
+      gorilla_[idx] = true;
+    }
     Reset();
   }
 
@@ -223,11 +454,15 @@ public:
       }
     }
     keys_.clear();
+    filter_hashes_.assign(filter_columns_.size(), {});
     row_count_ = 0;
   }
 
   bool Empty() const { return row_count_ == 0; }
 
+  // 聚簇写入时行不再按主键连续到达，不按主键边界切分
+  void DisableKeyBoundary() { sizing_.key_boundary = 0; }
+
   size_t DataSize() const { return current_size_; }
 
   uint32_t RowCount() const { return row_count_; }
@@ -252,12 +487,34 @@ public:
         size_inc += FixedSize(column_types_[i]->GetType());
       }
     }
-    if (row_count_ > 0 && current_size_ + size_inc > target_size_) {
+    if (row_count_ > 0 && (row_count_ >= sizing_.target_rows ||
+                           current_size_ + size_inc > sizing_.target_bytes)) {
       return false;
     }
+    // int 主键跨过 key_boundary 的整数倍时切分，RowGroup 的 key 范围对齐
+    if (sizing_.key_boundary > 0 && key_type_ == ValueType::Type::Int &&
+        key.Size() == sizeof(int)) {
+      int k = 0;
+      std::memcpy(&k, key.GetData(), sizeof(k));
+      int64_t boundary = sizing_.key_boundary;
+      int64_t bucket =
+          k >= 0 ? k / boundary : -((-int64_t{k} - 1) / boundary) - 1;
+      if (row_count_ > 0 && bucket != key_bucket_) {
+        return false;
+      }
+      key_bucket_ = bucket;
+    }
     for (size_t i = 0; i < columns_.size(); i++) {
       columns_[i].Append(values[i].first, values[i].second);
     }
+    for (size_t f = 0; f < filter_columns_.size(); f++) {
+      auto col_idx = filter_columns_[f];
+      const auto &[data, len] = values[col_idx];
+      if (data && len > 0) {
+        filter_hashes_[f].push_back(
+            HashColumnValue(column_types_[col_idx]->GetType(), data, len));
+      }
+    }
     // key 仅用于主键 Bloom 和 max_key
     keys_.push_back(key);
     row_count_++;
@@ -268,6 +525,7 @@ public:
   RowGroupMeta Build(std::string &data) const {
     RowGroupMeta meta;
     meta.row_count = row_count_;
+    meta.has_checksums = true;
     size_t offset = 0;
     data.clear();
     // PAX 布局按列顺序写入
@@ -277,7 +535,22 @@ public:
       col_meta.offset = static_cast<uint32_t>(offset);
       col_meta.zone = col.zone.Finish();
       col_meta.has_nulls = col.has_nulls;
+      if (row_count_ > PAGE_INDEX_ROWS) {
+        col_meta.pages = col.FinishPages();
+        meta.page_rows = PAGE_INDEX_ROWS;
+      }
+      if (col.type == ValueType::Type::Int ||
+          col.type == ValueType::Type::Double) {
+        col_meta.has_aggregate = true;
+        col_meta.non_null_count = col.non_null_count;
+        col_meta.sum = col.sum;
+      }
+      col_meta.stats.row_count = row_count_;
+      col_meta.stats.null_count = row_count_ - col.non_null_count;
+      col_meta.stats.distinct = col.distinct;
+      col_meta.stats.histogram = col.BuildHistogram();
 
+      size_t chunk_begin = data.size();
       // 如果列有 null，先写入 null bitmap
       if (col.has_nulls) {
         size_t bitmap_size = (row_count_ + 7) / 8;
@@ -285,19 +558,27 @@ public:
                     bitmap_size);
       }
 
-      size_t bitmap_bytes = col.has_nulls ? (row_count_ + 7) / 8 : 0;
       if (col.type == ValueType::Type::String) {
-        for (auto off : col.offsets) {
-          data.append(reinterpret_cast<const char *>(&off), sizeof(off));
+        // String 主键保持 plain
+        if (i == primary_key_idx_ ||
+            !EncodeDictionary(col, data, col_meta.encoding)) {
+          for (auto off : col.offsets) {
+            data.append(reinterpret_cast<const char *>(&off), sizeof(off));
+          }
+          data.append(col.data);
         }
-        data.append(col.data);
-        col_meta.size = static_cast<uint32_t>(
-            bitmap_bytes + col.offsets.size() * sizeof(uint32_t) +
-            col.data.size());
+      } else if (col.type == ValueType::Type::Int ||
+                 col.type == ValueType::Type::Double) {
+        col_meta.encoding = EncodeFixed(col, gorilla_[i], data);
       } else {
         data.append(col.data);
-        col_meta.size = static_cast<uint32_t>(bitmap_bytes + col.data.size());
       }
+      // 主键列用于点查二分与迭代，保持不压缩
+      if (i != primary_key_idx_) {
+        CompressColumn(codec_, chunk_begin, data, col_meta);
+      }
+      col_meta.size = static_cast<uint32_t>(data.size() - chunk_begin);
+      col_meta.checksum = Crc32c(data.data() + chunk_begin, col_meta.size);
       meta.columns.emplace_back(std::move(col_meta));
       offset += meta.columns.back().size;
     }
@@ -311,16 +592,46 @@ public:
         data.append(reinterpret_cast<const char *>(k.GetData()), k.Size());
       }
       meta.key_column_size = static_cast<uint32_t>(keys_.size() * key_size);
+      meta.key_column_checksum =
+          Crc32c(data.data() + meta.key_column_offset, meta.key_column_size);
       offset += meta.key_column_size;
 
-      // Bloom 仅覆盖主键 key
-      BloomFilterBuilder bloom_builder(keys_.size());
-      for (auto &k : keys_) {
-        bloom_builder.AddKey(k);
+      // int 主键按固定间隔采样构建稀疏索引，行数不足一个块时直接二分即可
+      if (key_type_ == ValueType::Type::Int && key_size == sizeof(int) &&
+          keys_.size() > SPARSE_KEY_INDEX_INTERVAL) {
+        std::vector<int> int_keys(keys_.size());
+        for (size_t i = 0; i < keys_.size(); i++) {
+          std::memcpy(&int_keys[i], keys_[i].GetData(), sizeof(int));
+        }
+        auto count = static_cast<uint32_t>(int_keys.size());
+        meta.key_index.Build(int_keys.data(), count, SPARSE_KEY_INDEX_INTERVAL);
+        // key 接近线性（自增 id、时间戳）时 learned index 只有几段，
+        // 比稀疏索引更小则改用 learned index
+        meta.learned_index.Build(int_keys.data(), count,
+                                 LEARNED_KEY_INDEX_EPSILON);
+        size_t sparse_size = meta.key_index.SampleCount() * sizeof(int);
+        if (!meta.learned_index.Empty() &&
+            meta.learned_index.SerializedSize() < sparse_size) {
+          meta.key_index = SparseKeyIndex{};
+        } else {
+          meta.learned_index = LearnedKeyIndex{};
+        }
       }
-      meta.bloom = bloom_builder.GetData();
+
+      // 过滤器仅覆盖主键 key，类型由 SSTable footer 记录
+      std::vector<uint64_t> hashes(keys_.size());
+      for (size_t i = 0; i < keys_.size(); i++) {
+        hashes[i] = BloomFilter::HashKey(keys_[i].GetData(), keys_[i].Size());
+      }
+      meta.bloom = BuildKeyFilter(filter_type_, hashes.data(), hashes.size());
       meta.max_key = keys_.back().ToString();
     }
+
+    for (size_t f = 0; f < filter_columns_.size(); f++) {
+      const auto &hashes = filter_hashes_[f];
+      meta.columns[filter_columns_[f]].filter =
+          BuildKeyFilter(filter_type_, hashes.data(), hashes.size());
+    }
     return meta;
   }
 };
@@ -330,18 +641,59 @@ SSTableBuilder::~SSTableBuilder() = default;
 SSTableBuilder::SSTableBuilder(
     std::filesystem::path path, uint32_t table_num,
     std::vector<std::shared_ptr<ValueType>> column_types,
-    uint16_t primary_key_idx)
+    uint16_t primary_key_idx, KeyFilterType filter_type,
+    std::vector<size_t> filter_columns, std::vector<size_t> gorilla_columns,
+    ColumnCodec codec, RowGroupSizing sizing)
     : table_id_(table_num), column_types_(std::move(column_types)),
-      primary_key_idx_(primary_key_idx) {
+      primary_key_idx_(primary_key_idx), filter_type_(filter_type),
+      sizing_(sizing) {
+  // 主键已有 key 过滤器，越界列忽略
+  std::erase_if(filter_columns, [&](size_t idx) {
+    return idx == primary_key_idx_ || idx >= column_types_.size();
+  });
+  // Gorilla 只用于 Double 列
+  std::erase_if(gorilla_columns, [&](size_t idx) {
+    return idx >= column_types_.size() ||
+           column_types_[idx]->GetType() != ValueType::Type::Double;
+  });
   std::filesystem::create_directory(path);
   path_ = std::move(path / fmt::format("{}.sst", table_num));
   fs_ = std::make_unique<std::ofstream>(
       path_, std::ios::trunc | std::ios::binary | std::ios::out);
   rowgroup_builder_ = std::make_unique<RowGroupBuilder>(
-      column_types_, DEFAULT_ROWGROUP_TARGET_SIZE);
+      column_types_, primary_key_idx_, sizing, filter_type_,
+      std::move(filter_columns), gorilla_columns, codec);
+}
+
+void SSTableBuilder::SetClustering(ClusterSpec spec) {
+  std::erase_if(spec.columns, [&](size_t idx) {
+    return idx == primary_key_idx_ || idx >= column_types_.size();
+  });
+  if (spec.columns.size() > ClusterSpec::kMaxColumns) {
+    spec.columns.resize(ClusterSpec::kMaxColumns);
+  }
+  if (column_types_.empty() ||
+      column_types_[primary_key_idx_]->GetType() != ValueType::Type::Int) {
+    spec.columns.clear();
+  }
+  cluster_ = std::move(spec);
+  if (!cluster_.Empty()) {
+    rowgroup_builder_->DisableKeyBoundary();
+  }
 }
 
 bool SSTableBuilder::Add(const Slice &key, const Slice &row) {
+  if (!cluster_.Empty()) {
+    cluster_rows_.push_back({cluster_data_.size(),
+                             static_cast<uint32_t>(key.Size()),
+                             static_cast<uint32_t>(row.Size())});
+    cluster_data_.append(key.GetData(), key.Size());
+    cluster_data_.append(row.GetData(), row.Size());
+    if (cluster_data_.size() >= CLUSTER_WINDOW_SIZE) {
+      return FlushClusterWindow().ok();
+    }
+    return true;
+  }
   if (rowgroup_builder_->AddRow(key, row)) {
     return true;
   }
@@ -375,8 +727,145 @@ Status SSTableBuilder::FlushRowGroup() {
   return Status::OK();
 }
 
+// 把第 col_idx 列的值按秩均匀映射到 [0, 2^bits)，NULL 排在最前；
+// 按秩而不是按值映射，偏斜分布的列也能用满各维的位数
+// rows 为各行编码在 data 中的 {偏移, 长度}，结果写入 coords[i * dims + dim]
+static void ClusterCoordinates(
+    const std::string &data,
+    const std::vector<std::pair<size_t, uint32_t>> &rows, size_t col_idx,
+    ValueType::Type type, uint32_t bits, size_t dims, size_t dim,
+    std::vector<uint32_t> &coords) {
+  size_t n = rows.size();
+  std::vector<std::string_view> values(n);
+  for (size_t i = 0; i < n; i++) {
+    const Byte *ptr = nullptr;
+    uint32_t len = 0;
+    if (RowCodec::DecodeColumnRaw(data.data() + rows[i].first, rows[i].second,
+                                  col_idx, ptr, len) &&
+        len > 0) {
+      values[i] = std::string_view{ptr, len};
+    }
+  }
+  auto less = [&](const std::string_view &a, const std::string_view &b) {
+    if (a.empty() || b.empty()) {
+      return a.empty() && !b.empty();
+    }
+    if (type == ValueType::Type::Int && a.size() == sizeof(int) &&
+        b.size() == sizeof(int)) {
+      int x = 0;
+      int y = 0;
+      std::memcpy(&x, a.data(), sizeof(x));
+      std::memcpy(&y, b.data(), sizeof(y));
+      return x < y;
+    }
+    if (type == ValueType::Type::Double && a.size() == sizeof(double) &&
+        b.size() == sizeof(double)) {
+      double x = 0;
+      double y = 0;
+      std::memcpy(&x, a.data(), sizeof(x));
+      std::memcpy(&y, b.data(), sizeof(y));
+      return x < y;
+    }
+    return a < b;
+  };
+  std::vector<uint32_t> order(n);
+  for (uint32_t i = 0; i < n; i++) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return less(values[a], values[b]);
+  });
+  std::vector<uint32_t> rank(n);
+  uint32_t distinct = 0;
+  for (size_t i = 0; i < n; i++) {
+    if (i > 0 && less(values[order[i - 1]], values[order[i]])) {
+      distinct++;
+    }
+    rank[order[i]] = distinct;
+  }
+  double max = static_cast<double>((uint64_t{1} << bits) - 1);
+  double scale = distinct == 0 ? 0.0 : max / distinct;
+  for (size_t i = 0; i < n; i++) {
+    coords[i * dims + dim] = static_cast<uint32_t>(rank[i] * scale);
+  }
+}
+
+Status SSTableBuilder::FlushClusterWindow() {
+  size_t n = cluster_rows_.size();
+  if (n == 0) {
+    return Status::OK();
+  }
+  // 窗口内的行按主键有序到达，下标顺序即主键顺序
+  std::vector<std::pair<size_t, uint32_t>> rows(n);
+  for (size_t i = 0; i < n; i++) {
+    rows[i] = {cluster_rows_[i].offset + cluster_rows_[i].key_size,
+               cluster_rows_[i].row_size};
+  }
+  size_t dims = cluster_.columns.size();
+  auto bits = static_cast<uint32_t>(std::min<size_t>(32, 64 / dims));
+  std::vector<uint32_t> coords(n * dims);
+  for (size_t d = 0; d < dims; d++) {
+    size_t col_idx = cluster_.columns[d];
+    ClusterCoordinates(cluster_data_, rows, col_idx,
+                       column_types_[col_idx]->GetType(), bits, dims, d,
+                       coords);
+  }
+  std::vector<uint64_t> curve(n);
+  for (size_t i = 0; i < n; i++) {
+    uint32_t *point = coords.data() + i * dims;
+    curve[i] = cluster_.curve == ClusterCurve::Hilbert
+                   ? HilbertIndex(point, dims, bits)
+                   : ZOrderIndex(point, dims, bits);
+  }
+  std::vector<uint32_t> order(n);
+  for (uint32_t i = 0; i < n; i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&](uint32_t a, uint32_t b) { return curve[a] < curve[b]; });
+
+  // 按窗口内平均行宽估计每个 RowGroup 的行数；行编码带长度前缀，
+  // 估计值不大于 RowGroupBuilder 按字节预算切出的行数
+  size_t avg_row = std::max<size_t>(1, cluster_data_.size() / n);
+  size_t chunk_rows = std::min<size_t>(
+      sizing_.target_rows, std::max<size_t>(1, sizing_.target_bytes / avg_row));
+  for (size_t begin = 0; begin < n; begin += chunk_rows) {
+    size_t end = std::min(n, begin + chunk_rows);
+    // 曲线上连续的一段组成 RowGroup，段内恢复主键顺序
+    std::sort(order.begin() + begin, order.begin() + end);
+    for (size_t i = begin; i < end; i++) {
+      const auto &row = cluster_rows_[order[i]];
+      Slice key{cluster_data_.data() + row.offset,
+                static_cast<uint16_t>(row.key_size)};
+      Slice value{cluster_data_.data() + row.offset + row.key_size,
+                  static_cast<uint16_t>(row.row_size)};
+      if (!rowgroup_builder_->AddRow(key, value)) {
+        auto status = FlushRowGroup();
+        if (!status.ok()) {
+          return status;
+        }
+        if (!rowgroup_builder_->AddRow(key, value)) {
+          return Status::Error(ErrorCode::InsertError,
+                               "row too large for a row group");
+        }
+      }
+    }
+    auto status = FlushRowGroup();
+    if (!status.ok()) {
+      return status;
+    }
+  }
+  cluster_data_.clear();
+  cluster_rows_.clear();
+  return Status::OK();
+}
+
 Status SSTableBuilder::Finish() {
-  auto status = FlushRowGroup();
+  auto status = FlushClusterWindow();
+  if (!status.ok()) {
+    return status;
+  }
+  status = FlushRowGroup();
   if (!status.ok()) {
     return status;
   }
@@ -391,11 +880,15 @@ Status SSTableBuilder::Finish() {
   if (meta_size > 0) {
     fs_->write(meta_blob.data(), meta_blob.size());
   }
+  // 元数据区校验和紧跟元数据区，不计入 meta_size
+  uint32_t meta_checksum = Crc32c(meta_blob.data(), meta_blob.size());
+  fs_->write(reinterpret_cast<const char *>(&meta_checksum),
+             sizeof(meta_checksum));
 
   uint32_t rowgroup_count = static_cast<uint32_t>(rowgroups_.size());
   uint16_t column_count = static_cast<uint16_t>(column_types_.size());
   uint16_t version = kSSTableVersion;
-  uint16_t reserved = 0;
+  auto filter_type = static_cast<uint16_t>(filter_type_);
 
   // Footer 固定长度用于反向读取元数据
   fs_->write(reinterpret_cast<const char *>(&meta_offset), sizeof(meta_offset));
@@ -407,7 +900,8 @@ Status SSTableBuilder::Finish() {
   fs_->write(reinterpret_cast<const char *>(&primary_key_idx_),
              sizeof(primary_key_idx_));
   fs_->write(reinterpret_cast<const char *>(&version), sizeof(version));
-  fs_->write(reinterpret_cast<const char *>(&reserved), sizeof(reserved));
+  fs_->write(reinterpret_cast<const char *>(&filter_type),
+             sizeof(filter_type));
   fs_->write(reinterpret_cast<const char *>(&kSSTableMagic),
              sizeof(kSSTableMagic));
   fs_->flush();
@@ -418,8 +912,14 @@ Status SSTableBuilder::Finish() {
   sstable_meta_->rowgroup_count_ = rowgroup_count;
   sstable_meta_->column_count_ = column_count;
   sstable_meta_->primary_key_idx_ = primary_key_idx_;
+  sstable_meta_->filter_type_ = filter_type_;
   sstable_meta_->rowgroups_ = rowgroups_;
   sstable_meta_->data_file_ = std::make_shared<MMapFile>(path_);
+  sstable_meta_->ResetChecksumState();
+  if (!column_types_.empty()) {
+    sstable_meta_->DetectKeyOrder(
+        column_types_[primary_key_idx_]->GetType());
+  }
   return Status::OK();
 }
 } // namespace DB
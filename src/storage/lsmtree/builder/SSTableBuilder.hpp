@@ -1,9 +1,12 @@
 #pragma once
 
+#include "common/Config.hpp"
 #include "common/Status.hpp"
+#include "storage/lsmtree/KeyFilter.hpp"
 #include "storage/lsmtree/RowGroupMeta.hpp"
 #include "storage/lsmtree/SSTable.hpp"
 #include "storage/lsmtree/Slice.hpp"
+#include "storage/lsmtree/SpaceFillingCurve.hpp"
 #include "type/ValueType.hpp"
 
 #include <filesystem>
@@ -14,27 +17,65 @@
 namespace DB {
 class RowGroupBuilder;
 
+// RowGroup 切分策略：行数或字节数任一达到目标即切分
+struct RowGroupSizing {
+  uint32_t target_rows = DEFAULT_ROWGROUP_TARGET_ROWS;
+  size_t target_bytes = DEFAULT_ROWGROUP_TARGET_SIZE;
+  // 非 0 时 int 主键每跨过一个 key_boundary 的整数倍就切分，
+  // 使 RowGroup 的 key 范围按边界对齐（如按小时分桶的时间戳主键），
+  // 数据稀疏时会产生较小的 RowGroup
+  uint32_t key_boundary = 0;
+};
+
 class SSTableBuilder {
   uint32_t table_id_{};
   std::filesystem::path path_;
   std::vector<std::shared_ptr<ValueType>> column_types_;
   uint16_t primary_key_idx_{};
+  KeyFilterType filter_type_;
 
   std::unique_ptr<std::ofstream> fs_;
   uint32_t data_size_{};
   std::vector<RowGroupMeta> rowgroups_;
   SSTableRef sstable_meta_;
   std::unique_ptr<RowGroupBuilder> rowgroup_builder_;
+  RowGroupSizing sizing_;
+
+  // 聚簇写入：缓冲一个窗口的行（key 与 row 连续存放），窗口满或 Finish 时
+  // 按曲线排序后切成 RowGroup
+  ClusterSpec cluster_;
+  std::string cluster_data_;
+  struct BufferedRow {
+    size_t offset;
+    uint32_t key_size;
+    uint32_t row_size;
+  };
+  std::vector<BufferedRow> cluster_rows_;
 
   Status FlushRowGroup();
 
+  Status FlushClusterWindow();
+
 public:
+  // filter_columns 为需要构建列值过滤器的非主键列，
+  // gorilla_columns 为尝试 Gorilla 编码的 Double 列，
+  // codec 为非主键列数据块的压缩算法，见 ColumnCodecForLevel，
+  // sizing 为 RowGroup 的切分策略
   SSTableBuilder(std::filesystem::path path, uint32_t table_num,
                  std::vector<std::shared_ptr<ValueType>> column_types,
-                 uint16_t primary_key_idx);
+                 uint16_t primary_key_idx,
+                 KeyFilterType filter_type = DEFAULT_KEY_FILTER_TYPE,
+                 std::vector<size_t> filter_columns = {},
+                 std::vector<size_t> gorilla_columns = {},
+                 ColumnCodec codec = ColumnCodec::None,
+                 RowGroupSizing sizing = {});
 
   ~SSTableBuilder();
 
+  // 在第一次 Add 之前调用；之后 RowGroup 按 spec 聚簇，RowGroup 内仍按主键
+  // 有序，主键边界切分不再生效。只用于 int 主键
+  void SetClustering(ClusterSpec spec);
+
   [[nodiscard]]
   bool Add(const Slice &key, const Slice &row);
 
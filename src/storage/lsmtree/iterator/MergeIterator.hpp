@@ -47,47 +47,40 @@ class MergeIterator : public Iterator {
     }
   }
 
-public:
-  // the iters's element the more index bigger the more data older
-  MergeIterator(std::vector<std::shared_ptr<Iterator>> iters,
-                ValueType::Type key_type = ValueType::Type::String)
-      : iters_(std::move(iters)), key_type_(key_type) {
+  // 选出 key 最小的迭代器，相同 key 取下标最小（最新）的
+  void SelectCurrent() {
     current_ = iters_[0];
     for (auto &it : iters_) {
-      if (!it->Valid() || current_ == it) {
+      if (!it->Valid()) {
         continue;
       }
-
-      if (CompareKeys(current_->GetKey(), it->GetKey()) == 0) {
-        it->Next();
-      }
-
-      if (!it->Valid() || CompareKeys(current_->GetKey(), it->GetKey()) > 0) {
+      if (!current_->Valid() ||
+          CompareKeys(current_->GetKey(), it->GetKey()) > 0) {
         current_ = it;
       }
     }
   }
 
+public:
+  // the iters's element the more index bigger the more data older
+  MergeIterator(std::vector<std::shared_ptr<Iterator>> iters,
+                ValueType::Type key_type = ValueType::Type::String)
+      : iters_(std::move(iters)), key_type_(key_type) {
+    SelectCurrent();
+  }
+
   void Next() override {
-    current_->Next();
+    if (!current_->Valid()) {
+      return;
+    }
+    // 所有迭代器一起越过当前 key，旧版本不会再被输出
+    Slice key = current_->GetKey();
     for (auto &it : iters_) {
-      if (!it->Valid() || current_ == it) {
-        continue;
-      }
-
-      if (!current_->Valid()) {
-        current_ = it;
-        continue;
-      }
-
-      if (CompareKeys(current_->GetKey(), it->GetKey()) == 0) {
+      if (it->Valid() && CompareKeys(key, it->GetKey()) == 0) {
         it->Next();
       }
-
-      if (it->Valid() && CompareKeys(current_->GetKey(), it->GetKey()) > 0) {
-        current_ = it;
-      }
     }
+    SelectCurrent();
   }
 
   bool Valid() override { return current_->Valid(); }
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "common/Config.hpp"
+#include "storage/lsmtree/ColumnReader.hpp"
 #include "storage/lsmtree/SSTable.hpp"
 #include "storage/lsmtree/iterator/Iterator.hpp"
 #include "type/ValueType.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <filesystem>
 #include <memory>
@@ -22,6 +25,48 @@ class SSTableIterator : public Iterator {
   std::vector<std::shared_ptr<ValueType>> column_types_;
   uint16_t primary_key_idx_{0};
   std::string row_buffer_;
+  uint64_t key_scratch_{0};
+  // 当前 RowGroup 的列数据，压缩列在整个 RowGroup 内只解压一次
+  RowGroupData rg_data_;
+  size_t rg_data_idx_{SIZE_MAX};
+  // 聚簇文件按主键顺序访问的 {rg, row}，key 有序的文件为空；
+  // 访问在 RowGroup 之间跳转，各 RowGroup 的列数据都保留
+  std::vector<std::pair<uint32_t, uint32_t>> order_;
+  size_t order_pos_{0};
+  std::vector<RowGroupData> rg_datas_;
+
+  // RowGroup 内主键有序，按 key 列排序即为对各 RowGroup 的归并
+  void BuildKeyOrder() {
+    struct Entry {
+      int key;
+      uint32_t rg;
+      uint32_t row;
+    };
+    std::vector<Entry> entries;
+    const Byte *file = sstable_->data_file_->Data();
+    for (uint32_t rg_idx = 0; rg_idx < sstable_->rowgroups_.size();
+         rg_idx++) {
+      const auto &rg = sstable_->rowgroups_[rg_idx];
+      const Byte *keys = file + static_cast<size_t>(rg.offset) +
+                         rg.key_column_offset;
+      for (uint32_t row = 0; row < rg.row_count; row++) {
+        int key = 0;
+        std::memcpy(&key, keys + row * sizeof(int), sizeof(key));
+        entries.push_back({key, rg_idx, row});
+      }
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &a, const Entry &b) { return a.key < b.key; });
+    order_.reserve(entries.size());
+    for (const auto &entry : entries) {
+      order_.emplace_back(entry.rg, entry.row);
+    }
+    rg_datas_.resize(sstable_->rowgroups_.size());
+    if (!order_.empty()) {
+      rowgroup_idx_ = order_[0].first;
+      row_idx_ = order_[0].second;
+    }
+  }
 
   void LoadCurrent() {
     valid_ = false;
@@ -38,6 +83,15 @@ class SSTableIterator : public Iterator {
     // 基于 mmap 的 RowGroup 重建当前行
     const Byte *base =
         sstable_->data_file_->Data() + static_cast<size_t>(rg.offset);
+    if (!order_.empty()) {
+      if (rg_datas_[rowgroup_idx_].Base() == nullptr) {
+        rg_datas_[rowgroup_idx_] = RowGroupData(rg, base);
+      }
+    } else if (rg_data_idx_ != rowgroup_idx_) {
+      rg_data_ = RowGroupData(rg, base);
+      rg_data_idx_ = rowgroup_idx_;
+    }
+    const auto &rg_data = order_.empty() ? rg_data_ : rg_datas_[rowgroup_idx_];
     row_buffer_.clear();
 
     // 首先从 key 列读取 key（如果存在）
@@ -57,47 +111,24 @@ class SSTableIterator : public Iterator {
     }
 
     for (size_t col_idx = 0; col_idx < rg.columns.size(); col_idx++) {
-      const auto &col = rg.columns[col_idx];
-      auto type = column_types_[col_idx]->GetType();
-      if (type == ValueType::Type::String) {
-        const Byte *offsets_base = base + col.offset;
-        uint32_t start = 0;
-        uint32_t end = 0;
-        std::memcpy(&start, offsets_base + row_idx_ * sizeof(uint32_t),
-                    sizeof(uint32_t));
-        std::memcpy(&end, offsets_base + (row_idx_ + 1) * sizeof(uint32_t),
-                    sizeof(uint32_t));
-        const Byte *data_base =
-            offsets_base + (rg.row_count + 1) * sizeof(uint32_t);
-        uint32_t len = end - start;
-        row_buffer_.append(reinterpret_cast<const char *>(&len), sizeof(len));
-        if (len > 0) {
-          row_buffer_.append(reinterpret_cast<const char *>(data_base + start),
-                             len);
-        }
-        // 只有在没有 key 列时才从 primary_key_idx_ 读取 key
-        if (col_idx == primary_key_idx_ && rg.key_column_size == 0) {
-          key_ = Slice{const_cast<Byte *>(data_base + start),
-                       static_cast<uint16_t>(len)};
-        }
-      } else {
-        uint32_t len = 0;
-        if (type == ValueType::Type::Int) {
-          len = sizeof(int);
-        } else if (type == ValueType::Type::Double) {
-          len = sizeof(double);
-        }
-        const Byte *data_ptr =
-            base + col.offset + row_idx_ * static_cast<size_t>(len);
-        row_buffer_.append(reinterpret_cast<const char *>(&len), sizeof(len));
-        if (len > 0) {
-          row_buffer_.append(reinterpret_cast<const char *>(data_ptr), len);
-        }
-        // 只有在没有 key 列时才从 primary_key_idx_ 读取 key
-        if (col_idx == primary_key_idx_ && rg.key_column_size == 0) {
-          key_ =
-              Slice{const_cast<Byte *>(data_ptr), static_cast<uint16_t>(len)};
-        }
+      // 统一经 ColumnReader 定位，处理 null bitmap 与字典编码
+      const Byte *ptr = nullptr;
+      uint32_t len = 0;
+      uint64_t scratch = 0;
+      // key 可能指向解码出的主键值，需在整行读取期间保持有效
+      uint64_t &slot = col_idx == primary_key_idx_ ? key_scratch_ : scratch;
+      if (!ColumnReader::GetValuePointer(rg_data, row_idx_, col_idx,
+                                         column_types_[col_idx]->GetType(), ptr,
+                                         len, slot)) {
+        return;
+      }
+      row_buffer_.append(reinterpret_cast<const char *>(&len), sizeof(len));
+      if (len > 0) {
+        row_buffer_.append(reinterpret_cast<const char *>(ptr), len);
+      }
+      // 只有在没有 key 列时才从 primary_key_idx_ 读取 key
+      if (col_idx == primary_key_idx_ && rg.key_column_size == 0) {
+        key_ = Slice{const_cast<Byte *>(ptr), static_cast<uint16_t>(len)};
       }
     }
     value_ = Slice{row_buffer_};
@@ -114,6 +145,10 @@ public:
     if (primary_key_idx_ >= column_types_.size()) {
       primary_key_idx_ = 0;
     }
+    if (sstable_ && !sstable_->key_ordered_ && sstable_->data_file_ &&
+        sstable_->data_file_->Valid()) {
+      BuildKeyOrder();
+    }
     LoadCurrent();
   }
 
@@ -127,6 +162,9 @@ public:
     column_types_ = std::move(other.column_types_);
     primary_key_idx_ = other.primary_key_idx_;
     row_buffer_ = std::move(other.row_buffer_);
+    order_ = std::move(other.order_);
+    order_pos_ = other.order_pos_;
+    rg_datas_ = std::move(other.rg_datas_);
 
     other.valid_ = false;
   }
@@ -141,6 +179,10 @@ public:
     column_types_ = std::move(other.column_types_);
     primary_key_idx_ = other.primary_key_idx_;
     row_buffer_ = std::move(other.row_buffer_);
+    rg_data_idx_ = SIZE_MAX;
+    order_ = std::move(other.order_);
+    order_pos_ = other.order_pos_;
+    rg_datas_ = std::move(other.rg_datas_);
 
     other.valid_ = false;
     return *this;
@@ -152,6 +194,16 @@ public:
     if (!valid_) {
       return;
     }
+    if (!order_.empty()) {
+      if (++order_pos_ >= order_.size()) {
+        valid_ = false;
+        return;
+      }
+      rowgroup_idx_ = order_[order_pos_].first;
+      row_idx_ = order_[order_pos_].second;
+      LoadCurrent();
+      return;
+    }
     row_idx_++;
     if (rowgroup_idx_ < sstable_->rowgroups_.size() &&
         row_idx_ >= sstable_->rowgroups_[rowgroup_idx_].row_count) {
@@ -0,0 +1,76 @@
+#include "storage/lsmtree/BinaryFuseFilter.hpp"
+#include "storage/lsmtree/BloomFilter.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+std::vector<uint64_t> MakeHashes(const std::string &prefix, size_t n) {
+  std::vector<uint64_t> hashes;
+  for (size_t i = 0; i < n; i++) {
+    std::string key = prefix + std::to_string(i);
+    hashes.push_back(DB::BloomFilter::HashKey(key.data(), key.size()));
+  }
+  return hashes;
+}
+} // namespace
+
+TEST(BinaryFuseFilterTest, NoFalseNegatives) {
+  using namespace DB;
+  for (size_t n : {1u, 2u, 3u, 17u, 1000u, 50000u}) {
+    auto hashes = MakeHashes("key_", n);
+    std::string data;
+    ASSERT_TRUE(BinaryFuseFilter::Build(hashes.data(), hashes.size(), data))
+        << "n=" << n;
+    BinaryFuseFilter filter(data);
+    ASSERT_TRUE(filter.Valid());
+    for (auto h : hashes) {
+      ASSERT_TRUE(filter.MayContainHash(h)) << "n=" << n;
+    }
+  }
+}
+
+TEST(BinaryFuseFilterTest, LowFalsePositiveRateAndSize) {
+  using namespace DB;
+  constexpr size_t kKeys = 100000;
+  auto hashes = MakeHashes("key_", kKeys);
+  std::string data;
+  ASSERT_TRUE(BinaryFuseFilter::Build(hashes.data(), hashes.size(), data));
+  // 约 9 bit/key，明显小于 bloom 的 12 bit/key
+  EXPECT_LT(data.size() * 8, kKeys * 10);
+
+  BinaryFuseFilter filter(data);
+  auto misses = MakeHashes("miss_", kKeys);
+  size_t false_positives = 0;
+  for (auto h : misses) {
+    false_positives += filter.MayContainHash(h) ? 1 : 0;
+  }
+  EXPECT_LT(false_positives, kKeys / 100);
+
+  std::vector<uint64_t> bitmap((misses.size() + 63) / 64);
+  filter.MayContainBatch(misses.data(), misses.size(), bitmap.data());
+  for (size_t i = 0; i < misses.size(); i++) {
+    ASSERT_EQ((bitmap[i / 64] >> (i % 64)) & 1,
+              filter.MayContainHash(misses[i]) ? 1u : 0u);
+  }
+}
+
+TEST(BinaryFuseFilterTest, DuplicatesAndCorruptData) {
+  using namespace DB;
+  auto hashes = MakeHashes("key_", 500);
+  auto doubled = hashes;
+  doubled.insert(doubled.end(), hashes.begin(), hashes.end());
+  std::string data;
+  ASSERT_TRUE(BinaryFuseFilter::Build(doubled.data(), doubled.size(), data));
+  BinaryFuseFilter filter(data);
+  for (auto h : hashes) {
+    EXPECT_TRUE(filter.MayContainHash(h));
+  }
+
+  BinaryFuseFilter truncated;
+  EXPECT_FALSE(truncated.Reset(std::string_view(data).substr(0, 10)));
+  EXPECT_FALSE(
+      truncated.Reset(std::string_view(data).substr(0, data.size() - 1)));
+  EXPECT_FALSE(truncated.MayContainHash(hashes[0]));
+}
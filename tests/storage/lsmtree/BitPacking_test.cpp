@@ -0,0 +1,77 @@
+#include "storage/lsmtree/BitPacking.hpp"
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+void ExpectRoundTrip(const std::vector<int> &values) {
+  using namespace DB;
+  std::string data;
+  BitPackEncode(values.data(), static_cast<uint32_t>(values.size()), data);
+  BitPackedView view(data.data(), static_cast<uint32_t>(values.size()));
+
+  std::vector<int> decoded(values.size());
+  view.Decode(decoded.data());
+  ASSERT_EQ(decoded, values);
+  for (uint32_t b = 0; b < view.BlockCount(); b++) {
+    int min = 0, max = 0;
+    view.BlockRange(b, min, max);
+    for (uint32_t i = 0; i < view.BlockRows(b); i++) {
+      int v = values[b * kBitPackBlockSize + i];
+      ASSERT_LE(min, v);
+      ASSERT_GE(max, v);
+    }
+  }
+  for (uint32_t i = 0; i < values.size(); i += 7) {
+    ASSERT_EQ(view.Get(i), values[i]) << "row " << i;
+  }
+}
+} // namespace
+
+TEST(BitPackingTest, RoundTrip) {
+  std::mt19937 rng(42);
+  std::vector<int> random(5000);
+  for (auto &v : random) {
+    v = static_cast<int>(rng());
+  }
+  ExpectRoundTrip(random);
+
+  std::vector<int> small(3001);
+  for (auto &v : small) {
+    v = -500 + static_cast<int>(rng() % 1000);
+  }
+  ExpectRoundTrip(small);
+
+  constexpr int kMin = std::numeric_limits<int>::min();
+  constexpr int kMax = std::numeric_limits<int>::max();
+  ExpectRoundTrip({kMin, kMax, 0, kMax, kMin});
+  ExpectRoundTrip(std::vector<int>(2048, 7));
+  ExpectRoundTrip({kMin, kMin / 2, 0, kMax / 2, kMax});
+  ExpectRoundTrip({1});
+}
+
+TEST(BitPackingTest, SortedColumnsPackTightly) {
+  using namespace DB;
+  // 自增 id 与等间隔时间戳落在直线上，残差为 0
+  std::vector<int> ids(4096);
+  std::vector<int> timestamps(4096);
+  std::mt19937 rng(7);
+  for (int i = 0; i < 4096; i++) {
+    ids[i] = 100000 + i;
+    timestamps[i] = 1700000000 + i * 60 + static_cast<int>(rng() % 4);
+  }
+  ExpectRoundTrip(ids);
+  ExpectRoundTrip(timestamps);
+
+  std::string data;
+  BitPackEncode(ids.data(), static_cast<uint32_t>(ids.size()), data);
+  EXPECT_EQ(data.size(), 4 * kBitPackHeaderSize);
+  data.clear();
+  BitPackEncode(timestamps.data(), static_cast<uint32_t>(timestamps.size()),
+                data);
+  // 抖动 < 4，每个值 2 bit
+  EXPECT_LE(data.size(), 4 * kBitPackHeaderSize + 4096 * 2 / 8);
+}
@@ -117,3 +117,44 @@ TEST(BloomFilterTest, ResetSwitchesData) {
                builder.GetData().size());
   EXPECT_TRUE(filter.MayContain(key));
 }
+
+TEST(BloomFilterTest, BatchMatchesSingleProbe) {
+  using namespace DB;
+  constexpr size_t kKeys = 1000;
+  BloomFilterBuilder scalar_builder(kKeys);
+  BloomFilterBuilder batch_builder(kKeys);
+  std::vector<uint64_t> added;
+  for (size_t i = 0; i < kKeys; ++i) {
+    std::string key = "key_" + std::to_string(i);
+    scalar_builder.AddKey(Slice{key});
+    added.push_back(BloomFilter::HashKey(key.data(), key.size()));
+  }
+  batch_builder.AddHashes(added.data(), added.size());
+  EXPECT_EQ(scalar_builder.GetData(), batch_builder.GetData());
+
+  // 一半插入过，一半未插入，非 64 整数倍以覆盖 bitmap 尾部
+  std::vector<std::string> probes;
+  for (size_t i = 0; i < 1500; i += 2) {
+    probes.push_back("key_" + std::to_string(i));
+    probes.push_back("miss_" + std::to_string(i));
+  }
+  probes.push_back("tail");
+  std::vector<uint64_t> hashes;
+  for (const auto &p : probes) {
+    hashes.push_back(BloomFilter::HashKey(p.data(), p.size()));
+  }
+
+  BloomFilter filter(batch_builder.GetData());
+  std::vector<uint64_t> bitmap((hashes.size() + 63) / 64, ~uint64_t{0});
+  filter.MayContainBatch(hashes.data(), hashes.size(), bitmap.data());
+  for (size_t i = 0; i < probes.size(); ++i) {
+    bool batch_hit = (bitmap[i / 64] >> (i % 64)) & 1;
+    EXPECT_EQ(batch_hit, filter.MayContain(Slice{probes[i]})) << probes[i];
+  }
+
+  BloomFilter invalid(std::string_view{});
+  invalid.MayContainBatch(hashes.data(), hashes.size(), bitmap.data());
+  for (auto word : bitmap) {
+    EXPECT_EQ(word, 0u);
+  }
+}
@@ -0,0 +1,155 @@
+#include "storage/lsmtree/ChunkCache.hpp"
+#include "buffer/BufferPoolManager.hpp"
+#include "storage/lsmtree/ColumnReader.hpp"
+#include "storage/lsmtree/RowCodec.hpp"
+#include "storage/lsmtree/SSTable.hpp"
+#include "storage/lsmtree/Slice.hpp"
+#include "storage/lsmtree/TableOperator.hpp"
+#include "storage/lsmtree/builder/SSTableBuilder.hpp"
+#include "type/Int.hpp"
+#include "type/String.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+DB::ChunkBufferRef MakeBuffer(size_t size, char fill) {
+  return std::make_shared<DB::ChunkBuffer>(size, fill);
+}
+
+DB::ChunkCache::Key KeyOf(uint64_t file, uint32_t rg, uint32_t col) {
+  return {file, rg, col, DB::ChunkCache::Form::Decompressed};
+}
+} // namespace
+
+TEST(ChunkCacheTest, LookupInsertErase) {
+  using namespace DB;
+  ChunkCache cache(1 << 20);
+
+  EXPECT_EQ(cache.Lookup(KeyOf(1, 0, 2)), nullptr);
+  auto buffer = MakeBuffer(128, 'a');
+  cache.Insert(KeyOf(1, 0, 2), buffer);
+  EXPECT_EQ(cache.Lookup(KeyOf(1, 0, 2)), buffer);
+
+  // 同一列的另一种形态、其它文件互不影响
+  auto values = KeyOf(1, 0, 2);
+  values.form = ChunkCache::Form::Values;
+  EXPECT_EQ(cache.Lookup(values), nullptr);
+  EXPECT_EQ(cache.Lookup(KeyOf(2, 0, 2)), nullptr);
+
+  cache.Insert(KeyOf(1, 1, 0), MakeBuffer(64, 'b'));
+  cache.Insert(KeyOf(2, 0, 2), MakeBuffer(64, 'c'));
+  cache.EraseFile(1);
+  EXPECT_EQ(cache.Lookup(KeyOf(1, 0, 2)), nullptr);
+  EXPECT_EQ(cache.Lookup(KeyOf(1, 1, 0)), nullptr);
+  EXPECT_NE(cache.Lookup(KeyOf(2, 0, 2)), nullptr);
+  EXPECT_EQ(cache.Hits(), 2u);
+  EXPECT_EQ(cache.Misses(), 5u);
+
+  // 被淘汰的缓冲区由持有方继续使用
+  EXPECT_EQ((*buffer)[0], 'a');
+}
+
+TEST(ChunkCacheTest, ScanResistantWithinBudget) {
+  using namespace DB;
+  constexpr size_t kCapacity = 1 << 20;
+  constexpr size_t kChunk = 1024;
+  ChunkCache cache(kCapacity);
+
+  // 热数据插入后再命中一次，晋升到保护段
+  for (uint32_t i = 0; i < 64; i++) {
+    cache.Insert(KeyOf(1, i, 0), MakeBuffer(kChunk, 'h'));
+    ASSERT_NE(cache.Lookup(KeyOf(1, i, 0)), nullptr);
+  }
+  // 只插入过一次的冷数据
+  for (uint32_t i = 0; i < 64; i++) {
+    cache.Insert(KeyOf(2, i, 0), MakeBuffer(kChunk, 'c'));
+  }
+  // 一次性全表扫描，总量远超容量
+  for (uint32_t i = 0; i < 4096; i++) {
+    cache.Insert(KeyOf(3, i, 0), MakeBuffer(kChunk, 's'));
+    EXPECT_LE(cache.Usage(), kCapacity);
+  }
+
+  for (uint32_t i = 0; i < 64; i++) {
+    EXPECT_NE(cache.Lookup(KeyOf(1, i, 0)), nullptr) << "hot " << i;
+    EXPECT_EQ(cache.Lookup(KeyOf(2, i, 0)), nullptr) << "cold " << i;
+  }
+
+  // 超过分片容量一半的缓冲区不缓存
+  cache.Insert(KeyOf(4, 0, 0), MakeBuffer(kCapacity / 16, 'x'));
+  EXPECT_EQ(cache.Lookup(KeyOf(4, 0, 0)), nullptr);
+}
+
+TEST(ChunkCacheTest, RowGroupDataSharesCachedChunks) {
+  using namespace DB;
+  std::filesystem::path column{"chunk_cache_test_file"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(column);
+      });
+  std::vector<std::shared_ptr<ValueType>> types{std::make_shared<Int>(),
+                                                std::make_shared<Int>(),
+                                                std::make_shared<String>()};
+  constexpr int kRows = 2000;
+  auto device = [](int i) {
+    return "device-" + std::to_string(1000000 + i % 50) + "-eu-west-1";
+  };
+  SSTableBuilder builder(column, 0, types, 0, DEFAULT_KEY_FILTER_TYPE, {}, {},
+                         ColumnCodec::LZ4);
+  for (int i = 0; i < kRows; i++) {
+    std::string row;
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(i));
+    RowCodec::AppendValue(row, ValueType::Type::Int,
+                          std::to_string(i * 37 % 1000));
+    RowCodec::AppendValue(row, ValueType::Type::String, device(i));
+    EXPECT_TRUE(builder.Add(Slice{i}, Slice{row}));
+  }
+  EXPECT_TRUE(builder.Finish().ok());
+
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(128, dm);
+  auto sst = std::make_shared<SSTable>();
+  sst->sstable_id_ = 0;
+  ASSERT_TRUE(TableOperator::ReadSSTable(column, sst, types, bpm).ok());
+  const auto &rg = sst->rowgroups_[0];
+  ASSERT_EQ(rg.columns[2].codec, ColumnCodec::LZ4);
+  ASSERT_EQ(rg.columns[1].encoding, ColumnEncoding::BitPacked);
+
+  ChunkCache cache(16 << 20);
+  const Byte *chunk = nullptr;
+  const Byte *values = nullptr;
+  {
+    RowGroupData data(*sst, 0, &cache);
+    chunk = data.Column(2);
+    ASSERT_NE(data.Values(1), nullptr);
+    values = data.Values(1)->data();
+  }
+  // 第二个上下文直接命中缓存，拿到同一块缓冲区
+  RowGroupData data(*sst, 0, &cache);
+  uint64_t hits = cache.Hits();
+  EXPECT_EQ(data.Column(2), chunk);
+  EXPECT_EQ(data.Values(1)->data(), values);
+  EXPECT_EQ(cache.Hits(), hits + 2);
+
+  for (uint32_t i = 0; i < rg.row_count; i += 97) {
+    const Byte *ptr = nullptr;
+    uint32_t len = 0;
+    uint64_t scratch = 0;
+    ASSERT_TRUE(ColumnReader::GetValuePointer(data, i, 1, ValueType::Type::Int,
+                                              ptr, len, scratch));
+    EXPECT_EQ(ptr, values + i * sizeof(int));
+    int v = 0;
+    std::memcpy(&v, ptr, sizeof(v));
+    EXPECT_EQ(v, static_cast<int>(i) * 37 % 1000);
+  }
+
+  cache.EraseFile(sst->cache_id_);
+  EXPECT_EQ(cache.Usage(), 0u);
+}
@@ -0,0 +1,154 @@
+#include "storage/lsmtree/ColumnStatistics.hpp"
+#include "buffer/BufferPoolManager.hpp"
+#include "common/Hash.hpp"
+#include "storage/lsmtree/RowCodec.hpp"
+#include "storage/lsmtree/SSTable.hpp"
+#include "storage/lsmtree/Slice.hpp"
+#include "storage/lsmtree/TableOperator.hpp"
+#include "storage/lsmtree/TableStatistics.hpp"
+#include "storage/lsmtree/builder/SSTableBuilder.hpp"
+#include "type/Int.hpp"
+#include "type/String.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST(ColumnStatisticsTest, HyperLogLogEstimateAndMerge) {
+  using namespace DB;
+  HyperLogLog small;
+  EXPECT_EQ(small.Estimate(), 0u);
+  for (int round = 0; round < 3; round++) {
+    for (uint64_t i = 0; i < 20; i++) {
+      small.Add(Hash64(i));
+    }
+  }
+  // 小基数走 linear counting，基本精确
+  EXPECT_EQ(small.Estimate(), 20u);
+
+  HyperLogLog a;
+  HyperLogLog b;
+  constexpr uint64_t kDistinct = 100000;
+  for (uint64_t i = 0; i < kDistinct; i++) {
+    (i % 2 == 0 ? a : b).Add(Hash64(i));
+    // 重叠部分不重复计数
+    if (i % 10 == 0) {
+      (i % 2 == 0 ? b : a).Add(Hash64(i));
+    }
+  }
+  a.Merge(b);
+  double error = std::abs(static_cast<double>(a.Estimate()) - kDistinct) /
+                 static_cast<double>(kDistinct);
+  EXPECT_LT(error, 0.08);
+
+  std::string data;
+  a.Serialize(data);
+  HyperLogLog restored;
+  const Byte *p = data.data();
+  ASSERT_TRUE(restored.Deserialize(p, data.data() + data.size()));
+  EXPECT_EQ(p, data.data() + data.size());
+  EXPECT_EQ(restored.Estimate(), a.Estimate());
+}
+
+TEST(ColumnStatisticsTest, HistogramFractions) {
+  using namespace DB;
+  std::mt19937 rng(3);
+  std::vector<double> values(50000);
+  for (auto &v : values) {
+    v = static_cast<double>(rng() % 1000);
+  }
+  auto histogram = Histogram::Build(values);
+  ASSERT_FALSE(histogram.Empty());
+  EXPECT_LE(histogram.Buckets().size(), Histogram::kBuckets);
+  EXPECT_EQ(histogram.Total(), values.size());
+  EXPECT_EQ(histogram.FractionBelow(-1.0, true), 0.0);
+  EXPECT_EQ(histogram.FractionBelow(1000.0, false), 1.0);
+  EXPECT_NEAR(histogram.FractionBelow(250.0, false), 0.25, 0.03);
+  EXPECT_NEAR(histogram.FractionBelow(900.0, true), 0.9, 0.03);
+
+  // 偏斜分布：大部分值集中在 0
+  std::vector<double> skewed(10000, 0.0);
+  for (int i = 0; i < 1000; i++) {
+    skewed.push_back(i);
+  }
+  auto skewed_histogram = Histogram::Build(skewed);
+  EXPECT_GT(skewed_histogram.FractionBelow(0.0, true), 0.85);
+
+  // 合并后收缩，总数不变
+  histogram.Merge(skewed_histogram);
+  histogram.Compact(8);
+  EXPECT_LE(histogram.Buckets().size(), 8u);
+  EXPECT_EQ(histogram.Total(), values.size() + skewed.size());
+}
+
+TEST(ColumnStatisticsTest, RowGroupStatisticsPersisted) {
+  using namespace DB;
+  std::filesystem::path column{"column_statistics_test_file"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(column);
+      });
+  std::vector<std::shared_ptr<ValueType>> types{std::make_shared<Int>(),
+                                                std::make_shared<Int>(),
+                                                std::make_shared<String>()};
+  constexpr int kRows = 6000;
+  SSTableBuilder builder(column, 0, types, 0);
+  for (int i = 0; i < kRows; i++) {
+    std::string row;
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(i));
+    RowCodec::AppendValue(row, ValueType::Type::Int,
+                          i % 5 == 0 ? "Null" : std::to_string(i % 100));
+    RowCodec::AppendValue(row, ValueType::Type::String,
+                          "tenant-" + std::to_string(i % 7));
+    EXPECT_TRUE(builder.Add(Slice{i}, Slice{row}));
+  }
+  EXPECT_TRUE(builder.Finish().ok());
+
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(128, dm);
+  auto sst = std::make_shared<SSTable>();
+  sst->sstable_id_ = 0;
+  ASSERT_TRUE(TableOperator::ReadSSTable(column, sst, types, bpm).ok());
+
+  TableStatistics table;
+  table.columns.resize(types.size());
+  for (const auto &rg : sst->rowgroups_) {
+    table.row_count += rg.row_count;
+    for (size_t i = 0; i < types.size(); i++) {
+      EXPECT_EQ(rg.columns[i].stats.row_count, rg.row_count);
+      table.columns[i].Merge(rg.columns[i].stats);
+    }
+  }
+  EXPECT_EQ(table.row_count, static_cast<uint64_t>(kRows));
+  EXPECT_EQ(table.columns[1].null_count, static_cast<uint64_t>(kRows / 5));
+  EXPECT_EQ(table.columns[2].null_count, 0u);
+  EXPECT_EQ(table.columns[2].distinct.Estimate(), 7u);
+  EXPECT_NEAR(static_cast<double>(table.columns[1].distinct.Estimate()), 80,
+              2);
+  EXPECT_NEAR(static_cast<double>(table.columns[0].distinct.Estimate()),
+              kRows, kRows * 0.08);
+  EXPECT_TRUE(table.columns[2].histogram.Empty());
+  EXPECT_EQ(table.columns[1].histogram.Total(),
+            static_cast<uint64_t>(kRows - kRows / 5));
+
+  // 选择率：范围谓词来自直方图，等值谓词来自基数，NULL 不满足任何谓词
+  using Op = FunctionComparison::Operator;
+  ScanPredicate less{1, ValueType::Type::Int, Op::Less};
+  less.const_int = 50;
+  EXPECT_NEAR(table.EstimateSelectivity(less), 0.8 * 0.5, 0.05);
+  ScanPredicate equals{2, ValueType::Type::String, Op::Equals};
+  equals.const_string = "tenant-3";
+  EXPECT_NEAR(table.EstimateSelectivity(equals), 1.0 / 7, 0.01);
+  ScanPredicate outside{1, ValueType::Type::Int, Op::Equals};
+  outside.const_int = 1000;
+  EXPECT_EQ(table.EstimateSelectivity(outside), 0.0);
+  ScanPredicate key{0, ValueType::Type::Int, Op::GreaterOrEquals};
+  key.const_int = kRows - 60;
+  EXPECT_LT(table.EstimateSelectivity(key), table.EstimateSelectivity(less));
+}
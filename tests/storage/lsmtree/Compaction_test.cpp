@@ -453,3 +453,132 @@ TEST_F(CompactionTest, DeleteReinsertCompaction) {
     }
   }
 }
+
+// 最底层按非主键列聚簇后，点查、批量点查与再次 compaction 仍然正确
+TEST_F(CompactionTest, ClusteredBottomLevelKeepsKeyLookups) {
+  using namespace DB;
+
+  std::vector<std::shared_ptr<ValueType>> types{std::make_shared<Int>(),
+                                                std::make_shared<Int>(),
+                                                std::make_shared<Int>()};
+  LSMTree lsm(path_, bpm_, types, 0, false);
+  RowGroupSizing sizing;
+  sizing.target_rows = 64;
+  lsm.SetRowGroupSizing(sizing);
+  lsm.SetClusterSpec({{1, 2}, ClusterCurve::Hilbert});
+
+  const int total_keys = 2400;
+  auto make_row = [](int key, int round) {
+    std::string row;
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(key));
+    RowCodec::AppendValue(row, ValueType::Type::Int,
+                          std::to_string(key * 7919 % 16));
+    RowCodec::AppendValue(row, ValueType::Type::Int,
+                          std::to_string(key * 104729 % 100 + round));
+    return row;
+  };
+  // 等待 L0 合并完
+  auto wait_l0_empty = [&] {
+    for (int i = 0; i < 200; i++) {
+      {
+        std::shared_lock lock(lsm.GetLevelLatch());
+        if (lsm.GetLevels()[0].sstables.empty()) {
+          return;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    {
+      std::shared_lock lock(lsm.GetLevelLatch());
+      for (size_t l = 0; l < lsm.GetLevels().size(); l++)
+        for (auto &m : lsm.GetLevels()[l].sstables)
+          fprintf(stderr, "DBG level %zu id %u compacting %d\n", l,
+                  m.sstable_id, (int)m.being_compacted);
+    }
+    FAIL() << "L0 compaction did not finish";
+  };
+  // 三个文件写入全部 key，第四个文件覆盖其中三分之一
+  for (int i = 0; i < total_keys; i++) {
+    EXPECT_TRUE(lsm.Insert(Slice{i}, Slice{make_row(i, 0)}).ok());
+    if (i % 800 == 799) {
+      EXPECT_TRUE(lsm.FlushToSST().ok());
+    }
+  }
+  for (int i = 0; i < total_keys; i += 3) {
+    EXPECT_TRUE(lsm.Insert(Slice{i}, Slice{make_row(i, 1)}).ok());
+  }
+  EXPECT_TRUE(lsm.FlushToSST().ok());
+  lsm.TriggerCompaction();
+  wait_l0_empty();
+
+  auto has_clustered = [&] {
+    std::shared_lock lock(lsm.GetLevelLatch());
+    for (size_t level = 1; level < lsm.GetLevels().size(); level++) {
+      for (const auto &meta : lsm.GetLevels()[level].sstables) {
+        auto sst = lsm.GetSSTable(meta.sstable_id);
+        if (sst && !sst->key_ordered_) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+  ASSERT_TRUE(has_clustered());
+
+  auto expect_row = [&](int key, const Slice &row) {
+    Slice value;
+    ASSERT_TRUE(RowCodec::DecodeColumn(row, 2, &value));
+    int v = 0;
+    std::memcpy(&v, value.GetData(), sizeof(int));
+    EXPECT_EQ(v, key * 104729 % 100 + (key % 3 == 0 ? 1 : 0)) << key;
+  };
+  std::vector<Slice> keys;
+  for (int i = 0; i < total_keys; i++) {
+    Slice row;
+    ASSERT_TRUE(lsm.GetValue(Slice{i}, &row).ok()) << i;
+    expect_row(i, row);
+    keys.emplace_back(i);
+  }
+  keys.emplace_back(total_keys + 5);
+  std::vector<Slice> values;
+  std::vector<Status> statuses;
+  lsm.MultiGet(keys, values, statuses);
+  for (int i = 0; i < total_keys; i++) {
+    ASSERT_TRUE(statuses[i].ok()) << i;
+    expect_row(i, values[i]);
+  }
+  EXPECT_FALSE(statuses[total_keys].ok());
+
+  // 删除后再次合并，聚簇文件作为输入按主键顺序归并
+  for (int i = 0; i < total_keys; i += 5) {
+    EXPECT_TRUE(lsm.Remove(Slice{i}).ok());
+  }
+  for (int f = 0; f < 4; f++) {
+    for (int i = f; i < total_keys; i += 40) {
+      if (i % 5 != 0) {
+        EXPECT_TRUE(lsm.Insert(Slice{i}, Slice{make_row(i, 1)}).ok());
+      }
+    }
+    EXPECT_TRUE(lsm.FlushToSST().ok());
+  }
+  lsm.TriggerCompaction();
+  wait_l0_empty();
+  EXPECT_TRUE(has_clustered());
+  for (int i = 0; i < total_keys; i++) {
+    Slice row;
+    if (i % 5 == 0) {
+      EXPECT_FALSE(lsm.GetValue(Slice{i}, &row).ok()) << i;
+      continue;
+    }
+    ASSERT_TRUE(lsm.GetValue(Slice{i}, &row).ok()) << i;
+    if (i % 40 < 4) {
+      Slice value;
+      ASSERT_TRUE(RowCodec::DecodeColumn(row, 2, &value));
+      int v = 0;
+      std::memcpy(&v, value.GetData(), sizeof(int));
+      EXPECT_EQ(v, i * 104729 % 100 + 1) << i;
+    } else {
+      expect_row(i, row);
+    }
+  }
+}
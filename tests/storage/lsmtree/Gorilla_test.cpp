@@ -0,0 +1,67 @@
+#include "storage/lsmtree/Gorilla.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+uint64_t Bits(double v) {
+  uint64_t bits = 0;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+
+std::string ExpectRoundTrip(const std::vector<double> &values) {
+  using namespace DB;
+  std::string data;
+  GorillaEncode(values.data(), static_cast<uint32_t>(values.size()), data);
+  GorillaView view(data.data(), static_cast<uint32_t>(values.size()));
+
+  // 按位比较，NaN 与 -0.0 也需原样还原
+  std::vector<double> decoded(values.size());
+  view.Decode(decoded.data());
+  for (size_t i = 0; i < values.size(); i++) {
+    EXPECT_EQ(Bits(decoded[i]), Bits(values[i])) << "row " << i;
+  }
+  for (uint32_t i = 0; i < values.size(); i += 5) {
+    EXPECT_EQ(Bits(view.Get(i)), Bits(values[i])) << "row " << i;
+  }
+  return data;
+}
+} // namespace
+
+TEST(GorillaTest, RoundTrip) {
+  std::mt19937_64 rng(42);
+  std::vector<double> random(1000);
+  for (auto &v : random) {
+    uint64_t bits = rng();
+    std::memcpy(&v, &bits, sizeof(v));
+  }
+  ExpectRoundTrip(random);
+
+  constexpr double kInf = std::numeric_limits<double>::infinity();
+  constexpr double kMin = std::numeric_limits<double>::denorm_min();
+  ExpectRoundTrip({0.0, -0.0, kInf, -kInf, std::nan(""), kMin, -kMin, 1e308,
+                   0.0, 0.0, 1.0});
+  ExpectRoundTrip({42.5});
+  ExpectRoundTrip(std::vector<double>(700, 3.25));
+}
+
+TEST(GorillaTest, SlowlyChangingGaugeCompresses) {
+  // 缓慢变化的 gauge：大多数时刻取值不变，偶尔小幅跳动
+  std::mt19937 rng(7);
+  std::vector<double> gauge(4096);
+  double v = 72.5;
+  for (auto &g : gauge) {
+    if (rng() % 8 == 0) {
+      v += static_cast<double>(static_cast<int>(rng() % 5) - 2) * 0.25;
+    }
+    g = v;
+  }
+  auto data = ExpectRoundTrip(gauge);
+  EXPECT_LT(data.size() * 5, gauge.size() * sizeof(double));
+}
@@ -2,12 +2,15 @@
 #include "storage/lsmtree/LSMTree.hpp"
 #include "storage/lsmtree/RowCodec.hpp"
 #include "storage/lsmtree/Slice.hpp"
+#include "type/Double.hpp"
 #include "type/Int.hpp"
 #include "type/ValueType.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <filesystem>
 #include <functional>
+#include <map>
 #include <gtest/gtest.h>
 #include <memory>
 #include <string>
@@ -286,3 +289,358 @@ TEST(LSMTreeTest, RemoveNonExistentKey) {
   EXPECT_TRUE(lsm.Insert(Slice{1}, Slice{r}).ok());
   EXPECT_TRUE(lsm.GetValue(Slice{1}, &row).ok());
 }
+
+// flush 后主键点查与主键范围谓词走 key 列索引
+TEST(LSMTreeTest, PrimaryKeyLookupAndRangeAfterFlush) {
+  using namespace DB;
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(4, dm);
+  std::filesystem::path path{"lsm_table"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(path);
+        std::filesystem::remove(path.string() + ".wal");
+      });
+  std::vector<std::shared_ptr<ValueType>> types{std::make_shared<Int>(),
+                                                std::make_shared<Int>()};
+  LSMTree lsm(path, bpm, types, 0, false);
+
+  // 前半段线性（learned index），后半段间隔不规则（稀疏索引）
+  std::vector<int> keys;
+  int next_key = 0;
+  for (int i = 0; i < 3000; i++) {
+    keys.push_back(next_key);
+    next_key += i < 1500 ? 3 : (i * i) % 97 + 1;
+  }
+  for (int k : keys) {
+    std::string row;
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(k));
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(k * 2));
+    EXPECT_TRUE(lsm.Insert(Slice{k}, Slice{row}).ok());
+  }
+  EXPECT_TRUE(lsm.FlushToSST().ok());
+
+  for (int k : keys) {
+    Slice row;
+    ASSERT_TRUE(lsm.GetValue(Slice{k}, &row).ok()) << "key=" << k;
+    Slice val;
+    EXPECT_TRUE(RowCodec::DecodeColumn(row, 1, &val));
+    int v = 0;
+    std::memcpy(&v, val.GetData(), sizeof(int));
+    EXPECT_EQ(v, k * 2);
+  }
+  Slice missing;
+  EXPECT_FALSE(lsm.GetValue(Slice{1}, &missing).ok());
+  EXPECT_FALSE(lsm.GetValue(Slice{-5}, &missing).ok());
+
+  auto count_matches = [&](std::vector<ScanPredicate> preds) {
+    std::vector<ColumnPtr> results;
+    bool all_filtered = false;
+    EXPECT_TRUE(
+        lsm.ScanColumnsWithPredicates({1}, results, preds, all_filtered).ok());
+    EXPECT_TRUE(all_filtered);
+    return results[0]->Size();
+  };
+  auto make_pred = [](FunctionComparison::Operator op, int c) {
+    ScanPredicate pred;
+    pred.column_idx = 0;
+    pred.column_type = ValueType::Type::Int;
+    pred.op = op;
+    pred.const_int = c;
+    return pred;
+  };
+  auto expected = [&](auto fn) {
+    return static_cast<size_t>(std::count_if(keys.begin(), keys.end(), fn));
+  };
+  using Op = FunctionComparison::Operator;
+
+  EXPECT_EQ(count_matches({make_pred(Op::GreaterOrEquals, 300),
+                           make_pred(Op::Less, 900)}),
+            expected([](int k) { return k >= 300 && k < 900; }));
+  EXPECT_EQ(count_matches({make_pred(Op::Equals, 450)}), 1u);
+  EXPECT_EQ(count_matches({make_pred(Op::Equals, 451)}), 0u);
+  EXPECT_EQ(count_matches({make_pred(Op::Greater, 5000)}),
+            expected([](int k) { return k > 5000; }));
+  EXPECT_EQ(count_matches({make_pred(Op::LessOrEquals, 4500)}),
+            expected([](int k) { return k <= 4500; }));
+}
+
+// 行缓存命中后覆盖写，点查必须看到新值
+TEST(LSMTreeTest, RowCacheInvalidatedByWrites) {
+  using namespace DB;
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(4, dm);
+  std::filesystem::path path{"lsm_table"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(path);
+        std::filesystem::remove(path.string() + ".wal");
+      });
+  std::vector<std::shared_ptr<ValueType>> types{std::make_shared<Int>(),
+                                                std::make_shared<Int>()};
+  LSMTree lsm(path, bpm, types, 0, false);
+  auto cache = std::make_shared<RowCache>(64 * 1024);
+  lsm.SetRowCache(cache);
+
+  auto make_row = [](int k, int v) {
+    std::string row;
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(k));
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(v));
+    return row;
+  };
+  auto read_value = [&](int k, int *v) {
+    Slice row;
+    if (!lsm.GetValue(Slice{k}, &row).ok()) {
+      return false;
+    }
+    Slice val;
+    EXPECT_TRUE(RowCodec::DecodeColumn(row, 1, &val));
+    std::memcpy(v, val.GetData(), sizeof(int));
+    return true;
+  };
+
+  for (int k = 0; k < 100; k++) {
+    EXPECT_TRUE(lsm.Insert(Slice{k}, Slice{make_row(k, k)}).ok());
+  }
+  EXPECT_TRUE(lsm.FlushToSST().ok());
+
+  int v = 0;
+  ASSERT_TRUE(read_value(7, &v));
+  EXPECT_EQ(v, 7);
+  ASSERT_TRUE(read_value(7, &v));
+  EXPECT_EQ(v, 7);
+  EXPECT_EQ(cache->Hits(), 1u);
+
+  EXPECT_TRUE(lsm.Insert(Slice{7}, Slice{make_row(7, 700)}).ok());
+  ASSERT_TRUE(read_value(7, &v));
+  EXPECT_EQ(v, 700);
+}
+
+// MultiGet 结果需与逐个 GetValue 一致（跨 memtable 与多个 SSTable）
+TEST(LSMTreeTest, MultiGetMatchesGetValue) {
+  using namespace DB;
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(4, dm);
+  std::filesystem::path path{"lsm_table"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(path);
+        std::filesystem::remove(path.string() + ".wal");
+      });
+  std::vector<std::shared_ptr<ValueType>> types{std::make_shared<Int>(),
+                                                std::make_shared<Int>()};
+  LSMTree lsm(path, bpm, types, 0, false);
+
+  auto insert = [&](int k, int v) {
+    std::string row;
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(k));
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(v));
+    EXPECT_TRUE(lsm.Insert(Slice{k}, Slice{row}).ok());
+  };
+  for (int k = 0; k < 2000; k += 2) {
+    insert(k, k);
+  }
+  EXPECT_TRUE(lsm.FlushToSST().ok());
+  // 覆盖部分旧 key，新 SSTable 优先
+  for (int k = 0; k < 400; k += 4) {
+    insert(k, -k);
+  }
+  EXPECT_TRUE(lsm.FlushToSST().ok());
+  for (int k = 1000; k < 1100; k += 2) {
+    insert(k, k + 1);
+  }
+
+  std::vector<Slice> keys;
+  for (int k = -10; k < 2100; k += 3) {
+    keys.emplace_back(k);
+  }
+  std::vector<Slice> values;
+  std::vector<Status> statuses;
+  lsm.MultiGet(keys, values, statuses);
+  ASSERT_EQ(values.size(), keys.size());
+  ASSERT_EQ(statuses.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    Slice expected;
+    bool found = lsm.GetValue(keys[i], &expected).ok();
+    ASSERT_EQ(statuses[i].ok(), found) << "i=" << i;
+    if (found) {
+      EXPECT_EQ(values[i].ToString(), expected.ToString()) << "i=" << i;
+    }
+  }
+}
+
+TEST(LSMTreeTest, SecondaryIndexScanMatchesLatestRows) {
+  using namespace DB;
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(4, dm);
+  std::filesystem::path path{"lsm_table"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(path);
+        std::filesystem::remove(path.string() + ".wal");
+      });
+  std::vector<std::shared_ptr<ValueType>> types{std::make_shared<Int>(),
+                                                std::make_shared<Int>()};
+  std::map<int, int> model;
+
+  auto scan = [&](LSMTree &lsm, std::vector<ScanPredicate> preds) {
+    std::vector<Slice> rows;
+    EXPECT_TRUE(lsm.IndexScan(1, preds, rows).ok());
+    std::vector<int> ids;
+    for (auto &row : rows) {
+      Slice id;
+      EXPECT_TRUE(RowCodec::DecodeColumn(row, 0, &id));
+      int v = 0;
+      std::memcpy(&v, id.GetData(), sizeof(int));
+      ids.push_back(v);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  };
+  auto expect = [&](int lo, int hi) {
+    std::vector<int> ids;
+    for (auto &[id, customer] : model) {
+      if (customer >= lo && customer < hi) {
+        ids.push_back(id);
+      }
+    }
+    return ids;
+  };
+  auto pred = [](FunctionComparison::Operator op, int c) {
+    ScanPredicate p{1, ValueType::Type::Int, op};
+    p.const_int = c;
+    return p;
+  };
+  using Op = FunctionComparison::Operator;
+
+  {
+    LSMTree lsm(path, bpm, types, 0, false);
+    auto insert = [&](int id, int customer) {
+      std::string row;
+      RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(id));
+      RowCodec::AppendValue(row, ValueType::Type::Int,
+                            std::to_string(customer));
+      EXPECT_TRUE(lsm.Insert(Slice{id}, Slice{row}).ok());
+      model[id] = customer;
+    };
+    for (int id = 0; id < 1000; id++) {
+      insert(id, id % 50);
+    }
+    EXPECT_TRUE(lsm.FlushToSST().ok());
+    EXPECT_FALSE(lsm.CreateSecondaryIndex(0).ok());
+    ASSERT_TRUE(lsm.CreateSecondaryIndex(1).ok());
+    EXPECT_TRUE(lsm.HasSecondaryIndex(1));
+
+    // 改写后旧 SSTable 的索引条目过期，回表校验后不应返回
+    for (int id = 0; id < 1000; id += 7) {
+      insert(id, 100 + id % 3);
+    }
+    EXPECT_TRUE(lsm.FlushToSST().ok());
+    for (int id = 1000; id < 1100; id++) {
+      insert(id, 7);
+    }
+    EXPECT_EQ(scan(lsm, {pred(Op::Equals, 7)}), expect(7, 8));
+    EXPECT_EQ(scan(lsm, {pred(Op::GreaterOrEquals, 100),
+                         pred(Op::Less, 102)}),
+              expect(100, 102));
+
+    size_t matches = 0;
+    size_t total = 0;
+    ASSERT_TRUE(
+        lsm.EstimateIndexMatches(1, {pred(Op::Equals, 7)}, matches, total));
+    EXPECT_GT(total, 0u);
+    EXPECT_LT(matches * 10, total);
+    // 未开 WAL，关闭前刷盘，新 SSTable 随之建索引
+    EXPECT_TRUE(lsm.FlushToSST().ok());
+  }
+
+  // 重新打开后加载已有索引文件
+  LSMTree lsm(path, bpm, types, 0, false);
+  ASSERT_TRUE(lsm.CreateSecondaryIndex(1).ok());
+  EXPECT_EQ(scan(lsm, {pred(Op::Equals, 7)}), expect(7, 8));
+  EXPECT_EQ(scan(lsm, {pred(Op::Greater, 101)}), expect(102, 103));
+}
+
+TEST(LSMTreeTest, AggregateColumnUsesRowGroupMetadata) {
+  using namespace DB;
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(4, dm);
+  std::filesystem::path path{"lsm_table"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(path);
+        std::filesystem::remove(path.string() + ".wal");
+      });
+  std::vector<std::shared_ptr<ValueType>> types{std::make_shared<Int>(),
+                                                std::make_shared<Int>(),
+                                                std::make_shared<Double>()};
+  constexpr int kRows = 20000;
+  auto amount = [](int id) { return (id % 10) * 0.5; };
+  auto is_null = [](int id) { return id % 7 == 0; };
+
+  LSMTree lsm(path, bpm, types, 0, false);
+  for (int id = 0; id < kRows; id++) {
+    std::string row;
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(id));
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(id * 3));
+    RowCodec::AppendValue(row, ValueType::Type::Double,
+                          is_null(id) ? "Null" : std::to_string(amount(id)));
+    ASSERT_TRUE(lsm.Insert(Slice{id}, Slice{row}).ok());
+  }
+  // 数据还在内存中，由调用方走常规扫描
+  ColumnAggregate result;
+  EXPECT_FALSE(lsm.AggregateColumn(2, {}, result));
+  ASSERT_TRUE(lsm.FlushToSST().ok());
+
+  auto expect = [&](int lo, int hi) {
+    ColumnAggregate e;
+    for (int id = 0; id < kRows; id++) {
+      if (id * 3 < lo || id * 3 >= hi) {
+        continue;
+      }
+      e.row_count++;
+      if (is_null(id)) {
+        continue;
+      }
+      double v = amount(id);
+      e.min = e.non_null_count == 0 ? v : std::min(e.min, v);
+      e.max = e.non_null_count == 0 ? v : std::max(e.max, v);
+      e.non_null_count++;
+      e.sum += v;
+    }
+    return e;
+  };
+  auto check = [&](const ColumnAggregate &got, const ColumnAggregate &e) {
+    EXPECT_EQ(got.row_count, e.row_count);
+    EXPECT_EQ(got.non_null_count, e.non_null_count);
+    EXPECT_DOUBLE_EQ(got.sum, e.sum);
+    EXPECT_DOUBLE_EQ(got.min, e.min);
+    EXPECT_DOUBLE_EQ(got.max, e.max);
+  };
+
+  // 没有谓词：全部来自元数据
+  ASSERT_TRUE(lsm.AggregateColumn(2, {}, result));
+  check(result, expect(0, kRows * 3));
+  EXPECT_GT(result.metadata_rowgroups, 1u);
+  EXPECT_EQ(result.scanned_rowgroups, 0u);
+
+  // 范围谓词：只有跨越边界的两个 RowGroup 需要扫描
+  using Op = FunctionComparison::Operator;
+  ScanPredicate lo{1, ValueType::Type::Int, Op::GreaterOrEquals};
+  lo.const_int = 15000;
+  ScanPredicate hi{1, ValueType::Type::Int, Op::Less};
+  hi.const_int = 45001;
+  ASSERT_TRUE(lsm.AggregateColumn(2, {lo, hi}, result));
+  check(result, expect(15000, 45001));
+  EXPECT_GT(result.metadata_rowgroups, 0u);
+  EXPECT_LE(result.scanned_rowgroups, 2u);
+
+  // 在谓词列自身上聚合
+  ASSERT_TRUE(lsm.AggregateColumn(1, {lo, hi}, result));
+  EXPECT_EQ(result.row_count, expect(15000, 45001).row_count);
+}
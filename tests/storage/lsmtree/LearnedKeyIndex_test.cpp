@@ -0,0 +1,88 @@
+#include "storage/lsmtree/LearnedKeyIndex.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST(LearnedKeyIndexTest, LinearKeysUseSingleSegment) {
+  using namespace DB;
+  std::vector<int> keys;
+  for (int i = 0; i < 100000; i++) {
+    keys.push_back(1000 + i * 5);
+  }
+  LearnedKeyIndex index;
+  index.Build(keys.data(), static_cast<uint32_t>(keys.size()), 32);
+  EXPECT_EQ(index.SegmentCount(), 1u);
+
+  for (int i = 0; i < 100000; i += 97) {
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    index.Window(keys[i], begin, end);
+    ASSERT_LE(begin, static_cast<uint32_t>(i));
+    ASSERT_GT(end, static_cast<uint32_t>(i));
+    ASSERT_LE(end - begin, 2u * 32 + 3);
+  }
+}
+
+TEST(LearnedKeyIndexTest, WindowContainsLowerBound) {
+  using namespace DB;
+  // 不规则间隔：多段模型
+  std::mt19937 rng(42);
+  std::vector<int> keys;
+  int k = -50000;
+  for (int i = 0; i < 20000; i++) {
+    k += 1 + static_cast<int>(rng() % (i % 1000 < 500 ? 3 : 200));
+    keys.push_back(k);
+  }
+  LearnedKeyIndex index;
+  index.Build(keys.data(), static_cast<uint32_t>(keys.size()), 16);
+  ASSERT_FALSE(index.Empty());
+  EXPECT_GT(index.SegmentCount(), 1u);
+
+  for (int probe = keys.front() - 10; probe <= keys.back() + 10; probe += 7) {
+    auto lb = static_cast<uint32_t>(
+        std::lower_bound(keys.begin(), keys.end(), probe) - keys.begin());
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    index.Window(probe, begin, end);
+    if (probe < keys.front()) {
+      ASSERT_EQ(end, 0u);
+      continue;
+    }
+    ASSERT_LE(begin, lb) << "probe=" << probe;
+    ASSERT_LE(lb, end) << "probe=" << probe;
+  }
+}
+
+TEST(LearnedKeyIndexTest, SerializeRoundTrip) {
+  using namespace DB;
+  std::vector<int> keys;
+  for (int i = 0; i < 5000; i++) {
+    keys.push_back(i * i / 10 + i);
+  }
+  LearnedKeyIndex index;
+  index.Build(keys.data(), static_cast<uint32_t>(keys.size()), 32);
+  std::string blob;
+  index.Serialize(blob);
+  EXPECT_EQ(blob.size(), index.SerializedSize());
+
+  LearnedKeyIndex loaded;
+  ASSERT_TRUE(loaded.Deserialize(blob.data(), blob.size()));
+  EXPECT_EQ(loaded.SegmentCount(), index.SegmentCount());
+  for (size_t i = 0; i < keys.size(); i += 11) {
+    uint32_t b1 = 0, e1 = 0, b2 = 0, e2 = 0;
+    index.Window(keys[i], b1, e1);
+    loaded.Window(keys[i], b2, e2);
+    EXPECT_EQ(b1, b2);
+    EXPECT_EQ(e1, e2);
+  }
+  EXPECT_FALSE(loaded.Deserialize(blob.data(), blob.size() - 2));
+
+  // 非递增输入不构建索引
+  std::vector<int> dup{1, 2, 2, 3};
+  LearnedKeyIndex invalid;
+  invalid.Build(dup.data(), static_cast<uint32_t>(dup.size()), 32);
+  EXPECT_TRUE(invalid.Empty());
+}
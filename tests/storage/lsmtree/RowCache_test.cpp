@@ -0,0 +1,59 @@
+#include "storage/lsmtree/RowCache.hpp"
+#include "storage/lsmtree/Slice.hpp"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <string>
+
+TEST(RowCacheTest, LookupInsertErase) {
+  using namespace DB;
+  RowCache cache(1 << 20);
+  std::atomic<uint64_t> seq{0};
+
+  Slice row;
+  EXPECT_FALSE(cache.Lookup(1, Slice{42}, &row));
+  cache.InsertIfUnchanged(1, Slice{42}, Slice{std::string("row-42")}, seq, 0);
+  ASSERT_TRUE(cache.Lookup(1, Slice{42}, &row));
+  EXPECT_EQ(row.ToString(), "row-42");
+
+  // 不同表的相同主键互不影响
+  EXPECT_FALSE(cache.Lookup(2, Slice{42}, &row));
+
+  cache.Erase(1, Slice{42});
+  EXPECT_FALSE(cache.Lookup(1, Slice{42}, &row));
+  EXPECT_EQ(cache.Hits(), 1u);
+  EXPECT_EQ(cache.Misses(), 3u);
+}
+
+TEST(RowCacheTest, SkipInsertAfterConcurrentWrite) {
+  using namespace DB;
+  RowCache cache(1 << 20);
+  std::atomic<uint64_t> seq{0};
+  uint64_t observed = seq.load();
+  // 读取 SSTable 期间发生写入，旧值不能进入缓存
+  seq.fetch_add(1);
+  cache.InsertIfUnchanged(7, Slice{1}, Slice{std::string("stale")}, seq,
+                          observed);
+  Slice row;
+  EXPECT_FALSE(cache.Lookup(7, Slice{1}, &row));
+}
+
+TEST(RowCacheTest, EvictsLeastRecentlyUsed) {
+  using namespace DB;
+  // 16 个分片，每个分片约 4KB
+  RowCache cache(64 * 1024);
+  std::atomic<uint64_t> seq{0};
+  std::string payload(200, 'x');
+  for (int i = 0; i < 2000; i++) {
+    cache.InsertIfUnchanged(3, Slice{i}, Slice{payload}, seq, 0);
+  }
+  EXPECT_LE(cache.Usage(), 64u * 1024);
+
+  // 最近写入的 key 应仍在缓存中，最早的已被淘汰
+  Slice row;
+  EXPECT_TRUE(cache.Lookup(3, Slice{1999}, &row));
+  EXPECT_FALSE(cache.Lookup(3, Slice{0}, &row));
+
+  cache.EraseTable(3);
+  EXPECT_EQ(cache.Usage(), 0u);
+}
@@ -0,0 +1,163 @@
+#include "storage/lsmtree/SpaceFillingCurve.hpp"
+#include "buffer/BufferPoolManager.hpp"
+#include "storage/lsmtree/RowCodec.hpp"
+#include "storage/lsmtree/SSTable.hpp"
+#include "storage/lsmtree/Slice.hpp"
+#include "storage/lsmtree/TableOperator.hpp"
+#include "storage/lsmtree/builder/SSTableBuilder.hpp"
+#include "storage/lsmtree/iterator/SSTableIterator.hpp"
+#include "type/Int.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+// dims 维、每维 bits 位的网格上，按曲线下标依次取出的坐标
+std::vector<std::vector<uint32_t>> WalkHilbert(size_t dims, uint32_t bits) {
+  size_t cells = size_t{1} << (dims * bits);
+  std::vector<std::vector<uint32_t>> points(cells);
+  std::vector<bool> seen(cells, false);
+  for (size_t cell = 0; cell < cells; cell++) {
+    std::vector<uint32_t> coords(dims);
+    for (size_t d = 0; d < dims; d++) {
+      coords[d] =
+          static_cast<uint32_t>(cell >> (d * bits)) & ((1u << bits) - 1);
+    }
+    auto original = coords;
+    uint64_t index = DB::HilbertIndex(coords.data(), dims, bits);
+    EXPECT_LT(index, cells);
+    if (index >= cells) {
+      continue;
+    }
+    EXPECT_FALSE(seen[index]) << index;
+    seen[index] = true;
+    points[index] = original;
+  }
+  return points;
+}
+
+int ReadInt(const std::string &bytes) {
+  int v = 0;
+  std::memcpy(&v, bytes.data(), sizeof(v));
+  return v;
+}
+} // namespace
+
+TEST(SpaceFillingCurveTest, ZOrderInterleavesBits) {
+  using namespace DB;
+  uint32_t a[2] = {0, 0};
+  EXPECT_EQ(ZOrderIndex(a, 2, 4), 0u);
+  // 第一维占高位
+  uint32_t b[2] = {1, 0};
+  EXPECT_EQ(ZOrderIndex(b, 2, 4), 2u);
+  uint32_t c[2] = {0, 1};
+  EXPECT_EQ(ZOrderIndex(c, 2, 4), 1u);
+  uint32_t d[2] = {15, 15};
+  EXPECT_EQ(ZOrderIndex(d, 2, 4), 255u);
+  uint32_t e[3] = {4, 2, 1};
+  EXPECT_EQ(ZOrderIndex(e, 3, 3), 0b100010001u);
+}
+
+TEST(SpaceFillingCurveTest, HilbertVisitsNeighbours) {
+  for (auto [dims, bits] : {std::pair<size_t, uint32_t>{2, 4}, {3, 3}}) {
+    auto points = WalkHilbert(dims, bits);
+    // 曲线上相邻的两个点只在一维上相差 1
+    for (size_t i = 0; i + 1 < points.size(); i++) {
+      uint32_t distance = 0;
+      for (size_t d = 0; d < dims; d++) {
+        distance += static_cast<uint32_t>(
+            std::abs(static_cast<int>(points[i][d]) -
+                     static_cast<int>(points[i + 1][d])));
+      }
+      EXPECT_EQ(distance, 1u) << "dims " << dims << " index " << i;
+    }
+  }
+}
+
+TEST(SpaceFillingCurveTest, ClusteredBuildKeepsKeyOrder) {
+  using namespace DB;
+  std::filesystem::path column{"cluster_test_file"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(column);
+      });
+  std::vector<std::shared_ptr<ValueType>> types{std::make_shared<Int>(),
+                                                std::make_shared<Int>(),
+                                                std::make_shared<Int>()};
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(128, dm);
+  constexpr int kRows = 4096;
+  // 两列取值与主键无关，均匀分布在 [0, 64)
+  auto x_of = [](int key) {
+    return static_cast<int>((static_cast<uint32_t>(key) * 2654435761u) >> 26);
+  };
+  auto y_of = [](int key) {
+    return static_cast<int>((static_cast<uint32_t>(key) * 2246822519u) >> 26);
+  };
+
+  auto build = [&](uint32_t table_id, bool cluster) {
+    RowGroupSizing sizing;
+    sizing.target_rows = 64;
+    SSTableBuilder builder(column, table_id, types, 0, DEFAULT_KEY_FILTER_TYPE,
+                           {}, {}, ColumnCodec::None, sizing);
+    if (cluster) {
+      builder.SetClustering({{1, 2}, ClusterCurve::Hilbert});
+    }
+    for (int i = 0; i < kRows; i++) {
+      std::string row;
+      RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(i));
+      RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(x_of(i)));
+      RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(y_of(i)));
+      EXPECT_TRUE(builder.Add(Slice{i}, Slice{row}));
+    }
+    EXPECT_TRUE(builder.Finish().ok());
+    auto sst = std::make_shared<SSTable>();
+    sst->sstable_id_ = table_id;
+    EXPECT_TRUE(TableOperator::ReadSSTable(column, sst, types, bpm).ok());
+    return sst;
+  };
+  // x, y 都落在 [16, 24) 时 zone map 无法跳过的 RowGroup 个数
+  auto matching = [](const SSTableRef &sst) {
+    size_t count = 0;
+    for (const auto &rg : sst->rowgroups_) {
+      bool match = true;
+      for (size_t col = 1; col <= 2; col++) {
+        const auto &zone = rg.columns[col].zone;
+        if (zone.has_value &&
+            (ReadInt(zone.max) < 16 || ReadInt(zone.min) >= 24)) {
+          match = false;
+        }
+      }
+      count += match;
+    }
+    return count;
+  };
+
+  auto plain = build(0, false);
+  auto clustered = build(1, true);
+  EXPECT_TRUE(plain->key_ordered_);
+  EXPECT_FALSE(clustered->key_ordered_);
+  EXPECT_LT(matching(clustered) * 4, matching(plain));
+
+  // 迭代器跨 RowGroup 按主键归并，行内容与写入一致
+  SSTableIterator iter(clustered, types);
+  int expected = 0;
+  for (; iter.Valid(); iter.Next(), expected++) {
+    int key = 0;
+    std::memcpy(&key, iter.GetKey().GetData(), sizeof(key));
+    ASSERT_EQ(key, expected);
+    Slice value;
+    ASSERT_TRUE(RowCodec::DecodeColumn(iter.GetValue(), 1, &value));
+    int x = 0;
+    std::memcpy(&x, value.GetData(), sizeof(x));
+    EXPECT_EQ(x, x_of(key));
+  }
+  EXPECT_EQ(expected, kRows);
+}
@@ -0,0 +1,88 @@
+#include "storage/lsmtree/SparseKeyIndex.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <limits>
+#include <string>
+#include <vector>
+
+TEST(SparseKeyIndexTest, FindBlockMatchesUpperBound) {
+  using namespace DB;
+  // 覆盖单节点、多层节点以及不满节点的情况
+  for (uint32_t count : {1u, 7u, 64u, 65u, 577u, 5000u, 40000u}) {
+    std::vector<int> keys(count);
+    for (uint32_t i = 0; i < count; i++) {
+      keys[i] = static_cast<int>(i) * 3 - 1000;
+    }
+    SparseKeyIndex index;
+    index.Build(keys.data(), count, 16);
+    std::vector<int> samples;
+    for (uint32_t i = 0; i < count; i += 16) {
+      samples.push_back(keys[i]);
+    }
+    ASSERT_EQ(index.SampleCount(), samples.size());
+
+    for (int probe = keys.front() - 5; probe <= keys.back() + 5; probe++) {
+      auto it = std::upper_bound(samples.begin(), samples.end(), probe);
+      int64_t expected = (it - samples.begin()) - 1;
+      ASSERT_EQ(index.FindBlock(probe), expected)
+          << "count=" << count << " probe=" << probe;
+    }
+    EXPECT_EQ(index.FindBlock(std::numeric_limits<int>::max()),
+              static_cast<int64_t>(samples.size()) - 1);
+    EXPECT_EQ(index.FindBlock(std::numeric_limits<int>::min()), -1);
+  }
+}
+
+TEST(SparseKeyIndexTest, LocateAndSearchBlock) {
+  using namespace DB;
+  std::vector<int> keys;
+  for (int i = 0; i < 10000; i++) {
+    keys.push_back(i * 2);
+  }
+  SparseKeyIndex index;
+  index.Build(keys.data(), static_cast<uint32_t>(keys.size()), 64);
+
+  for (int key = -3; key < 20003; key++) {
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    bool located = index.Locate(key, static_cast<uint32_t>(keys.size()), begin,
+                                end);
+    int64_t pos = -1;
+    if (located) {
+      ASSERT_LE(end - begin, 64u);
+      pos = SearchIntBlock(keys.data() + begin, end - begin, key);
+      if (pos >= 0) {
+        pos += begin;
+      }
+    }
+    if (key >= 0 && key < 20000 && key % 2 == 0) {
+      ASSERT_EQ(pos, key / 2) << "key=" << key;
+    } else {
+      ASSERT_EQ(pos, -1) << "key=" << key;
+    }
+  }
+}
+
+TEST(SparseKeyIndexTest, SerializeRoundTrip) {
+  using namespace DB;
+  std::vector<int> keys;
+  for (int i = 0; i < 3000; i++) {
+    keys.push_back(i * 7 + 11);
+  }
+  SparseKeyIndex index;
+  index.Build(keys.data(), static_cast<uint32_t>(keys.size()), 64);
+  std::string blob;
+  index.Serialize(blob);
+
+  SparseKeyIndex loaded;
+  ASSERT_TRUE(loaded.Deserialize(blob.data(), blob.size()));
+  EXPECT_EQ(loaded.Interval(), 64u);
+  EXPECT_EQ(loaded.SampleCount(), index.SampleCount());
+  for (int key = 0; key < 21100; key += 13) {
+    EXPECT_EQ(loaded.FindBlock(key), index.FindBlock(key));
+  }
+
+  // 截断的数据应当拒绝
+  EXPECT_FALSE(loaded.Deserialize(blob.data(), blob.size() - 1));
+}
@@ -1,11 +1,22 @@
 #include "buffer/BufferPoolManager.hpp"
+#include "storage/column/ColumnString.hpp"
+#include "storage/column/ColumnVector.hpp"
+#include "storage/lsmtree/BloomFilter.hpp"
+#include "storage/lsmtree/ColumnReader.hpp"
+#include "storage/lsmtree/KeyFilter.hpp"
 #include "storage/lsmtree/RowCodec.hpp"
 #include "storage/lsmtree/SSTable.hpp"
+#include "storage/lsmtree/ScanPredicate.hpp"
 #include "storage/lsmtree/Slice.hpp"
 #include "storage/lsmtree/TableOperator.hpp"
 #include "storage/lsmtree/builder/SSTableBuilder.hpp"
+#include "storage/lsmtree/iterator/SSTableIterator.hpp"
+#include "type/Double.hpp"
 #include "type/Int.hpp"
+#include "type/String.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <functional>
 #include <gtest/gtest.h>
@@ -40,3 +51,835 @@ TEST(SSTableBuilderTest, BuildTableAndReadData) {
   EXPECT_TRUE(TableOperator::ReadSSTable(column, temp, types, bpm).ok());
   EXPECT_EQ(sstable_meta->rowgroup_count_, temp->rowgroup_count_);
 }
+
+TEST(SSTableBuilderTest, KeyFilterTypeRecordedInFooter) {
+  using namespace DB;
+  std::filesystem::path column{"sstable_test_file"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(column);
+      });
+  std::vector<std::shared_ptr<ValueType>> types{std::make_shared<Int>()};
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(128, dm);
+
+  uint32_t table_id = 0;
+  for (auto type : {KeyFilterType::Bloom, KeyFilterType::BinaryFuse8}) {
+    SSTableBuilder builder(column, table_id, types, 0, type);
+    for (int i = 0; i < 400; i++) {
+      std::string row;
+      RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(i));
+      EXPECT_TRUE(builder.Add(Slice{i}, Slice{row}));
+    }
+    EXPECT_TRUE(builder.Finish().ok());
+
+    auto temp = std::make_shared<SSTable>();
+    temp->sstable_id_ = table_id;
+    EXPECT_TRUE(TableOperator::ReadSSTable(column, temp, types, bpm).ok());
+    EXPECT_EQ(temp->filter_type_, type);
+    for (const auto &rg : temp->rowgroups_) {
+      ASSERT_FALSE(rg.bloom.empty());
+    }
+    for (int i = 0; i < 400; i++) {
+      Slice key{i};
+      uint64_t h = BloomFilter::HashKey(key.GetData(), key.Size());
+      bool found = false;
+      for (const auto &rg : temp->rowgroups_) {
+        found = found || KeyFilterMayContain(type, rg.bloom, h);
+      }
+      EXPECT_TRUE(found) << "key=" << i;
+    }
+    table_id++;
+  }
+}
+
+TEST(SSTableBuilderTest, ColumnFilterPrunesRowGroups) {
+  using namespace DB;
+  std::filesystem::path column{"sstable_test_file"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(column);
+      });
+  std::vector<std::shared_ptr<ValueType>> types{std::make_shared<Int>(),
+                                                std::make_shared<String>()};
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(128, dm);
+
+  // 值打散后每个 RowGroup 的 zonemap 都覆盖几乎整个取值范围
+  constexpr int kRows = 12000;
+  auto email = [](int v) { return "user" + std::to_string(v) + "@mail"; };
+  SSTableBuilder builder(column, 0, types, 0, DEFAULT_KEY_FILTER_TYPE, {0, 1});
+  for (int i = 0; i < kRows; i++) {
+    std::string row;
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(i));
+    RowCodec::AppendValue(row, ValueType::Type::String,
+                          email(i * 7919 % kRows));
+    EXPECT_TRUE(builder.Add(Slice{i}, Slice{row}));
+  }
+  EXPECT_TRUE(builder.Finish().ok());
+
+  auto temp = std::make_shared<SSTable>();
+  temp->sstable_id_ = 0;
+  EXPECT_TRUE(TableOperator::ReadSSTable(column, temp, types, bpm).ok());
+  ASSERT_GT(temp->rowgroups_.size(), 2u);
+  for (const auto &rg : temp->rowgroups_) {
+    // 主键已有 key 过滤器，不重复构建
+    EXPECT_TRUE(rg.columns[0].filter.empty());
+    ASSERT_FALSE(rg.columns[1].filter.empty());
+  }
+
+  auto may_match = [&](const std::string &value) {
+    ScanPredicate pred{1, ValueType::Type::String,
+                       FunctionComparison::Operator::Equals};
+    pred.const_string = value;
+    std::vector<size_t> groups;
+    for (size_t g = 0; g < temp->rowgroups_.size(); g++) {
+      if (RowGroupMayMatch(temp->filter_type_, temp->rowgroups_[g], {pred})) {
+        groups.push_back(g);
+      }
+    }
+    return groups;
+  };
+  uint32_t first_row = 0;
+  for (size_t g = 0; g < temp->rowgroups_.size(); g++) {
+    uint32_t rows = temp->rowgroups_[g].row_count;
+    for (uint32_t i = first_row; i < first_row + rows; i += 97) {
+      auto groups = may_match(email(static_cast<int>(i) * 7919 % kRows));
+      EXPECT_NE(std::find(groups.begin(), groups.end(), g), groups.end());
+    }
+    first_row += rows;
+  }
+
+  size_t false_positives = 0;
+  for (int v = kRows; v < kRows + 1000; v++) {
+    false_positives += may_match(email(v)).size();
+  }
+  EXPECT_LT(false_positives, 1000 * temp->rowgroups_.size() / 50);
+}
+
+TEST(SSTableBuilderTest, DictionaryEncodedStringColumn) {
+  using namespace DB;
+  std::filesystem::path column{"sstable_test_file"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(column);
+      });
+  std::vector<std::shared_ptr<ValueType>> types{std::make_shared<Int>(),
+                                                std::make_shared<String>(),
+                                                std::make_shared<String>()};
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(128, dm);
+
+  // 第 1 列低基数（含 NULL）走字典，第 2 列全不同保持 plain
+  constexpr int kRows = 2000;
+  const std::vector<std::string> kStatus{"active", "banned", "deleted",
+                                         "pending"};
+  auto status = [&](int i) {
+    return i % 11 == 0 ? std::string{} : kStatus[i * 7 % kStatus.size()];
+  };
+  SSTableBuilder builder(column, 0, types, 0);
+  for (int i = 0; i < kRows; i++) {
+    std::string row;
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(i));
+    RowCodec::AppendValue(row, ValueType::Type::String, status(i));
+    RowCodec::AppendValue(row, ValueType::Type::String,
+                          "user" + std::to_string(i));
+    EXPECT_TRUE(builder.Add(Slice{i}, Slice{row}));
+  }
+  EXPECT_TRUE(builder.Finish().ok());
+
+  auto temp = std::make_shared<SSTable>();
+  temp->sstable_id_ = 0;
+  EXPECT_TRUE(TableOperator::ReadSSTable(column, temp, types, bpm).ok());
+  ASSERT_EQ(temp->rowgroups_.size(), 1u);
+  const auto &rg = temp->rowgroups_[0];
+  ASSERT_EQ(rg.columns[1].encoding, ColumnEncoding::Dictionary);
+  EXPECT_EQ(rg.columns[2].encoding, ColumnEncoding::Plain);
+  // 字典 + u8 编码远小于 offsets + data
+  EXPECT_LT(rg.columns[1].size, kRows * 2u);
+
+  RowGroupData data(
+      rg, temp->data_file_->Data() + static_cast<size_t>(rg.offset));
+  ColumnPtr values = std::make_shared<ColumnString>();
+  ColumnReader::ReadColumnFromRowGroup(data, 1, types[1], values);
+  ASSERT_EQ(values->Size(), static_cast<size_t>(kRows));
+  for (int i = 0; i < kRows; i++) {
+    auto expected = status(i).empty() ? std::string("Null") : status(i);
+    ASSERT_EQ(values->GetStrElement(i), expected) << "row " << i;
+    const Byte *ptr = nullptr;
+    uint32_t len = 0;
+    uint64_t scratch = 0;
+    ASSERT_TRUE(ColumnReader::GetValuePointer(
+        data, i, 1, ValueType::Type::String, ptr, len, scratch));
+    EXPECT_EQ(std::string(ptr ? ptr : "", len), status(i));
+  }
+
+  RowGroupSelection sel;
+  sel.rows = {0, 5, 42, 1999};
+  ColumnPtr selected = std::make_shared<ColumnString>();
+  ColumnReader::ReadColumnWithSelection(data, 1, types[1], sel, selected);
+  ASSERT_EQ(selected->Size(), sel.rows.size());
+  for (size_t k = 0; k < sel.rows.size(); k++) {
+    auto s = status(static_cast<int>(sel.rows[k]));
+    EXPECT_EQ(selected->GetStrElement(k), s.empty() ? "Null" : s);
+  }
+
+  // 编码区间求值与逐行比较一致（含字典中不存在的常量）
+  using Op = FunctionComparison::Operator;
+  for (auto op : {Op::Equals, Op::NotEquals, Op::Less, Op::LessOrEquals,
+                  Op::Greater, Op::GreaterOrEquals}) {
+    for (const std::string c : {"active", "banned", "c", "pending", "zzz"}) {
+      ScanPredicate pred{1, ValueType::Type::String, op};
+      pred.const_string = c;
+      std::vector<uint32_t> rows;
+      ColumnReader::EvalPredicateOnRowGroup(data, pred, rows);
+      std::vector<uint32_t> expected;
+      for (int i = 0; i < kRows; i++) {
+        auto s = status(i);
+        bool match = false;
+        switch (op) {
+        case Op::Equals: match = s == c; break;
+        case Op::NotEquals: match = s != c; break;
+        case Op::Less: match = s < c; break;
+        case Op::LessOrEquals: match = s <= c; break;
+        case Op::Greater: match = s > c; break;
+        case Op::GreaterOrEquals: match = s >= c; break;
+        }
+        if (!s.empty() && match) {
+          expected.push_back(static_cast<uint32_t>(i));
+        }
+      }
+      EXPECT_EQ(rows, expected) << "const " << c;
+    }
+  }
+
+  // 迭代器重建的行与写入一致
+  SSTableIterator iter(temp, types);
+  for (int i = 0; i < kRows; i++, iter.Next()) {
+    ASSERT_TRUE(iter.Valid());
+    std::string expected;
+    RowCodec::AppendValue(expected, ValueType::Type::Int, std::to_string(i));
+    RowCodec::AppendValue(expected, ValueType::Type::String, status(i));
+    RowCodec::AppendValue(expected, ValueType::Type::String,
+                          "user" + std::to_string(i));
+    ASSERT_EQ(iter.GetValue().ToString(), expected) << "row " << i;
+  }
+  EXPECT_FALSE(iter.Valid());
+}
+
+TEST(SSTableBuilderTest, BitPackedIntColumn) {
+  using namespace DB;
+  std::filesystem::path column{"sstable_test_file"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(column);
+      });
+  std::vector<std::shared_ptr<ValueType>> types{std::make_shared<Int>(),
+                                                std::make_shared<Int>()};
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(128, dm);
+
+  // 主键自增，第 1 列小范围取值且含 NULL，两列都应被 bit-pack
+  constexpr int kRows = 5000;
+  auto score = [](int i) { return (i * 37) % 200 - 50; };
+  SSTableBuilder builder(column, 0, types, 0);
+  for (int i = 0; i < kRows; i++) {
+    std::string row;
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(i));
+    RowCodec::AppendValue(row, ValueType::Type::Int,
+                          i % 13 == 0 ? "Null" : std::to_string(score(i)));
+    EXPECT_TRUE(builder.Add(Slice{i}, Slice{row}));
+  }
+  EXPECT_TRUE(builder.Finish().ok());
+
+  auto temp = std::make_shared<SSTable>();
+  temp->sstable_id_ = 0;
+  EXPECT_TRUE(TableOperator::ReadSSTable(column, temp, types, bpm).ok());
+  ASSERT_FALSE(temp->rowgroups_.empty());
+
+  using Op = FunctionComparison::Operator;
+  uint32_t first_row = 0;
+  for (const auto &rg : temp->rowgroups_) {
+    ASSERT_EQ(rg.columns[0].encoding, ColumnEncoding::BitPacked);
+    ASSERT_EQ(rg.columns[1].encoding, ColumnEncoding::BitPacked);
+    EXPECT_LT(rg.columns[0].size, rg.row_count * sizeof(int) / 4);
+
+    RowGroupData data(
+        rg, temp->data_file_->Data() + static_cast<size_t>(rg.offset));
+    ColumnPtr keys = std::make_shared<ColumnVector<int>>();
+    ColumnReader::ReadColumnFromRowGroup(data, 0, types[0], keys);
+    ColumnPtr scores = std::make_shared<ColumnVector<int>>();
+    ColumnReader::AddSpan(data, 1, ValueType::Type::Int, nullptr, scores);
+    ASSERT_EQ(keys->Size(), rg.row_count);
+    ASSERT_EQ(scores->Size(), rg.row_count);
+    for (uint32_t i = 0; i < rg.row_count; i++) {
+      int row = static_cast<int>(first_row + i);
+      ASSERT_EQ(keys->GetStrElement(i), std::to_string(row));
+      auto expected = row % 13 == 0 ? "Null" : std::to_string(score(row));
+      ASSERT_EQ(scores->GetStrElement(i), expected) << "row " << row;
+    }
+
+    // 按块判定 + 块内解码的结果与逐行比较一致
+    for (auto op : {Op::Equals, Op::NotEquals, Op::Less, Op::LessOrEquals,
+                    Op::Greater, Op::GreaterOrEquals}) {
+      for (int c : {-100, -50, 0, 73, 149, 500}) {
+        ScanPredicate pred{1, ValueType::Type::Int, op};
+        pred.const_int = c;
+        std::vector<uint32_t> rows;
+        ColumnReader::EvalPredicateOnRowGroup(data, pred, rows);
+        std::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < rg.row_count; i++) {
+          int row = static_cast<int>(first_row + i);
+          int v = score(row);
+          bool match = false;
+          switch (op) {
+          case Op::Equals: match = v == c; break;
+          case Op::NotEquals: match = v != c; break;
+          case Op::Less: match = v < c; break;
+          case Op::LessOrEquals: match = v <= c; break;
+          case Op::Greater: match = v > c; break;
+          case Op::GreaterOrEquals: match = v >= c; break;
+          }
+          if (row % 13 != 0 && match) {
+            expected.push_back(i);
+          }
+        }
+        ASSERT_EQ(rows, expected) << "const " << c;
+      }
+    }
+    first_row += rg.row_count;
+  }
+  EXPECT_EQ(first_row, static_cast<uint32_t>(kRows));
+
+  // 迭代器逐行随机访问解码
+  SSTableIterator iter(temp, types);
+  for (int i = 0; i < kRows; i++, iter.Next()) {
+    ASSERT_TRUE(iter.Valid());
+    std::string expected;
+    RowCodec::AppendValue(expected, ValueType::Type::Int, std::to_string(i));
+    RowCodec::AppendValue(expected, ValueType::Type::Int,
+                          i % 13 == 0 ? "Null" : std::to_string(score(i)));
+    ASSERT_EQ(iter.GetValue().ToString(), expected) << "row " << i;
+  }
+}
+
+TEST(SSTableBuilderTest, RunLengthEncodedColumns) {
+  using namespace DB;
+  std::filesystem::path column{"sstable_test_file"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(column);
+      });
+  std::vector<std::shared_ptr<ValueType>> types{
+      std::make_shared<Int>(), std::make_shared<Int>(),
+      std::make_shared<Double>(), std::make_shared<String>()};
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(128, dm);
+
+  // 按 tenant / 日期分桶聚簇的列，每个 RowGroup 只有少数几个 run
+  constexpr int kRows = 3000;
+  const std::vector<std::string> kRegions{"apac", "emea", "latam", "na"};
+  auto tenant = [](int i) { return i / 250; };
+  auto bucket = [](int i) { return (i / 500) * 0.5; };
+  auto region = [&](int i) { return kRegions[i / 400 % kRegions.size()]; };
+  auto tenant_null = [](int i) { return i % 97 == 0; };
+  SSTableBuilder builder(column, 0, types, 0);
+  for (int i = 0; i < kRows; i++) {
+    std::string row;
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(i));
+    RowCodec::AppendValue(row, ValueType::Type::Int,
+                          tenant_null(i) ? "Null"
+                                         : std::to_string(tenant(i)));
+    RowCodec::AppendValue(row, ValueType::Type::Double,
+                          std::to_string(bucket(i)));
+    RowCodec::AppendValue(row, ValueType::Type::String, region(i));
+    EXPECT_TRUE(builder.Add(Slice{i}, Slice{row}));
+  }
+  EXPECT_TRUE(builder.Finish().ok());
+
+  auto temp = std::make_shared<SSTable>();
+  temp->sstable_id_ = 0;
+  EXPECT_TRUE(TableOperator::ReadSSTable(column, temp, types, bpm).ok());
+  ASSERT_FALSE(temp->rowgroups_.empty());
+
+  using Op = FunctionComparison::Operator;
+  auto compare = [](Op op, auto lhs, auto rhs) {
+    switch (op) {
+    case Op::Equals: return lhs == rhs;
+    case Op::NotEquals: return lhs != rhs;
+    case Op::Less: return lhs < rhs;
+    case Op::LessOrEquals: return lhs <= rhs;
+    case Op::Greater: return lhs > rhs;
+    case Op::GreaterOrEquals: return lhs >= rhs;
+    }
+    return false;
+  };
+  uint32_t first_row = 0;
+  for (const auto &rg : temp->rowgroups_) {
+    ASSERT_EQ(rg.columns[1].encoding, ColumnEncoding::RunLength);
+    ASSERT_EQ(rg.columns[2].encoding, ColumnEncoding::RunLength);
+    ASSERT_EQ(rg.columns[3].encoding, ColumnEncoding::DictionaryRunLength);
+    EXPECT_LT(rg.columns[2].size, rg.row_count * sizeof(double) / 16);
+
+    RowGroupData data(
+        rg, temp->data_file_->Data() + static_cast<size_t>(rg.offset));
+    auto row_of = [&](uint32_t i) { return static_cast<int>(first_row + i); };
+
+    // run span 按 run 求和，物化后逐行展开
+    ColumnPtr tenants = std::make_shared<ColumnVector<int>>();
+    ColumnReader::AddSpan(data, 1, ValueType::Type::Int, nullptr, tenants);
+    ColumnPtr buckets = std::make_shared<ColumnVector<double>>();
+    ColumnReader::AddSpan(data, 2, ValueType::Type::Double, nullptr, buckets);
+    auto &tenant_vec = static_cast<ColumnVector<int> &>(*tenants);
+    auto &bucket_vec = static_cast<ColumnVector<double> &>(*buckets);
+    ASSERT_EQ(tenant_vec.Spans().size(), 1u);
+    ASSERT_NE(tenant_vec.Spans()[0].run_ends, nullptr);
+    double tenant_sum = 0.0;
+    double bucket_sum = 0.0;
+    for (uint32_t i = 0; i < rg.row_count; i++) {
+      tenant_sum += tenant_null(row_of(i)) ? 0 : tenant(row_of(i));
+      bucket_sum += bucket(row_of(i));
+    }
+    EXPECT_EQ(tenant_vec.Spans()[0].RunSum(), tenant_sum);
+    EXPECT_EQ(bucket_vec.Spans()[0].RunSum(), bucket_sum);
+    ASSERT_EQ(tenants->Size(), rg.row_count);
+    ASSERT_EQ(buckets->Size(), rg.row_count);
+    for (uint32_t i = 0; i < rg.row_count; i++) {
+      int row = row_of(i);
+      auto expected =
+          tenant_null(row) ? "Null" : std::to_string(tenant(row));
+      ASSERT_EQ(tenants->GetStrElement(i), expected) << "row " << row;
+      ASSERT_EQ(bucket_vec.Data()[i], bucket(row)) << "row " << row;
+    }
+
+    ColumnPtr regions = std::make_shared<ColumnString>();
+    ColumnReader::ReadColumnFromRowGroup(data, 3, types[3], regions);
+    ASSERT_EQ(regions->Size(), rg.row_count);
+    RowGroupSelection sel;
+    sel.rows = {0, 1, rg.row_count / 2, rg.row_count - 1};
+    ColumnPtr selected = std::make_shared<ColumnVector<double>>();
+    ColumnReader::ReadColumnWithSelection(data, 2, types[2], sel, selected);
+    for (uint32_t i = 0; i < rg.row_count; i++) {
+      ASSERT_EQ(regions->GetStrElement(i), region(row_of(i)));
+    }
+    for (size_t k = 0; k < sel.rows.size(); k++) {
+      EXPECT_EQ(static_cast<ColumnVector<double> &>(*selected)[k],
+                bucket(row_of(sel.rows[k])));
+    }
+
+    // 逐 run 求值的结果与逐行比较一致
+    auto check = [&](const ScanPredicate &pred, auto expected_match) {
+      std::vector<uint32_t> rows;
+      ColumnReader::EvalPredicateOnRowGroup(data, pred, rows);
+      std::vector<uint32_t> expected;
+      for (uint32_t i = 0; i < rg.row_count; i++) {
+        if (expected_match(row_of(i))) {
+          expected.push_back(i);
+        }
+      }
+      ASSERT_EQ(rows, expected);
+    };
+    for (auto op : {Op::Equals, Op::NotEquals, Op::Less, Op::LessOrEquals,
+                    Op::Greater, Op::GreaterOrEquals}) {
+      for (int c : {-1, 0, 3, 7, 12}) {
+        ScanPredicate pred{1, ValueType::Type::Int, op};
+        pred.const_int = c;
+        check(pred, [&](int row) {
+          return !tenant_null(row) && compare(op, tenant(row), c);
+        });
+      }
+      for (double c : {0.0, 1.0, 1.25, 2.5}) {
+        ScanPredicate pred{2, ValueType::Type::Double, op};
+        pred.const_double = c;
+        check(pred, [&](int row) { return compare(op, bucket(row), c); });
+      }
+      for (const std::string c : {"apac", "b", "latam", "zz"}) {
+        ScanPredicate pred{3, ValueType::Type::String, op};
+        pred.const_string = c;
+        check(pred, [&](int row) { return compare(op, region(row), c); });
+      }
+    }
+    first_row += rg.row_count;
+  }
+  EXPECT_EQ(first_row, static_cast<uint32_t>(kRows));
+
+  // 迭代器按行二分定位 run
+  SSTableIterator iter(temp, types);
+  for (int i = 0; i < kRows; i++, iter.Next()) {
+    ASSERT_TRUE(iter.Valid());
+    std::string expected;
+    RowCodec::AppendValue(expected, ValueType::Type::Int, std::to_string(i));
+    RowCodec::AppendValue(expected, ValueType::Type::Int,
+                          tenant_null(i) ? "Null"
+                                         : std::to_string(tenant(i)));
+    RowCodec::AppendValue(expected, ValueType::Type::Double,
+                          std::to_string(bucket(i)));
+    RowCodec::AppendValue(expected, ValueType::Type::String, region(i));
+    ASSERT_EQ(iter.GetValue().ToString(), expected) << "row " << i;
+  }
+}
+
+TEST(SSTableBuilderTest, GorillaDoubleColumn) {
+  using namespace DB;
+  std::filesystem::path column{"sstable_test_file"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(column);
+      });
+  std::vector<std::shared_ptr<ValueType>> types{std::make_shared<Int>(),
+                                                std::make_shared<Double>(),
+                                                std::make_shared<Double>()};
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(128, dm);
+
+  // 两列取值相同，只有第 1 列声明 GORILLA
+  constexpr int kRows = 3000;
+  auto gauge = [](int i) { return 20.0 + (i / 7 % 9) * 0.125; };
+  auto is_null = [](int i) { return i % 101 == 0; };
+  SSTableBuilder builder(column, 0, types, 0, DEFAULT_KEY_FILTER_TYPE, {},
+                         {1});
+  for (int i = 0; i < kRows; i++) {
+    std::string row;
+    auto value = is_null(i) ? std::string("Null") : std::to_string(gauge(i));
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(i));
+    RowCodec::AppendValue(row, ValueType::Type::Double, value);
+    RowCodec::AppendValue(row, ValueType::Type::Double, value);
+    EXPECT_TRUE(builder.Add(Slice{i}, Slice{row}));
+  }
+  EXPECT_TRUE(builder.Finish().ok());
+
+  auto temp = std::make_shared<SSTable>();
+  temp->sstable_id_ = 0;
+  EXPECT_TRUE(TableOperator::ReadSSTable(column, temp, types, bpm).ok());
+  uint32_t first_row = 0;
+  for (const auto &rg : temp->rowgroups_) {
+    ASSERT_EQ(rg.columns[1].encoding, ColumnEncoding::Gorilla);
+    EXPECT_NE(rg.columns[2].encoding, ColumnEncoding::Gorilla);
+    EXPECT_LT(rg.columns[1].size, rg.columns[2].size);
+
+    RowGroupData data(
+        rg, temp->data_file_->Data() + static_cast<size_t>(rg.offset));
+    ColumnPtr values = std::make_shared<ColumnVector<double>>();
+    ColumnReader::AddSpan(data, 1, ValueType::Type::Double, nullptr, values);
+    ASSERT_EQ(values->Size(), rg.row_count);
+    for (uint32_t i = 0; i < rg.row_count; i++) {
+      int row = static_cast<int>(first_row + i);
+      auto expected = is_null(row) ? "Null" : std::to_string(gauge(row));
+      ASSERT_EQ(values->GetStrElement(i), expected) << "row " << row;
+    }
+
+    RowGroupSelection sel;
+    sel.rows = {3, 300, 301, rg.row_count - 1};
+    ColumnPtr selected = std::make_shared<ColumnVector<double>>();
+    ColumnReader::ReadColumnWithSelection(data, 1, types[1], sel, selected);
+    for (size_t k = 0; k < sel.rows.size(); k++) {
+      int row = static_cast<int>(first_row + sel.rows[k]);
+      auto expected = is_null(row) ? "Null" : std::to_string(gauge(row));
+      EXPECT_EQ(selected->GetStrElement(k), expected) << "row " << row;
+    }
+
+    // 谓词结果与未声明 GORILLA 的同值列一致
+    using Op = FunctionComparison::Operator;
+    for (auto op : {Op::Equals, Op::Less, Op::GreaterOrEquals}) {
+      ScanPredicate pred{1, ValueType::Type::Double, op};
+      pred.const_double = 20.5;
+      std::vector<uint32_t> rows;
+      ColumnReader::EvalPredicateOnRowGroup(data, pred, rows);
+      pred.column_idx = 2;
+      std::vector<uint32_t> expected;
+      ColumnReader::EvalPredicateOnRowGroup(data, pred, expected);
+      EXPECT_FALSE(expected.empty());
+      EXPECT_EQ(rows, expected);
+    }
+    first_row += rg.row_count;
+  }
+  EXPECT_EQ(first_row, static_cast<uint32_t>(kRows));
+
+  SSTableIterator iter(temp, types);
+  for (int i = 0; i < kRows; i++, iter.Next()) {
+    ASSERT_TRUE(iter.Valid());
+    std::string expected;
+    auto value = is_null(i) ? std::string("Null") : std::to_string(gauge(i));
+    RowCodec::AppendValue(expected, ValueType::Type::Int, std::to_string(i));
+    RowCodec::AppendValue(expected, ValueType::Type::Double, value);
+    RowCodec::AppendValue(expected, ValueType::Type::Double, value);
+    ASSERT_EQ(iter.GetValue().ToString(), expected) << "row " << i;
+  }
+}
+
+TEST(SSTableBuilderTest, CompressedColumnChunks) {
+  using namespace DB;
+  std::filesystem::path column{"sstable_test_file"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(column);
+      });
+  std::vector<std::shared_ptr<ValueType>> types{
+      std::make_shared<Int>(), std::make_shared<Int>(),
+      std::make_shared<String>(), std::make_shared<Double>()};
+  constexpr int kRows = 3000;
+  auto device = [](int i) {
+    return "device-" + std::to_string(1000000 + i * 7) + "-eu-west-1";
+  };
+  auto reading = [](int i) {
+    return i % 13 == 0 ? std::string("Null") : std::to_string(i * 0.5);
+  };
+  auto row_of = [&](int i) {
+    std::string row;
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(i));
+    RowCodec::AppendValue(row, ValueType::Type::Int,
+                          std::to_string(i * 37 % 1000));
+    RowCodec::AppendValue(row, ValueType::Type::String, device(i));
+    RowCodec::AppendValue(row, ValueType::Type::Double, reading(i));
+    return row;
+  };
+
+  for (auto codec : {ColumnCodec::LZ4, ColumnCodec::Zstd}) {
+    // 两种压缩写同一路径，各用独立的 buffer pool 避免读到旧页
+    std::filesystem::remove_all(column);
+    auto dm = std::make_shared<DiskManager>();
+    auto bpm = std::make_shared<BufferPoolManager>(128, dm);
+    SSTableBuilder builder(column, 0, types, 0, DEFAULT_KEY_FILTER_TYPE, {},
+                           {}, codec);
+    for (int i = 0; i < kRows; i++) {
+      EXPECT_TRUE(builder.Add(Slice{i}, Slice{row_of(i)}));
+    }
+    EXPECT_TRUE(builder.Finish().ok());
+
+    auto temp = std::make_shared<SSTable>();
+    temp->sstable_id_ = 0;
+    EXPECT_TRUE(TableOperator::ReadSSTable(column, temp, types, bpm).ok());
+    uint32_t first_row = 0;
+    for (const auto &rg : temp->rowgroups_) {
+      // 主键列不压缩，重复前缀的字符串列压缩后明显变小
+      EXPECT_EQ(rg.columns[0].codec, ColumnCodec::None);
+      ASSERT_EQ(rg.columns[2].codec, codec);
+      EXPECT_LT(rg.columns[2].size * 2, rg.columns[2].uncompressed_size);
+
+      RowGroupData data(
+          rg, temp->data_file_->Data() + static_cast<size_t>(rg.offset));
+      auto row = [&](uint32_t i) { return static_cast<int>(first_row + i); };
+      ColumnPtr scores = std::make_shared<ColumnVector<int>>();
+      ColumnReader::AddSpan(data, 1, ValueType::Type::Int, nullptr, scores);
+      ColumnPtr devices = std::make_shared<ColumnString>();
+      ColumnReader::ReadColumnFromRowGroup(data, 2, types[2], devices);
+      ColumnPtr readings = std::make_shared<ColumnVector<double>>();
+      ColumnReader::AddSpan(data, 3, ValueType::Type::Double, nullptr,
+                            readings);
+      ASSERT_EQ(devices->Size(), rg.row_count);
+      for (uint32_t i = 0; i < rg.row_count; i++) {
+        ASSERT_EQ(scores->GetStrElement(i), std::to_string(row(i) * 37 % 1000));
+        ASSERT_EQ(devices->GetStrElement(i), device(row(i)));
+        ASSERT_EQ(readings->GetStrElement(i), reading(row(i)));
+        const Byte *ptr = nullptr;
+        uint32_t len = 0;
+        uint64_t scratch = 0;
+        ASSERT_TRUE(ColumnReader::GetValuePointer(
+            data, i, 2, ValueType::Type::String, ptr, len, scratch));
+        EXPECT_EQ(std::string(ptr, len), device(row(i)));
+      }
+
+      RowGroupSelection sel;
+      sel.rows = {0, 13, rg.row_count / 2, rg.row_count - 1};
+      ColumnPtr selected = std::make_shared<ColumnString>();
+      ColumnReader::ReadColumnWithSelection(data, 2, types[2], sel, selected);
+      for (size_t k = 0; k < sel.rows.size(); k++) {
+        EXPECT_EQ(selected->GetStrElement(k), device(row(sel.rows[k])));
+      }
+
+      ScanPredicate pred{3, ValueType::Type::Double,
+                         FunctionComparison::Operator::GreaterOrEquals};
+      pred.const_double = 500.0;
+      std::vector<uint32_t> rows;
+      ColumnReader::EvalPredicateOnRowGroup(data, pred, rows);
+      std::vector<uint32_t> expected;
+      for (uint32_t i = 0; i < rg.row_count; i++) {
+        if (row(i) % 13 != 0 && row(i) * 0.5 >= 500.0) {
+          expected.push_back(i);
+        }
+      }
+      EXPECT_EQ(rows, expected);
+      first_row += rg.row_count;
+    }
+    EXPECT_EQ(first_row, static_cast<uint32_t>(kRows));
+
+    SSTableIterator iter(temp, types);
+    for (int i = 0; i < kRows; i++, iter.Next()) {
+      ASSERT_TRUE(iter.Valid());
+      ASSERT_EQ(iter.GetValue().ToString(), row_of(i)) << "row " << i;
+    }
+  }
+  // 解压缓冲区释放后归还到池中
+  EXPECT_GT(ChunkBufferPool::Default().FreeBytes(), 0u);
+}
+
+TEST(SSTableBuilderTest, PageIndexPrunesPages) {
+  using namespace DB;
+  std::filesystem::path column{"sstable_test_file"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(column);
+      });
+  std::vector<std::shared_ptr<ValueType>> types{
+      std::make_shared<Int>(), std::make_shared<Int>(),
+      std::make_shared<Double>(), std::make_shared<String>()};
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(128, dm);
+
+  // 时间戳单调递增，第 2 页的 status 全为 NULL
+  constexpr int kRows = 2500;
+  auto ts = [](int i) { return 1000000 + i * 10; };
+  auto reading = [](int i) { return 20.0 + (i / 5 % 17) * 0.25; };
+  auto status = [](int i) {
+    if (i >= static_cast<int>(PAGE_INDEX_ROWS) &&
+        i < 2 * static_cast<int>(PAGE_INDEX_ROWS)) {
+      return std::string{};
+    }
+    return std::string(i % 3 == 0 ? "active" : "idle");
+  };
+  SSTableBuilder builder(column, 0, types, 0, DEFAULT_KEY_FILTER_TYPE, {},
+                         {2});
+  for (int i = 0; i < kRows; i++) {
+    std::string row;
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(i));
+    RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(ts(i)));
+    RowCodec::AppendValue(row, ValueType::Type::Double,
+                          std::to_string(reading(i)));
+    RowCodec::AppendValue(row, ValueType::Type::String, status(i));
+    EXPECT_TRUE(builder.Add(Slice{i}, Slice{row}));
+  }
+  EXPECT_TRUE(builder.Finish().ok());
+
+  auto temp = std::make_shared<SSTable>();
+  temp->sstable_id_ = 0;
+  EXPECT_TRUE(TableOperator::ReadSSTable(column, temp, types, bpm).ok());
+  const auto &rg = temp->rowgroups_[0];
+  ASSERT_GT(rg.row_count, 2 * PAGE_INDEX_ROWS);
+  ASSERT_EQ(rg.page_rows, PAGE_INDEX_ROWS);
+  for (const auto &col : rg.columns) {
+    ASSERT_EQ(col.pages.size(), rg.PageCount());
+  }
+  for (uint32_t p = 0; p < rg.PageCount(); p++) {
+    int first = static_cast<int>(p * PAGE_INDEX_ROWS);
+    int last = static_cast<int>(
+        std::min((p + 1) * PAGE_INDEX_ROWS, rg.row_count) - 1);
+    const auto &zone = rg.columns[1].pages[p].zone;
+    ASSERT_TRUE(zone.has_value);
+    int min = 0, max = 0;
+    std::memcpy(&min, zone.min.data(), sizeof(min));
+    std::memcpy(&max, zone.max.data(), sizeof(max));
+    EXPECT_EQ(min, ts(first));
+    EXPECT_EQ(max, ts(last));
+  }
+  EXPECT_EQ(rg.columns[3].pages[1].null_count, PAGE_INDEX_ROWS);
+  EXPECT_FALSE(rg.columns[3].pages[1].zone.has_value);
+
+  using Op = FunctionComparison::Operator;
+  // 时间范围谓词只命中第一页
+  ScanPredicate recent{1, ValueType::Type::Int, Op::Less};
+  recent.const_int = ts(300);
+  auto ranges = PageRangesMayMatch(rg, {recent});
+  ASSERT_EQ(ranges.size(), 1u);
+  EXPECT_EQ(ranges[0].begin, 0u);
+  EXPECT_EQ(ranges[0].end, PAGE_INDEX_ROWS);
+  // 全 NULL 的页不匹配
+  ScanPredicate active{3, ValueType::Type::String, Op::Equals};
+  active.const_string = "active";
+  ranges = PageRangesMayMatch(rg, {active});
+  ASSERT_EQ(ranges.size(), 2u);
+  EXPECT_EQ(ranges[0].end, PAGE_INDEX_ROWS);
+  EXPECT_EQ(ranges[1].begin, 2 * PAGE_INDEX_ROWS);
+
+  // 分区间求值与整个 RowGroup 求值后按区间过滤的结果一致
+  RowGroupData data(
+      rg, temp->data_file_->Data() + static_cast<size_t>(rg.offset));
+  ScanPredicate warm{2, ValueType::Type::Double, Op::GreaterOrEquals};
+  warm.const_double = 22.0;
+  ScanPredicate late{1, ValueType::Type::Int, Op::Greater};
+  late.const_int = ts(1500);
+  std::vector<RowRange> windows{{3, 700}, {1100, 1300}, {2000, rg.row_count}};
+  for (const auto &pred : {recent, active, warm, late}) {
+    std::vector<uint32_t> all;
+    ColumnReader::EvalPredicateOnRowGroup(data, pred, all);
+    std::vector<uint32_t> rows;
+    std::vector<uint32_t> expected;
+    for (const auto &window : windows) {
+      ColumnReader::EvalPredicateOnRowGroup(data, pred, rows, window);
+      for (auto row : all) {
+        if (row >= window.begin && row < window.end) {
+          expected.push_back(row);
+        }
+      }
+    }
+    EXPECT_EQ(rows, expected) << "column " << pred.column_idx;
+  }
+}
+
+TEST(SSTableBuilderTest, RowGroupSizingByRowsAndKeyBoundary) {
+  using namespace DB;
+  std::filesystem::path column{"sstable_test_file"};
+  std::unique_ptr<int, std::function<void(int *)>> defer(
+      new int(0), [&](int *t) {
+        delete t;
+        std::filesystem::remove_all(column);
+      });
+  std::vector<std::shared_ptr<ValueType>> types{std::make_shared<Int>(),
+                                                std::make_shared<Int>()};
+  auto dm = std::make_shared<DiskManager>();
+  auto bpm = std::make_shared<BufferPoolManager>(128, dm);
+
+  auto build = [&](uint32_t table_id, RowGroupSizing sizing, int first,
+                   int count) {
+    SSTableBuilder builder(column, table_id, types, 0, DEFAULT_KEY_FILTER_TYPE,
+                           {}, {}, ColumnCodec::None, sizing);
+    for (int i = first; i < first + count; i++) {
+      std::string row;
+      RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(i));
+      RowCodec::AppendValue(row, ValueType::Type::Int, std::to_string(i * 3));
+      EXPECT_TRUE(builder.Add(Slice{i}, Slice{row}));
+    }
+    EXPECT_TRUE(builder.Finish().ok());
+    auto sst = std::make_shared<SSTable>();
+    sst->sstable_id_ = table_id;
+    EXPECT_TRUE(TableOperator::ReadSSTable(column, sst, types, bpm).ok());
+    std::vector<uint32_t> rows;
+    for (const auto &rg : sst->rowgroups_) {
+      rows.push_back(rg.row_count);
+    }
+    return rows;
+  };
+
+  // 只按行数切分
+  RowGroupSizing by_rows;
+  by_rows.target_rows = 300;
+  EXPECT_EQ(build(0, by_rows, 0, 1000),
+            (std::vector<uint32_t>{300, 300, 300, 100}));
+
+  // 按 key 边界切分，负数 key 向下取整到同一个区间
+  RowGroupSizing by_key;
+  by_key.key_boundary = 250;
+  EXPECT_EQ(build(1, by_key, -100, 700),
+            (std::vector<uint32_t>{100, 250, 250, 100}));
+
+  // 行数预算先到时在区间内部继续切分
+  by_key.target_rows = 200;
+  EXPECT_EQ(build(2, by_key, 0, 500),
+            (std::vector<uint32_t>{200, 50, 200, 50}));
+
+  // 字节预算仍然生效
+  RowGroupSizing by_bytes;
+  by_bytes.target_bytes = 4096;
+  auto rows = build(3, by_bytes, 0, 2000);
+  EXPECT_GT(rows.size(), 1u);
+  for (size_t i = 0; i + 1 < rows.size(); i++) {
+    EXPECT_LE(rows[i] * 2 * sizeof(int), 4096u);
+  }
+}
@@ -0,0 +1,60 @@
+# Test COUNT / SUM / MIN / MAX answered from row group metadata after flush
+
+statement ok
+CREATE DATABASE test_agg_db
+
+statement ok
+USE test_agg_db
+
+statement ok
+CREATE TABLE events (id INT, day INT, amount DOUBLE, region STRING) UNIQUE KEY (id)
+
+statement ok
+INSERT INTO events VALUES (1, 1, 1.5, 'emea'), (2, 1, 2.5, 'emea'), (3, 2, Null, 'apac'), (4, 2, 4.0, 'apac'), (5, 3, 0.5, 'amer'), (6, 3, 8.0, 'amer')
+
+query
+SELECT COUNT(id), MIN(day), MAX(amount) FROM events
+----
+6 1 8.000000
+
+statement ok
+FLUSH events
+
+query
+SELECT COUNT(id) FROM events
+----
+6
+
+query
+SELECT COUNT(region), SUM(amount), MIN(amount), MAX(day) FROM events
+----
+6 16.500000 0.500000 3
+
+query
+SELECT COUNT(id), SUM(amount) FROM events WHERE day >= 1
+----
+6 16.500000
+
+query
+SELECT COUNT(id), MIN(amount), MAX(amount) FROM events WHERE day = 2
+----
+2 4.000000 4.000000
+
+query
+SELECT MIN(id), MAX(id) FROM events WHERE day > 3
+----
+Null Null
+
+statement ok
+INSERT INTO events VALUES (7, 4, 10.0, 'emea')
+
+query
+SELECT COUNT(id), MAX(amount) FROM events
+----
+7 10.000000
+
+statement ok
+DROP TABLE events
+
+statement ok
+DROP DATABASE test_agg_db
@@ -0,0 +1,46 @@
+# Test ANALYZE TABLE statistics over flushed row groups
+
+statement ok
+CREATE DATABASE test_analyze_db
+
+statement ok
+USE test_analyze_db
+
+statement ok
+CREATE TABLE events (id INT, tenant INT, amount DOUBLE, region STRING) UNIQUE KEY (id)
+
+statement ok
+INSERT INTO events VALUES (1, 7, 1.5, 'emea'), (2, 7, Null, 'emea'), (3, 8, 2.5, 'apac'), (4, 8, 2.5, 'apac'), (5, 9, Null, 'amer'), (6, 9, 4.0, 'emea')
+
+statement ok
+FLUSH events
+
+query
+ANALYZE TABLE events
+----
+id 6 0 6
+tenant 6 0 3
+amount 6 2 3
+region 6 0 3
+
+query
+SELECT id FROM events WHERE region = 'emea' AND tenant >= 8
+----
+6
+
+query
+SELECT COUNT(id) FROM events WHERE tenant = 8 AND amount > 1.0
+----
+2
+
+statement error
+ANALYZE events
+
+statement error
+ANALYZE TABLE missing
+
+statement ok
+DROP TABLE events
+
+statement ok
+DROP DATABASE test_analyze_db
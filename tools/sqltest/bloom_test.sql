@@ -0,0 +1,59 @@
+# Test BLOOM column filters on non-key columns
+
+statement ok
+CREATE DATABASE test_bloom_db
+
+statement ok
+USE test_bloom_db
+
+statement error
+CREATE TABLE bad (id INT BLOOM, email STRING) UNIQUE KEY (id)
+
+statement error
+CREATE TABLE bad (id INT, email STRING FAST) UNIQUE KEY (id)
+
+statement ok
+CREATE TABLE users (id INT, email STRING BLOOM, score DOUBLE bloom) UNIQUE KEY (id)
+
+statement ok
+INSERT INTO users VALUES (1, 'ann@mail', 1.5), (2, 'bob@mail', 2.5), (3, 'cid@mail', 0.0), (4, 'dan@mail', 4.5), (5, 'eve@mail', 5.5)
+
+statement ok
+FLUSH users
+
+query
+SELECT id FROM users WHERE email = 'dan@mail'
+----
+4
+
+query
+SELECT id FROM users WHERE email = 'zed@mail'
+----
+
+query
+SELECT email FROM users WHERE score = 2.5
+----
+bob@mail
+
+query
+SELECT id FROM users WHERE score = 0.0
+----
+3
+
+statement ok
+INSERT INTO users VALUES (6, 'dan@mail', 6.5)
+
+statement ok
+FLUSH users
+
+query
+SELECT id FROM users WHERE email = 'dan@mail'
+----
+4
+6
+
+statement ok
+DROP TABLE users
+
+statement ok
+DROP DATABASE test_bloom_db
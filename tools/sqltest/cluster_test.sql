@@ -0,0 +1,76 @@
+# Test CLUSTER columns (bottom-level compaction clusters row groups on them)
+
+statement ok
+CREATE DATABASE test_cluster_db
+
+statement ok
+USE test_cluster_db
+
+statement error
+CREATE TABLE bad (id INT CLUSTER, x INT) UNIQUE KEY (id)
+
+statement error
+CREATE TABLE bad (name STRING, x INT CLUSTER) UNIQUE KEY (name)
+
+statement error
+CREATE TABLE bad (id INT, a INT CLUSTER, b INT CLUSTER, c INT CLUSTER, d INT CLUSTER, e INT CLUSTER) UNIQUE KEY (id)
+
+statement error
+CREATE TABLE bad (id INT, x INT CLUSTER) UNIQUE KEY (id) WITH (CLUSTER_CURVE = SNAKE)
+
+statement ok
+CREATE TABLE points (id INT, x INT CLUSTER, y DOUBLE cluster, tag STRING) UNIQUE KEY (id) WITH (CLUSTER_CURVE = HILBERT, ROWGROUP_ROWS = 2)
+
+statement ok
+INSERT INTO points VALUES (1, 9, 1.5, 'a'), (2, 1, 8.5, 'b'), (3, 8, 0.5, 'c')
+
+statement ok
+FLUSH points
+
+statement ok
+INSERT INTO points VALUES (4, 2, 9.5, 'd'), (5, 9, 0.5, 'e'), (6, 1, 9.0, 'f')
+
+statement ok
+FLUSH points
+
+statement ok
+INSERT INTO points VALUES (7, 8, 1.0, 'g'), (8, 2, 8.0, 'h')
+
+statement ok
+FLUSH points
+
+statement ok
+INSERT INTO points VALUES (9, 1, 1.0, 'i'), (10, 9, 9.0, 'j')
+
+statement ok
+FLUSH points
+
+query
+SELECT id, tag FROM points WHERE x >= 8 AND y < 2
+----
+1 a
+3 c
+5 e
+7 g
+
+query
+SELECT tag FROM points WHERE id = 2
+----
+b
+
+query
+SELECT COUNT(id) FROM points
+----
+10
+
+statement ok
+ALTER TABLE points SET (CLUSTER_CURVE = ZORDER)
+
+statement error
+ALTER TABLE points SET (CLUSTER_CURVE = 1)
+
+statement ok
+DROP TABLE points
+
+statement ok
+DROP DATABASE test_cluster_db
@@ -0,0 +1,53 @@
+# Test dictionary-encoded string columns after flush
+
+statement ok
+CREATE DATABASE test_dict_db
+
+statement ok
+USE test_dict_db
+
+statement ok
+CREATE TABLE orders (id INT, status STRING, note STRING) UNIQUE KEY (id)
+
+statement ok
+INSERT INTO orders VALUES (1, 'paid', 'a'), (2, 'open', 'b'), (3, 'paid', 'c'), (4, 'void', 'd'), (5, 'open', 'e'), (6, 'paid', 'f')
+
+statement ok
+FLUSH orders
+
+query
+SELECT id FROM orders WHERE status = 'paid'
+----
+1
+3
+6
+
+query
+SELECT id FROM orders WHERE status > 'open'
+----
+1
+3
+4
+6
+
+query
+SELECT id FROM orders WHERE status != 'paid'
+----
+2
+4
+5
+
+query
+SELECT status FROM orders WHERE id = 4
+----
+void
+
+query
+SELECT id FROM orders WHERE status = 'shipped'
+----
+
+statement ok
+DROP TABLE orders
+
+statement ok
+DROP DATABASE test_dict_db
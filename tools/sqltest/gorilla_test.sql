@@ -0,0 +1,53 @@
+# Test GORILLA (XOR) encoding on DOUBLE columns
+
+statement ok
+CREATE DATABASE test_gorilla_db
+
+statement ok
+USE test_gorilla_db
+
+statement error
+CREATE TABLE bad (id INT GORILLA, v DOUBLE) UNIQUE KEY (id)
+
+statement error
+CREATE TABLE bad (id INT, name STRING GORILLA) UNIQUE KEY (id)
+
+statement ok
+CREATE TABLE metrics (ts INT, cpu DOUBLE GORILLA, mem DOUBLE gorilla BLOOM) UNIQUE KEY (ts)
+
+statement ok
+INSERT INTO metrics VALUES (1, 12.5, 512.0), (2, 12.5, 512.0), (3, 12.75, 512.0), (4, 12.75, 640.5), (5, 13.0, 640.5), (6, 12.75, 640.5)
+
+statement ok
+FLUSH metrics
+
+query
+SELECT SUM(cpu) FROM metrics
+----
+76.250000
+
+query
+SELECT ts FROM metrics WHERE cpu >= 12.75
+----
+3
+4
+5
+6
+
+query
+SELECT cpu FROM metrics WHERE ts = 5
+----
+13.000000
+
+query
+SELECT ts FROM metrics WHERE mem = 640.5
+----
+4
+5
+6
+
+statement ok
+DROP TABLE metrics
+
+statement ok
+DROP DATABASE test_gorilla_db
@@ -0,0 +1,54 @@
+# Test CREATE INDEX on a non-key column
+
+statement ok
+CREATE DATABASE test_index_db
+
+statement ok
+USE test_index_db
+
+statement ok
+CREATE TABLE orders (id INT, customer INT, item STRING) UNIQUE KEY (id)
+
+statement ok
+INSERT INTO orders VALUES (1, 10, 'a'), (2, 11, 'b'), (3, 12, 'c'), (4, 13, 'd'), (5, 14, 'e'), (6, 15, 'f'), (7, 16, 'g'), (8, 17, 'h'), (9, 18, 'i'), (10, 19, 'j'), (11, 20, 'k'), (12, 21, 'l'), (13, 10, 'm'), (14, 22, 'n'), (15, 23, 'o'), (16, 24, 'p'), (17, 25, 'q'), (18, 26, 'r'), (19, 27, 's'), (20, 28, 't'), (21, 29, 'u'), (22, 30, 'v')
+
+statement error
+CREATE INDEX ON orders(missing)
+
+statement error
+CREATE INDEX ON orders(id)
+
+statement ok
+CREATE INDEX ON orders(customer)
+
+statement error
+CREATE INDEX ON orders(customer)
+
+statement ok
+FLUSH orders
+
+query
+SELECT id, item FROM orders WHERE customer = 10
+----
+1 a
+13 m
+
+statement ok
+INSERT INTO orders VALUES (1, 99, 'a2'), (23, 10, 'w')
+
+query
+SELECT id, item FROM orders WHERE customer = 10
+----
+13 m
+23 w
+
+query
+SELECT id FROM orders WHERE customer = 10 AND id > 13
+----
+23
+
+statement ok
+DROP TABLE orders
+
+statement ok
+DROP DATABASE test_index_db
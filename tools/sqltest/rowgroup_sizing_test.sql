@@ -0,0 +1,66 @@
+# Test per-table row group sizing options (CREATE TABLE ... WITH / ALTER TABLE ... SET)
+
+statement ok
+CREATE DATABASE test_rowgroup_db
+
+statement ok
+USE test_rowgroup_db
+
+statement ok
+CREATE TABLE metrics (id INT, host STRING, value DOUBLE) UNIQUE KEY (id) WITH (ROWGROUP_ROWS = 2, ROWGROUP_KEY_BOUNDARY = 4)
+
+statement ok
+INSERT INTO metrics VALUES (1, 'a', 1.5), (2, 'b', 2.5), (3, 'a', 3.5), (5, 'c', 5.5), (6, 'b', 6.5), (9, 'a', 9.5)
+
+statement ok
+FLUSH metrics
+
+query
+SELECT id, host FROM metrics WHERE id >= 3 AND id < 9
+----
+3 a
+5 c
+6 b
+
+query
+SELECT COUNT(id) FROM metrics WHERE host = 'a'
+----
+3
+
+statement ok
+ALTER TABLE metrics SET (ROWGROUP_ROWS = 1024, ROWGROUP_BYTES = 65536)
+
+statement ok
+INSERT INTO metrics VALUES (10, 'c', 10.5), (11, 'a', 11.5)
+
+statement ok
+FLUSH metrics
+
+query
+SELECT SUM(value) FROM metrics WHERE id > 5
+----
+38.000000
+
+statement error
+CREATE TABLE bad_option (id INT) UNIQUE KEY (id) WITH (ROWGROUP_PAGES = 4)
+
+statement error
+CREATE TABLE bad_key (name STRING, v INT) UNIQUE KEY (name) WITH (ROWGROUP_KEY_BOUNDARY = 10)
+
+statement error
+ALTER TABLE metrics SET (ROWGROUP_ROWS = 0)
+
+statement error
+ALTER TABLE metrics SET (ROWGROUP_BYTES = 100)
+
+statement error
+ALTER TABLE missing SET (ROWGROUP_ROWS = 10)
+
+statement error
+ALTER TABLE metrics SET ROWGROUP_ROWS = 10
+
+statement ok
+DROP TABLE metrics
+
+statement ok
+DROP DATABASE test_rowgroup_db
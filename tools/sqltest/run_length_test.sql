@@ -0,0 +1,70 @@
+# Test run-length encoded columns after flush
+
+statement ok
+CREATE DATABASE test_rle_db
+
+statement ok
+USE test_rle_db
+
+statement ok
+CREATE TABLE events (id INT, tenant INT, amount DOUBLE, region STRING) UNIQUE KEY (id)
+
+statement ok
+INSERT INTO events VALUES (1, 7, 1.5, 'emea'), (2, 7, 1.5, 'emea'), (3, 7, 1.5, 'emea'), (4, 8, 1.5, 'emea'), (5, 8, 2.5, 'apac'), (6, 8, 2.5, 'apac'), (7, 9, 2.5, 'apac'), (8, 9, 2.5, 'apac')
+
+statement ok
+FLUSH events
+
+query
+SELECT SUM(tenant) FROM events
+----
+63.000000
+
+query
+SELECT SUM(amount) FROM events
+----
+16.000000
+
+query
+SELECT SIMD_SUM(amount) FROM events
+----
+16.000000
+
+query
+SELECT COUNT(id) FROM events WHERE tenant >= 8
+----
+5
+
+query
+SELECT id FROM events WHERE tenant = 8
+----
+4
+5
+6
+
+query
+SELECT id FROM events WHERE amount > 2.0
+----
+5
+6
+7
+8
+
+query
+SELECT id FROM events WHERE region != 'emea'
+----
+5
+6
+7
+8
+
+query
+SELECT tenant FROM events WHERE id = 7
+----
+9
+
+statement ok
+DROP TABLE events
+
+statement ok
+DROP DATABASE test_rle_db
@@ -13,26 +13,29 @@ if is_mode("asan") then
 end
 
 add_requires("linenoise", "simdjson", "rapidjson", "gtest", "fmt 12.1.0",
-             "spdlog v1.17.0", "xxhash", "benchmark")
+             "spdlog v1.17.0", "xxhash", "benchmark", "lz4", "zstd")
 
 
 target("libzeitkert")
     set_kind("static")
     add_files("src/**.cpp|main.cpp")
-    add_packages("linenoise", "simdjson", "rapidjson", "fmt", "spdlog", "xxhash")
+    add_packages("linenoise", "simdjson", "rapidjson", "fmt", "spdlog", "xxhash",
+                 "lz4", "zstd")
 
 target("libzeitkert_test")
     set_kind("static")
     add_defines("TESTS")
     add_rules("mode.debug")
     add_files("src/**.cpp|main.cpp")
-    add_packages("linenoise", "simdjson", "rapidjson", "fmt", "spdlog", "xxhash")
+    add_packages("linenoise", "simdjson", "rapidjson", "fmt", "spdlog", "xxhash",
+                 "lz4", "zstd")
 
 target("ZeitKert")
     set_kind("binary")
     add_files("src/main.cpp")
     add_deps("libzeitkert")
-    add_packages("linenoise", "simdjson", "rapidjson", "fmt", "spdlog", "xxhash")
+    add_packages("linenoise", "simdjson", "rapidjson", "fmt", "spdlog", "xxhash",
+                 "lz4", "zstd")
 
 target("tests")
     set_kind("binary")
@@ -43,7 +46,7 @@ target("tests")
     add_rules("mode.debug")
     add_cxxflags("-fsanitize=address", "-fno-omit-frame-pointer")
     add_packages("linenoise", "simdjson", "rapidjson", "gtest", "fmt", "spdlog",
-                 "xxhash")
+                 "xxhash", "lz4", "zstd")
 
 target("bpm-bench")
     set_kind("binary")
@@ -51,14 +54,16 @@ target("bpm-bench")
     add_files("benchmark/bpm-bench.cpp")
     add_deps("libzeitkert")
     add_rules("mode.debug")
-    add_packages("linenoise", "simdjson", "rapidjson", "fmt", "spdlog", "xxhash")
+    add_packages("linenoise", "simdjson", "rapidjson", "fmt", "spdlog", "xxhash",
+                 "lz4", "zstd")
 
 target("sqltest")
     set_kind("binary")
     add_files("tools/sqltest/SQLTest.cpp")
     add_deps("libzeitkert")
     add_rules("mode.debug")
-    add_packages("linenoise", "simdjson", "rapidjson", "fmt", "spdlog", "xxhash")
+    add_packages("linenoise", "simdjson", "rapidjson", "fmt", "spdlog", "xxhash",
+                 "lz4", "zstd")
 
 target("bench")
     set_kind("binary")
@@ -66,6 +71,6 @@ target("bench")
     add_deps("libzeitkert")
     add_rules("mode.release")
     add_packages("linenoise", "simdjson", "rapidjson", "fmt", "spdlog", "xxhash",
-                 "benchmark")
+                 "benchmark", "lz4", "zstd")
 
 set_default("ZeitKert")